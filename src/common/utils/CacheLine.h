@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+namespace yao {
+
+/**
+ * @brief 缓存行大小，用于隔离高频写入的原子变量，避免伪共享
+ */
+constexpr size_t kCacheLineSize = 64;
+
+} // namespace yao
@@ -6,7 +6,8 @@ namespace yao {
 
 RequestContext::RequestContext(std::shared_ptr<TenantContext> tenant, std::unique_ptr<ResourceStats> stats)
     : m_tenant(std::move(tenant))
-    , m_stats(std::move(stats)) {
+    , m_stats(std::move(stats))
+    , m_cancellation(CancellationToken::create()) {
 }
 
 const std::shared_ptr<TenantContext>& RequestContext::getTenant() const {
@@ -21,4 +22,12 @@ std::unique_ptr<ResourceStats>& RequestContext::getStats() {
     return m_stats;
 }
 
+const CancellationToken& RequestContext::getCancellationToken() const {
+    return m_cancellation;
+}
+
+void RequestContext::cancel() const {
+    m_cancellation.cancel();
+}
+
 } // namespace yao
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/resource/CancellationToken.h"
 #include <memory>
 #include <string>
 
@@ -40,9 +41,21 @@ public:
      */
     std::unique_ptr<ResourceStats>& getStats();
 
+    /**
+     * @brief 获取请求的取消令牌，由该请求派生的任务共享
+     * @return 取消令牌
+     */
+    const CancellationToken& getCancellationToken() const;
+
+    /**
+     * @brief 取消请求（如客户端断开），尚未执行的任务将被丢弃
+     */
+    void cancel() const;
+
 private:
     std::shared_ptr<TenantContext> m_tenant;  ///< 租户上下文
     std::unique_ptr<ResourceStats> m_stats;   ///< 资源统计
+    CancellationToken m_cancellation;         ///< 请求取消令牌
 };
 
 } // namespace yao
\ No newline at end of file
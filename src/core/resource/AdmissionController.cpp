@@ -0,0 +1,180 @@
+#include "core/resource/AdmissionController.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace yao {
+
+const char* submitStatusName(SubmitStatus status) {
+    switch (status) {
+        case SubmitStatus::Accepted:
+            return "accepted";
+        case SubmitStatus::QueueFull:
+            return "queue_full";
+        case SubmitStatus::BytesExceeded:
+            return "bytes_exceeded";
+        case SubmitStatus::NoTenant:
+            return "no_tenant";
+    }
+    return "unknown";
+}
+
+AdmissionController::AdmissionController() : AdmissionController(Limits()) {
+}
+
+AdmissionController::AdmissionController(const Limits& limits)
+    : limits_(limits), rateSampleTime_(std::chrono::steady_clock::now()) {
+}
+
+SubmitResult AdmissionController::submit(TaskQueue& queue, std::unique_ptr<Task> task) {
+    if (!task) {
+        return SubmitResult::noTenant();
+    }
+    SubmitResult result = tryAdmit(*task);
+    if (!result) {
+        return result;
+    }
+    size_t bytes = task->admittedBytes_;
+    if (!queue.enqueue(std::move(task))) {
+        uncharge(bytes);
+        return reject(SubmitStatus::QueueFull);
+    }
+    return result;
+}
+
+size_t AdmissionController::submitBulk(TaskQueue& queue, std::vector<std::unique_ptr<Task>>& tasks,
+                                       SubmitResult* rejection) {
+    SubmitResult result = SubmitResult::accepted();
+    size_t admitted = 0;
+    for (; admitted < tasks.size(); ++admitted) {
+        if (!tasks[admitted]) continue;
+        result = tryAdmit(*tasks[admitted]);
+        if (!result) break;
+    }
+
+    // 被拒绝的任务及其后的任务不入队，其余任务整批发布
+    std::vector<std::unique_ptr<Task>> rest(std::make_move_iterator(tasks.begin() + admitted),
+                                            std::make_move_iterator(tasks.end()));
+    tasks.resize(admitted);
+    if (rest.size() > 1) {
+        reject(result.status, rest.size() - 1);
+    }
+
+    size_t submitted = queue.enqueueBulk(tasks);
+    if (!tasks.empty()) {
+        // 有界队列已满，撤销剩余任务的计入
+        for (auto& task : tasks) {
+            if (task && task->admitted_) {
+                task->admitted_ = false;
+                uncharge(task->admittedBytes_);
+            }
+        }
+        result = reject(SubmitStatus::QueueFull, tasks.size());
+    }
+    tasks.insert(tasks.end(), std::make_move_iterator(rest.begin()), std::make_move_iterator(rest.end()));
+
+    if (rejection && !tasks.empty()) {
+        *rejection = result;
+    }
+    return submitted;
+}
+
+bool AdmissionController::submitCharged(TaskQueue& queue, std::unique_ptr<Task> task) {
+    if (!task) {
+        return false;
+    }
+    charge(*task);
+    size_t bytes = task->admittedBytes_;
+    if (!queue.enqueue(std::move(task))) {
+        uncharge(bytes);
+        return false;
+    }
+    return true;
+}
+
+SubmitResult AdmissionController::tryAdmit(Task& task) {
+    size_t bytes = task.getQueuedBytes();
+
+    size_t tasks = queuedTasks_.fetch_add(1) + 1;
+    if (limits_.maxQueuedTasks > 0 && tasks > limits_.maxQueuedTasks) {
+        queuedTasks_.fetch_sub(1);
+        return reject(SubmitStatus::QueueFull);
+    }
+
+    size_t total = queuedBytes_.fetch_add(bytes) + bytes;
+    if (limits_.maxQueuedBytes > 0 && total > limits_.maxQueuedBytes) {
+        queuedBytes_.fetch_sub(bytes);
+        queuedTasks_.fetch_sub(1);
+        rejectedTasks_.fetch_add(1);
+        return SubmitResult{SubmitStatus::BytesExceeded,
+                            estimateRetryAfter(excessTasks(SubmitStatus::BytesExceeded, bytes))};
+    }
+
+    task.admittedBytes_ = bytes;
+    task.admitted_ = true;
+    return SubmitResult::accepted();
+}
+
+void AdmissionController::charge(Task& task) {
+    size_t bytes = task.getQueuedBytes();
+    queuedTasks_.fetch_add(1);
+    queuedBytes_.fetch_add(bytes);
+    task.admittedBytes_ = bytes;
+    task.admitted_ = true;
+}
+
+void AdmissionController::uncharge(size_t bytes) {
+    queuedBytes_.fetch_sub(bytes);
+    queuedTasks_.fetch_sub(1);
+}
+
+void AdmissionController::release(Task& task) {
+    if (!task.admitted_) return;
+    task.admitted_ = false;
+    queuedBytes_.fetch_sub(task.admittedBytes_);
+    queuedTasks_.fetch_sub(1);
+    drainedTasks_.fetch_add(1);
+}
+
+SubmitResult AdmissionController::reject(SubmitStatus status, size_t count) {
+    rejectedTasks_.fetch_add(count);
+    return SubmitResult{status, estimateRetryAfter(excessTasks(status, 0))};
+}
+
+size_t AdmissionController::excessTasks(SubmitStatus status, size_t bytes) const {
+    size_t tasks = queuedTasks_.load();
+    if (status == SubmitStatus::BytesExceeded && tasks > 0 && limits_.maxQueuedBytes > 0) {
+        // 按平均任务大小换算需要排空的任务数
+        size_t queuedBytes = queuedBytes_.load();
+        size_t excessBytes = queuedBytes + bytes > limits_.maxQueuedBytes
+                                 ? queuedBytes + bytes - limits_.maxQueuedBytes : 1;
+        size_t average = std::max<size_t>(queuedBytes / tasks, 1);
+        return std::max<size_t>((excessBytes + average - 1) / average, 1);
+    }
+    if (limits_.maxQueuedTasks > 0 && tasks >= limits_.maxQueuedTasks) {
+        return tasks - limits_.maxQueuedTasks + 1;
+    }
+    return 1;
+}
+
+std::chrono::milliseconds AdmissionController::estimateRetryAfter(size_t excessTasks) {
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(rateMutex_);
+
+    auto elapsed = now - rateSampleTime_;
+    if (elapsed >= kRateWindow) {
+        uint64_t drained = drainedTasks_.load();
+        double rate = (drained - rateSampleDrained_) / std::chrono::duration<double>(elapsed).count();
+        drainRate_ = drainRate_ > 0 ? 0.5 * drainRate_ + 0.5 * rate : rate;
+        rateSampleTime_ = now;
+        rateSampleDrained_ = drained;
+    }
+
+    if (drainRate_ <= 0) {
+        return kMaxRetryAfter;
+    }
+    auto wait = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(excessTasks * 1000.0 / drainRate_)));
+    return std::min(std::max(wait, kMinRetryAfter), kMaxRetryAfter);
+}
+
+} // namespace yao
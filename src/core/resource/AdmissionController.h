@@ -0,0 +1,157 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 任务提交结果状态
+ */
+enum class SubmitStatus {
+    Accepted,        ///< 已入队
+    QueueFull,       ///< 租户排队任务数达到上限（或有界队列已满）
+    BytesExceeded,   ///< 租户排队字节数达到上限
+    NoTenant         ///< 租户不存在或任务为空
+};
+
+/**
+ * @brief 任务提交结果
+ * 被拒绝时携带建议的重试等待时间，由调用方转成客户端可见的繁忙错误
+ */
+struct SubmitResult {
+    SubmitStatus status = SubmitStatus::NoTenant;
+    std::chrono::milliseconds retryAfter{0};   ///< 建议重试前等待的时间，仅限流拒绝时有效
+
+    static SubmitResult accepted() { return SubmitResult{SubmitStatus::Accepted, std::chrono::milliseconds(0)}; }
+    static SubmitResult noTenant() { return SubmitResult{SubmitStatus::NoTenant, std::chrono::milliseconds(0)}; }
+
+    /**
+     * @brief 是否已入队
+     */
+    bool isAccepted() const { return status == SubmitStatus::Accepted; }
+
+    /**
+     * @brief 是否因租户积压被限流（客户端应稍后重试）
+     */
+    bool isBusy() const { return status == SubmitStatus::QueueFull || status == SubmitStatus::BytesExceeded; }
+
+    explicit operator bool() const { return isAccepted(); }
+};
+
+/**
+ * @brief 获取提交状态名称
+ */
+const char* submitStatusName(SubmitStatus status);
+
+/**
+ * @brief 租户队列准入控制
+ * 按排队任务数与排队字节数限制租户积压，超限时立即拒绝而不是无限排队。
+ * 任务经submit()/submitBulk()计入限额后入队，出队执行（或被丢弃）时release()扣除；
+ * 只有计入限额的任务才会被扣除，工作线程回流到共享队列的任务不受影响。
+ * 计数先增加再检查，超限时回退，因此并发提交在边界附近可能多拒绝少量任务，
+ * 但不会超过上限。
+ */
+class AdmissionController {
+public:
+    /**
+     * @brief 准入限额，0表示不限制
+     */
+    struct Limits {
+        size_t maxQueuedTasks = 0;
+        size_t maxQueuedBytes = 0;
+    };
+
+    AdmissionController();
+    explicit AdmissionController(const Limits& limits);
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    /**
+     * @brief 计入限额后入队
+     * @param queue 租户队列
+     * @param task 任务，被拒绝时丢弃
+     * @return 超限或有界队列已满时返回原因与建议重试时间，并计入拒绝数
+     */
+    SubmitResult submit(TaskQueue& queue, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 批量计入限额后入队，遇到第一个被拒绝的任务即停止以保持顺序
+     * @param queue 租户队列
+     * @param tasks 任务列表，未入队的任务保留在其中
+     * @param rejection 输出，有任务未入队时为拒绝原因，可为空
+     * @return 入队的任务数量
+     */
+    size_t submitBulk(TaskQueue& queue, std::vector<std::unique_ptr<Task>>& tasks, SubmitResult* rejection = nullptr);
+
+    /**
+     * @brief 不检查限额直接计入并入队（已准入请求派生的后续任务）
+     * @return 有界队列已满时返回false
+     */
+    bool submitCharged(TaskQueue& queue, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 任务离开队列时扣除限额，未计入限额的任务忽略
+     */
+    void release(Task& task);
+
+    size_t getQueuedTasks() const { return queuedTasks_.load(); }
+    size_t getQueuedBytes() const { return queuedBytes_.load(); }
+    size_t getRejectedTasks() const { return rejectedTasks_.load(); }
+    const Limits& getLimits() const { return limits_; }
+
+private:
+    /**
+     * @brief 尝试为任务计入限额，失败时已回退并计入拒绝数
+     */
+    SubmitResult tryAdmit(Task& task);
+
+    /**
+     * @brief 无条件计入限额
+     */
+    void charge(Task& task);
+
+    /**
+     * @brief 撤销尚未入队任务的计入
+     */
+    void uncharge(size_t bytes);
+
+    /**
+     * @brief 记录count个被拒绝的任务，返回带重试时间的结果
+     */
+    SubmitResult reject(SubmitStatus status, size_t count = 1);
+
+    static constexpr std::chrono::milliseconds kMinRetryAfter{10};
+    static constexpr std::chrono::milliseconds kMaxRetryAfter{5000};
+    static constexpr std::chrono::milliseconds kRateWindow{100};
+
+    /**
+     * @brief 按近期出队速率估算排空excessTasks个任务所需时间
+     */
+    std::chrono::milliseconds estimateRetryAfter(size_t excessTasks);
+
+    /**
+     * @brief 按当前排队状态计算需要排空多少任务才能再次准入
+     */
+    size_t excessTasks(SubmitStatus status, size_t bytes) const;
+
+    Limits limits_;
+    std::atomic<size_t> queuedTasks_{0};
+    std::atomic<size_t> queuedBytes_{0};
+    std::atomic<size_t> rejectedTasks_{0};
+    std::atomic<uint64_t> drainedTasks_{0};
+
+    // 出队速率只在拒绝时采样，拒绝属于慢路径
+    std::mutex rateMutex_;
+    std::chrono::steady_clock::time_point rateSampleTime_;
+    uint64_t rateSampleDrained_ = 0;
+    double drainRate_ = 0;   ///< 每秒出队任务数（指数平滑）
+};
+
+} // namespace yao
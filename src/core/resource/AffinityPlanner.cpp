@@ -0,0 +1,92 @@
+#include "core/resource/AffinityPlanner.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace yao {
+
+AffinityPlanner::AffinityPlanner(CpuTopology topology)
+    : topology_(std::move(topology)) {
+    // 拓扑中的CPU已按 (节点, 缓存域) 排序，同组CPU下标连续
+    const auto& cpus = topology_.getCpus();
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        if (i == 0 || cpus[i].node != cpus[i - 1].node) {
+            nodes_.emplace_back();
+        }
+        nodes_.back().push_back(i);
+        if (i == 0 || cpus[i].node != cpus[i - 1].node || cpus[i].cacheDomain != cpus[i - 1].cacheDomain) {
+            cacheDomains_.emplace_back();
+        }
+        cacheDomains_.back().push_back(i);
+    }
+}
+
+std::vector<size_t> AffinityPlanner::pickFromGroups(const std::vector<std::vector<size_t>>& groups, size_t width,
+                                                    const std::vector<double>& load) const {
+    std::vector<size_t> best;
+    double bestLoad = 0;
+    for (const auto& group : groups) {
+        if (group.size() < width) continue;
+
+        // 负载相同时按下标取，保持CPU连续
+        std::vector<size_t> candidate = group;
+        std::stable_sort(candidate.begin(), candidate.end(),
+                         [&load](size_t a, size_t b) { return load[a] < load[b]; });
+        candidate.resize(width);
+        double total = 0;
+        for (size_t index : candidate) {
+            total += load[index];
+        }
+        if (best.empty() || total < bestLoad) {
+            best = std::move(candidate);
+            bestLoad = total;
+        }
+    }
+    return best;
+}
+
+AffinityPlanner::Placement AffinityPlanner::plan(const std::map<std::string, size_t>& demands) const {
+    Placement placement;
+    const auto& cpus = topology_.getCpus();
+    if (cpus.empty() || demands.empty()) {
+        return placement;
+    }
+
+    size_t totalDemand = 0;
+    for (const auto& [tenantId, threads] : demands) {
+        totalDemand += std::max<size_t>(threads, 1);
+    }
+    // 每个CPU平均承载的线程数，线程多于CPU时租户按比例缩小占用范围
+    size_t threadsPerCpu = std::max<size_t>((totalDemand + cpus.size() - 1) / cpus.size(), 1);
+
+    std::vector<std::pair<std::string, size_t>> order(demands.begin(), demands.end());
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::vector<double> load(cpus.size(), 0.0);
+    std::vector<std::vector<size_t>> machine(1, std::vector<size_t>(cpus.size()));
+    std::iota(machine[0].begin(), machine[0].end(), 0);
+
+    for (const auto& [tenantId, demand] : order) {
+        size_t threads = std::max<size_t>(demand, 1);
+        size_t width = std::min(cpus.size(), (threads + threadsPerCpu - 1) / threadsPerCpu);
+
+        std::vector<size_t> chosen = pickFromGroups(cacheDomains_, width, load);
+        if (chosen.empty()) {
+            chosen = pickFromGroups(nodes_, width, load);
+        }
+        if (chosen.empty()) {
+            chosen = pickFromGroups(machine, width, load);
+        }
+
+        std::vector<int>& cpuIds = placement[tenantId];
+        for (size_t index : chosen) {
+            load[index] += static_cast<double>(threads) / width;
+            cpuIds.push_back(cpus[index].id);
+        }
+        std::sort(cpuIds.begin(), cpuIds.end());
+    }
+    return placement;
+}
+
+} // namespace yao
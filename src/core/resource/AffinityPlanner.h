@@ -0,0 +1,45 @@
+#pragma once
+
+#include "core/resource/CpuTopology.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 租户线程组的CPU亲和性规划
+ * 按线程数从大到小为每个租户选出一组紧凑的CPU：优先放进单个末级缓存域，
+ * 放不下时放进单个NUMA节点，再放不下才跨节点；同一层级内选择负载最轻的位置。
+ * 线程总数超过CPU数时按比例缩小每个租户占用的CPU数，允许租户之间共用CPU。
+ * 规划结果只取决于拓扑和租户需求，每次租户变化后整体重算。
+ */
+class AffinityPlanner {
+public:
+    /// 租户ID -> 绑定的CPU编号（升序）
+    using Placement = std::map<std::string, std::vector<int>>;
+
+    explicit AffinityPlanner(CpuTopology topology);
+
+    /**
+     * @brief 计算放置方案
+     * @param demands 租户ID -> 线程数
+     * @return 每个租户的CPU集合
+     */
+    Placement plan(const std::map<std::string, size_t>& demands) const;
+
+    const CpuTopology& getTopology() const { return topology_; }
+
+private:
+    /**
+     * @brief 在候选分组中选出负载最轻、能容纳width个CPU的分组，返回其中最空闲的width个CPU下标
+     */
+    std::vector<size_t> pickFromGroups(const std::vector<std::vector<size_t>>& groups, size_t width,
+                                       const std::vector<double>& load) const;
+
+    CpuTopology topology_;
+    std::vector<std::vector<size_t>> cacheDomains_;  ///< 每个缓存域内的CPU下标
+    std::vector<std::vector<size_t>> nodes_;         ///< 每个NUMA节点内的CPU下标
+};
+
+} // namespace yao
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace yao {
+
+/**
+ * @brief 任务取消令牌
+ * 复制出的令牌共享同一个取消标志：请求方（如客户端连接）保留一份，
+ * 任务持有另一份。请求方放弃时调用cancel()，尚在队列中的任务在出队时被丢弃，
+ * 正在执行的长任务可定期检查isCancelled()主动结束。
+ * 默认构造的令牌不关联任何标志，永远不会被取消。
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    /**
+     * @brief 创建一个可取消的令牌
+     */
+    static CancellationToken create() {
+        CancellationToken token;
+        token.state_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    /**
+     * @brief 请求取消，所有共享该标志的令牌都可见
+     */
+    void cancel() const {
+        if (state_) {
+            state_->store(true, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief 是否已被取消
+     */
+    bool isCancelled() const {
+        return state_ && state_->load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 是否关联了取消标志（默认构造的令牌为false）
+     */
+    bool isCancellable() const {
+        return state_ != nullptr;
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+} // namespace yao
@@ -1,27 +1,228 @@
 #include "core/resource/CgroupController.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <filesystem>
 #include <system_error>
 #include <algorithm>
+#include <cerrno>
+#include <string_view>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace yao {
 
-CgroupController::CgroupController(const std::string& basePath)
-    : basePath_(basePath) {
+namespace {
+
+/// 统计文件的读缓冲，cpu.stat在v2下约十行
+constexpr size_t kStatBufferSize = 1024;
+
+/**
+ * @brief 解析十进制无符号数，返回解析结束的位置
+ */
+const char* parseUnsigned(const char* p, const char* end, uint64_t& value) {
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief 逐行解析"key value"格式的统计内容，对每一项调用visit(key, value)
+ */
+template <typename Visit>
+void parseStatLines(const char* p, const char* end, Visit visit) {
+    while (p < end) {
+        const char* key = p;
+        while (p < end && *p != ' ' && *p != '\n') ++p;
+        if (p < end && *p == ' ') {
+            uint64_t value = 0;
+            std::string_view name(key, static_cast<size_t>(p - key));
+            p = parseUnsigned(p + 1, end, value);
+            visit(name, value);
+        }
+        while (p < end && *p != '\n') ++p;
+        if (p < end) ++p;
+    }
+}
+
+/**
+ * @brief 逐行拆分为以空格分隔的字段，跳过空行
+ */
+template <typename Visit>
+void forEachFields(const char* p, const char* end, Visit visit) {
+    std::vector<std::string_view> fields;
+    while (p < end) {
+        fields.clear();
+        while (p < end && *p != '\n') {
+            const char* field = p;
+            while (p < end && *p != ' ' && *p != '\n') ++p;
+            if (p > field) {
+                fields.emplace_back(field, static_cast<size_t>(p - field));
+            }
+            if (p < end && *p == ' ') ++p;
+        }
+        if (p < end) ++p;
+        if (!fields.empty()) {
+            visit(fields);
+        }
+    }
+}
+
+/**
+ * @brief 取出设备号对应的统计项，不存在时按序插入
+ */
+CgroupIoStat& ioStatOf(std::vector<CgroupIoStat>& stats, std::string_view device) {
+    auto it = std::lower_bound(stats.begin(), stats.end(), device,
+                               [](const CgroupIoStat& stat, std::string_view key) { return stat.device < key; });
+    if (it == stats.end() || it->device != device) {
+        it = stats.insert(it, CgroupIoStat());
+        it->device = std::string(device);
+    }
+    return *it;
+}
+
+/**
+ * @brief 按需打开并缓存只读描述符
+ * @return 描述符，打开失败为-1（下次读取时重试）
+ */
+int acquireFd(int& cached, const std::string& path) {
+    if (cached < 0) {
+        cached = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    return cached;
+}
+
+/**
+ * @brief 读取一个小文件的全部内容到buffer
+ * @return 读取的字节数，失败为-1
+ */
+ssize_t readSmallFile(const std::string& path, char* buffer, size_t size);
+
+/**
+ * @brief 删除cgroup目录：cgroup目录只能rmdir；普通目录（测试用的模拟层级）才逐个删除文件
+ */
+void removeCgroupDirectory(const std::string& path) {
+    std::error_code ec;
+    if (fs::exists(path, ec) && !fs::remove(path, ec)) {
+        fs::remove_all(path);
+    }
+}
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief 从偏移0整体读取文件（cgroup文件每次从头读取即得到最新内容）
+ * @return 读取的字节数，失败为-1
+ */
+ssize_t readFromStart(int fd, char* buffer, size_t size) {
+    ssize_t n;
+    do {
+        n = ::pread(fd, buffer, size, 0);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+ssize_t readSmallFile(const std::string& path, char* buffer, size_t size) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = readFromStart(fd, buffer, size);
+    ::close(fd);
+    return n;
+}
+
+} // namespace
+
+CgroupVersion detectCgroupVersion(const std::string& root) {
+    std::error_code ec;
+    std::ifstream controllers(root + "/cgroup.controllers");
+    if (controllers.is_open()) {
+        std::string name;
+        while (controllers >> name) {
+            if (name == "cpu") {
+                return CgroupVersion::V2;
+            }
+        }
+    }
+    // 混合模式下统一层级不含cpu控制器，仍使用v1的cpu子系统
+    if (fs::is_directory(root + "/cpu", ec)) {
+        return CgroupVersion::V1;
+    }
+    return CgroupVersion::None;
+}
+
+pid_t currentThreadTid() {
+#ifdef __linux__
+    return static_cast<pid_t>(::syscall(SYS_gettid));
+#else
+    return ::getpid();
+#endif
+}
+
+CgroupController::CgroupController()
+    : version_(detectCgroupVersion()) {
+    basePath_ = defaultBasePath(version_);
+}
+
+CgroupController::CgroupController(const std::string& basePath, CgroupVersion version)
+    : basePath_(basePath), version_(version) {
 }
 
 CgroupController::~CgroupController() {
     // 清理所有租户cgroup
+    std::vector<std::string> tenantIds;
     for (const auto& [tenantId, _] : tenantThreads_) {
+        tenantIds.push_back(tenantId);
+    }
+    for (const auto& tenantId : tenantIds) {
         removeTenantCgroup(tenantId);
     }
+    for (auto& [_, files] : statFiles_) {
+        closeFd(files.cpuStatFd);
+        closeFd(files.cpuUsageFd);
+    }
+}
+
+std::string CgroupController::defaultBasePath(CgroupVersion version) {
+    switch (version) {
+        case CgroupVersion::V2:
+            return "/sys/fs/cgroup/yaobase";
+        case CgroupVersion::V1:
+            return "/sys/fs/cgroup/cpu/yaobase";
+        case CgroupVersion::None:
+        default:
+            return "";
+    }
+}
+
+uint64_t CgroupController::sharesToWeight(int shares) {
+    // 按比例换算，保持租户之间的相对份额：默认1024对应默认100，结果限制在[1, 10000]
+    uint64_t weight = static_cast<uint64_t>(std::max(shares, 0)) * 100 / 1024;
+    return std::min<uint64_t>(std::max<uint64_t>(weight, 1), 10000);
 }
 
 bool CgroupController::initialize() {
+    if (version_ == CgroupVersion::None || basePath_.empty()) {
+        std::cerr << "Failed to initialize cgroup: no cpu controller mounted" << std::endl;
+        return false;
+    }
+
     try {
         // 创建基础目录
         if (!fs::exists(basePath_)) {
@@ -30,27 +231,54 @@ bool CgroupController::initialize() {
 
         // 设置目录权限
         fs::permissions(basePath_, fs::perms::owner_all | fs::perms::group_read | fs::perms::group_exec);
-
-        return true;
     } catch (const fs::filesystem_error& e) {
         std::cerr << "Failed to initialize cgroup: " << e.what() << std::endl;
         return false;
     }
+
+    if (version_ == CgroupVersion::V2) {
+        // 父目录通常已启用cpu控制器，失败时由下一步写入暴露问题
+        std::string parent = fs::path(basePath_).parent_path().string();
+        writeCgroupFile(parent + "/cgroup.subtree_control", "+cpu");
+
+        // 先启用控制器再移入进程：仅启用线程化控制器的cgroup可以作为线程化子树的根
+        if (!writeCgroupFile(basePath_ + "/cgroup.subtree_control", "+cpu")) {
+            std::cerr << "Failed to enable cpu controller under " << basePath_ << std::endl;
+            return false;
+        }
+        if (!writeCgroupFile(basePath_ + "/cgroup.procs", std::to_string(::getpid()))) {
+            std::cerr << "Failed to move process into " << basePath_ << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Cgroup " << (version_ == CgroupVersion::V2 ? "v2" : "v1")
+              << " controller initialized at " << basePath_ << std::endl;
+    return true;
 }
 
 bool CgroupController::createTenantCgroup(const std::string& tenantId, int cpuShares) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    std::string tenantPath = basePath_ + "/" + tenantId;
+    std::string path = tenantPath(tenantId);
 
     try {
         // 创建租户目录
-        if (!fs::exists(tenantPath)) {
-            fs::create_directory(tenantPath);
+        if (!fs::exists(path)) {
+            fs::create_directory(path);
         }
 
-        // 设置CPU份额
-        if (!writeCgroupFile(tenantPath + "/cpu.shares", std::to_string(cpuShares))) {
+        if (version_ == CgroupVersion::V2) {
+            // 线程化cgroup才能通过cgroup.threads接收单个线程
+            if (!writeCgroupFile(path + "/cgroup.type", "threaded")) {
+                std::cerr << "Failed to make tenant cgroup " << tenantId << " threaded" << std::endl;
+                return false;
+            }
+            if (!writeCgroupFile(path + "/cpu.weight", std::to_string(sharesToWeight(cpuShares)))) {
+                return false;
+            }
+        } else if (!writeCgroupFile(path + "/cpu.shares", std::to_string(cpuShares))) {
+            // 设置CPU份额
             return false;
         }
 
@@ -67,12 +295,18 @@ bool CgroupController::createTenantCgroup(const std::string& tenantId, int cpuSh
 bool CgroupController::removeTenantCgroup(const std::string& tenantId) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    std::string tenantPath = basePath_ + "/" + tenantId;
+    std::string path = tenantPath(tenantId);
+    // 持有打开的统计文件时cgroup目录仍可删除，先关闭以便同名租户重建后重新打开
+    closeStatFiles(tenantId);
 
     try {
-        // 移除目录
-        if (fs::exists(tenantPath)) {
-            fs::remove_all(tenantPath);
+        removeCgroupDirectory(path);
+        auto processIt = processCgroups_.find(tenantId);
+        if (processIt != processCgroups_.end()) {
+            for (const auto& controller : processIt->second) {
+                removeCgroupDirectory(processCgroupPath(controller, tenantId));
+            }
+            processCgroups_.erase(processIt);
         }
 
         // 清理线程列表
@@ -86,37 +320,285 @@ bool CgroupController::removeTenantCgroup(const std::string& tenantId) {
 }
 
 bool CgroupController::setCpuShares(const std::string& tenantId, int shares) {
-    std::string tenantPath = basePath_ + "/" + tenantId;
-    return writeCgroupFile(tenantPath + "/cpu.shares", std::to_string(shares));
+    if (version_ == CgroupVersion::V2) {
+        return writeCgroupFile(tenantPath(tenantId) + "/cpu.weight", std::to_string(sharesToWeight(shares)));
+    }
+    return writeCgroupFile(tenantPath(tenantId) + "/cpu.shares", std::to_string(shares));
 }
 
-bool CgroupController::addThread(const std::string& tenantId, std::thread::id threadId) {
+bool CgroupController::setCpuMax(const std::string& tenantId, int64_t quotaUs, uint64_t periodUs, uint64_t burstUs) {
+    std::string path = tenantPath(tenantId);
+    // 内核要求突发不超过配额：先清零突发再改上限，最后设置新的突发；不限制时突发无意义
+    uint64_t burst = quotaUs < 0 ? 0 : std::min(burstUs, static_cast<uint64_t>(quotaUs));
+    const char* burstFile = version_ == CgroupVersion::V2 ? "/cpu.max.burst" : "/cpu.cfs_burst_us";
+    std::error_code ec;
+    if (fs::exists(path + burstFile, ec)) {
+        writeCgroupFile(path + burstFile, "0");
+    }
+
+    bool limited;
+    if (version_ == CgroupVersion::V2) {
+        std::string quota = quotaUs < 0 ? "max" : std::to_string(quotaUs);
+        limited = writeCgroupFile(path + "/cpu.max", quota + " " + std::to_string(periodUs));
+    } else {
+        limited = writeCgroupFile(path + "/cpu.cfs_period_us", std::to_string(periodUs)) &&
+                  writeCgroupFile(path + "/cpu.cfs_quota_us", std::to_string(quotaUs < 0 ? -1 : quotaUs));
+    }
+    if (!limited || burst == 0) {
+        return limited;
+    }
+    if (!writeCgroupFile(path + burstFile, std::to_string(burst))) {
+        std::cerr << "CPU burst not supported for tenant " << tenantId << ", cap applied without burst" << std::endl;
+    }
+    return true;
+}
+
+bool CgroupController::hasTenantCgroup(const std::string& tenantId) const {
     std::lock_guard<std::mutex> lock(mutex_);
+    return tenantThreads_.find(tenantId) != tenantThreads_.end();
+}
 
-    auto it = tenantThreads_.find(tenantId);
-    if (it == tenantThreads_.end()) {
+std::string CgroupController::blockDeviceOf(const std::string& path) {
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return "";
+    }
+    std::string device = std::to_string(major(info.st_dev)) + ":" + std::to_string(minor(info.st_dev));
+    // 分区目录下有partition文件，其父目录是整盘
+    fs::path sysfs = fs::path("/sys/dev/block") / device;
+    std::error_code ec;
+    if (fs::exists(sysfs / "partition", ec)) {
+        std::ifstream disk(fs::canonical(sysfs, ec).parent_path() / "dev");
+        std::string whole;
+        if (disk >> whole) {
+            return whole;
+        }
+    }
+    return device;
+}
+
+std::string CgroupController::processBasePath(const std::string& controller) const {
+    fs::path base(basePath_);
+    if (version_ == CgroupVersion::V2) {
+        return basePath_ + "-procs";
+    }
+    // v1：/sys/fs/cgroup/cpu/yaobase -> /sys/fs/cgroup/<controller>/yaobase，子系统必须已挂载
+    fs::path hierarchy = base.parent_path().parent_path() / controller;
+    std::error_code ec;
+    if (!fs::is_directory(hierarchy, ec)) {
+        return "";
+    }
+    return (hierarchy / base.filename()).string();
+}
+
+std::string CgroupController::processCgroupPath(const std::string& controller, const std::string& tenantId) const {
+    std::string base = processBasePath(controller);
+    return base.empty() ? "" : base + "/" + tenantId;
+}
+
+bool CgroupController::ensureProcessCgroup(const std::string& controller, const std::string& tenantId) {
+    auto& controllers = processCgroups_[tenantId];
+    if (std::find(controllers.begin(), controllers.end(), controller) != controllers.end()) {
+        return true;
+    }
+
+    std::string base = processBasePath(controller);
+    if (base.empty()) {
+        std::cerr << "Cgroup " << controller << " hierarchy is not mounted" << std::endl;
+        return false;
+    }
+    try {
+        fs::create_directories(base);
+        if (version_ == CgroupVersion::V2 &&
+            std::find(enabledProcessControllers_.begin(), enabledProcessControllers_.end(), controller) ==
+                enabledProcessControllers_.end()) {
+            // 父目录通常已启用该控制器，失败时由下一步写入暴露问题
+            writeCgroupFile(fs::path(base).parent_path().string() + "/cgroup.subtree_control", "+" + controller);
+            if (!writeCgroupFile(base + "/cgroup.subtree_control", "+" + controller)) {
+                std::cerr << "Failed to enable " << controller << " controller under " << base << std::endl;
+                return false;
+            }
+            enabledProcessControllers_.push_back(controller);
+        }
+        fs::create_directories(base + "/" + tenantId);
+    } catch (const fs::filesystem_error& e) {
+        std::cerr << "Failed to create " << controller << " cgroup for tenant " << tenantId << ": " << e.what()
+                  << std::endl;
         return false;
     }
+    controllers.push_back(controller);
 
-    // 检查是否已存在
-    auto& threads = it->second;
-    if (std::find(threads.begin(), threads.end(), threadId) != threads.end()) {
-        return true; // 已存在
+    // v1的blkio可以按线程划分：已加入租户CPU cgroup的工作线程一并加入
+    if (version_ == CgroupVersion::V1 && controller == "blkio") {
+        auto threads = tenantThreads_.find(tenantId);
+        if (threads != tenantThreads_.end() && !threads->second.empty()) {
+            attachIoThreadsLocked(tenantId, threads->second);
+        }
+    }
+    return true;
+}
+
+bool CgroupController::attachIoThreadsLocked(const std::string& tenantId, const std::vector<pid_t>& tids) {
+    if (version_ != CgroupVersion::V1) {
+        return true;
+    }
+    auto it = processCgroups_.find(tenantId);
+    if (it == processCgroups_.end() || std::find(it->second.begin(), it->second.end(), "blkio") == it->second.end()) {
+        return true;
+    }
+
+    std::string path = processCgroupPath("blkio", tenantId) + "/tasks";
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bool allAttached = true;
+    for (pid_t tid : tids) {
+        std::string line = std::to_string(tid) + "\n";
+        if (::write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+            std::cerr << "Failed to attach thread " << tid << " to blkio cgroup of tenant " << tenantId
+                      << ": " << std::strerror(errno) << std::endl;
+            allAttached = false;
+        }
+    }
+    ::close(fd);
+    return allAttached;
+}
+
+bool CgroupController::setMemoryLimit(const std::string& tenantId, uint64_t highBytes, uint64_t maxBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ensureProcessCgroup("memory", tenantId)) {
+        return false;
+    }
+
+    std::string path = processCgroupPath("memory", tenantId);
+    if (version_ == CgroupVersion::V2) {
+        auto format = [](uint64_t bytes) { return bytes == 0 ? std::string("max") : std::to_string(bytes); };
+        // 先放宽硬上限再设置软上限，避免中间状态high大于max
+        return writeCgroupFile(path + "/memory.max", format(maxBytes)) &&
+               writeCgroupFile(path + "/memory.high", format(highBytes));
+    }
+    auto format = [](uint64_t bytes) { return bytes == 0 ? std::string("-1") : std::to_string(bytes); };
+    return writeCgroupFile(path + "/memory.limit_in_bytes", format(maxBytes)) &&
+           writeCgroupFile(path + "/memory.soft_limit_in_bytes", format(highBytes));
+}
+
+bool CgroupController::hasProcessCgroup(const std::string& controller, const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = processCgroups_.find(tenantId);
+    return it != processCgroups_.end() &&
+           std::find(it->second.begin(), it->second.end(), controller) != it->second.end();
+}
+
+bool CgroupController::hasMemoryCgroup(const std::string& tenantId) const {
+    return hasProcessCgroup("memory", tenantId);
+}
+
+bool CgroupController::hasMemoryMembers(const std::string& tenantId) const {
+    return hasProcessMembers("memory", tenantId);
+}
+
+bool CgroupController::hasProcessMembers(const std::string& controller, const std::string& tenantId) const {
+    return hasProcessCgroup(controller, tenantId) && processCgroupHasMembers(controller, tenantId);
+}
+
+bool CgroupController::processCgroupHasMembers(const std::string& controller, const std::string& tenantId) const {
+    // 目录不存在时读取失败，视为无成员；只需判断是否为空，读第一段即可
+    char buffer[64];
+    const char* file = version_ == CgroupVersion::V2 ? "/cgroup.procs" : "/tasks";
+    ssize_t n = readSmallFile(processCgroupPath(controller, tenantId) + file, buffer, sizeof(buffer));
+    for (ssize_t i = 0; i < n; ++i) {
+        if (buffer[i] >= '0' && buffer[i] <= '9') {
+            return true;
+        }
     }
+    return false;
+}
 
-    // 添加到cgroup
-    std::string tenantPath = basePath_ + "/" + tenantId;
-    std::stringstream ss;
-    ss << threadId;
-    if (!writeCgroupFile(tenantPath + "/tasks", ss.str())) {
+bool CgroupController::attachProcess(const std::string& tenantId, pid_t pid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = processCgroups_.find(tenantId);
+    if (it == processCgroups_.end() || it->second.empty()) {
         return false;
     }
+    // v2下所有域控制器共用同一个租户目录
+    if (version_ == CgroupVersion::V2) {
+        return writeCgroupFile(processCgroupPath(it->second.front(), tenantId) + "/cgroup.procs", std::to_string(pid));
+    }
+    bool attached = true;
+    for (const auto& controller : it->second) {
+        attached = writeCgroupFile(processCgroupPath(controller, tenantId) + "/cgroup.procs", std::to_string(pid)) &&
+                   attached;
+    }
+    return attached;
+}
+
+uint64_t CgroupController::getMemoryUsage(const std::string& tenantId) const {
+    std::string path = processCgroupPath("memory", tenantId);
+    if (path.empty()) {
+        return 0;
+    }
+    char buffer[64];
+    const char* file = version_ == CgroupVersion::V2 ? "/memory.current" : "/memory.usage_in_bytes";
+    ssize_t n = readSmallFile(path + file, buffer, sizeof(buffer));
+    uint64_t usage = 0;
+    if (n > 0) {
+        parseUnsigned(buffer, buffer + n, usage);
+    }
+    return usage;
+}
+
+bool CgroupController::readMemoryEvents(const std::string& tenantId, CgroupMemoryEvents& events) const {
+    std::string path = processCgroupPath("memory", tenantId);
+    if (path.empty()) {
+        return false;
+    }
+    char buffer[kStatBufferSize];
+    events = CgroupMemoryEvents();
+
+    if (version_ == CgroupVersion::V2) {
+        ssize_t n = readSmallFile(path + "/memory.events", buffer, sizeof(buffer));
+        if (n < 0) {
+            return false;
+        }
+        parseStatLines(buffer, buffer + n, [&events](std::string_view key, uint64_t value) {
+            if (key == "high") {
+                events.high = value;
+            } else if (key == "max") {
+                events.max = value;
+            } else if (key == "oom") {
+                events.oom = value;
+            } else if (key == "oom_kill") {
+                events.oomKill = value;
+            }
+        });
+        return true;
+    }
 
-    threads.push_back(threadId);
+    ssize_t n = readSmallFile(path + "/memory.failcnt", buffer, sizeof(buffer));
+    if (n < 0) {
+        return false;
+    }
+    parseUnsigned(buffer, buffer + n, events.max);
+    n = readSmallFile(path + "/memory.oom_control", buffer, sizeof(buffer));
+    if (n > 0) {
+        parseStatLines(buffer, buffer + n, [&events](std::string_view key, uint64_t value) {
+            if (key == "under_oom") {
+                events.oom = value;
+            } else if (key == "oom_kill") {
+                events.oomKill = value;
+            }
+        });
+    }
     return true;
 }
 
-bool CgroupController::removeThread(const std::string& tenantId, std::thread::id threadId) {
+bool CgroupController::addThread(const std::string& tenantId, pid_t tid) {
+    return addThreads(tenantId, {tid});
+}
+
+bool CgroupController::addThreads(const std::string& tenantId, const std::vector<pid_t>& tids) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     auto it = tenantThreads_.find(tenantId);
@@ -124,52 +606,165 @@ bool CgroupController::removeThread(const std::string& tenantId, std::thread::id
         return false;
     }
 
+    const char* file = version_ == CgroupVersion::V2 ? "/cgroup.threads" : "/tasks";
+    std::string path = tenantPath(tenantId) + file;
+    // 接口文件由内核随cgroup目录创建，不存在说明层级不可用，不能自行创建
+    int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
     auto& threads = it->second;
-    auto threadIt = std::find(threads.begin(), threads.end(), threadId);
+    std::vector<pid_t> added;
+    bool allAttached = true;
+    for (pid_t tid : tids) {
+        // 检查是否已存在
+        if (std::find(threads.begin(), threads.end(), tid) != threads.end()) {
+            continue;
+        }
+        std::string line = std::to_string(tid) + "\n";
+        if (::write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size())) {
+            std::cerr << "Failed to attach thread " << tid << " to cgroup of tenant " << tenantId
+                      << ": " << std::strerror(errno) << std::endl;
+            allAttached = false;
+            continue;
+        }
+        threads.push_back(tid);
+        added.push_back(tid);
+    }
+    ::close(fd);
+    if (!added.empty()) {
+        allAttached = attachIoThreadsLocked(tenantId, added) && allAttached;
+    }
+    return allAttached;
+}
+
+bool CgroupController::removeThread(const std::string& tenantId, pid_t tid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = tenantThreads_.find(tenantId);
+    if (it == tenantThreads_.end()) {
+        return false;
+    }
+
+    auto& threads = it->second;
+    auto threadIt = std::find(threads.begin(), threads.end(), tid);
     if (threadIt == threads.end()) {
         return true; // 不存在
     }
 
     threads.erase(threadIt);
+
+    // v1的blkio按线程加入，需显式移回层级根，否则线程离开租户后仍受其IO上限约束
+    auto procs = processCgroups_.find(tenantId);
+    if (version_ == CgroupVersion::V1 && procs != processCgroups_.end() &&
+        std::find(procs->second.begin(), procs->second.end(), "blkio") != procs->second.end()) {
+        std::string rootTasks = fs::path(processBasePath("blkio")).parent_path().string() + "/tasks";
+        if (!writeCgroupFile(rootTasks, std::to_string(tid))) {
+            std::cerr << "Failed to detach thread " << tid << " from blkio cgroup of tenant " << tenantId << std::endl;
+            return false;
+        }
+    }
     return true;
 }
 
 uint64_t CgroupController::getCpuUsage(const std::string& tenantId) const {
-    std::string tenantPath = basePath_ + "/" + tenantId;
-    std::string content = readCgroupFile(tenantPath + "/cpuacct.usage");
-    if (content.empty()) return 0;
+    CgroupCpuSample sample;
+    return readCpuSample(tenantId, sample) ? sample.usageNs : 0;
+}
 
-    try {
-        return std::stoull(content);
-    } catch (const std::exception&) {
-        return 0;
+uint64_t CgroupController::getThrottledTime(const std::string& tenantId) const {
+    CgroupCpuSample sample;
+    return readCpuSample(tenantId, sample) ? sample.throttledNs : 0;
+}
+
+bool CgroupController::readCpuSample(const std::string& tenantId, CgroupCpuSample& sample) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return readCpuSampleLocked(tenantId, sample);
+}
+
+size_t CgroupController::collectAll(std::vector<CgroupCpuSample>& samples) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples.resize(std::max(samples.size(), tenantThreads_.size()));
+    size_t count = 0;
+    for (const auto& entry : tenantThreads_) {
+        CgroupCpuSample& sample = samples[count];
+        if (readCpuSampleLocked(entry.first, sample)) {
+            sample.tenantId.assign(entry.first);
+            ++count;
+        }
     }
+    samples.resize(count);
+    return count;
 }
 
-uint64_t CgroupController::getThrottledTime(const std::string& tenantId) const {
-    std::string tenantPath = basePath_ + "/" + tenantId;
-    std::string content = readCgroupFile(tenantPath + "/cpu.stat");
-
-    // 解析throttled_time
-    size_t pos = content.find("throttled_time");
-    if (pos == std::string::npos) return 0;
-
-    std::stringstream ss(content.substr(pos));
-    std::string line;
-    while (std::getline(ss, line)) {
-        if (line.find("throttled_time") != std::string::npos) {
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos) {
-                try {
-                    return std::stoull(line.substr(equalPos + 1));
-                } catch (const std::exception&) {
-                    return 0;
-                }
-            }
+std::vector<CgroupCpuSample> CgroupController::collectAll() const {
+    std::vector<CgroupCpuSample> samples;
+    collectAll(samples);
+    return samples;
+}
+
+bool CgroupController::readCpuSampleLocked(const std::string& tenantId, CgroupCpuSample& sample) const {
+    StatFiles& files = statFiles_[tenantId];
+    char buffer[kStatBufferSize];
+
+    int statFd = acquireFd(files.cpuStatFd, tenantPath(tenantId) + "/cpu.stat");
+    ssize_t n = statFd >= 0 ? readFromStart(statFd, buffer, sizeof(buffer)) : -1;
+    if (n < 0) {
+        // cgroup被外部删除后描述符失效，关闭后下次重新打开
+        closeFd(files.cpuStatFd);
+        if (version_ == CgroupVersion::V2) {
+            statFiles_.erase(tenantId);
+            return false;
         }
+        n = 0;  // v1的cpu.stat缺失时仍可读取用量
     }
 
-    return 0;
+    sample.usageNs = 0;
+    sample.throttledNs = 0;
+    sample.periods = 0;
+    sample.throttledPeriods = 0;
+    const bool v2 = version_ == CgroupVersion::V2;
+    parseStatLines(buffer, buffer + n, [&sample, v2](std::string_view key, uint64_t value) {
+        if (key == "nr_periods") {
+            sample.periods = value;
+        } else if (key == "nr_throttled") {
+            sample.throttledPeriods = value;
+        } else if (v2 && key == "usage_usec") {
+            sample.usageNs = value * 1000;
+        } else if (v2 && key == "throttled_usec") {
+            sample.throttledNs = value * 1000;
+        } else if (!v2 && key == "throttled_time") {
+            sample.throttledNs = value;
+        }
+    });
+    if (v2) {
+        return true;
+    }
+
+    int usageFd = acquireFd(files.cpuUsageFd, tenantPath(tenantId) + "/cpuacct.usage");
+    ssize_t usageBytes = usageFd >= 0 ? readFromStart(usageFd, buffer, sizeof(buffer)) : -1;
+    if (usageBytes < 0) {
+        closeFd(files.cpuUsageFd);
+        if (n == 0) {
+            statFiles_.erase(tenantId);
+            return false;
+        }
+        return true;
+    }
+    parseUnsigned(buffer, buffer + usageBytes, sample.usageNs);
+    return true;
+}
+
+void CgroupController::closeStatFiles(const std::string& tenantId) {
+    auto it = statFiles_.find(tenantId);
+    if (it == statFiles_.end()) {
+        return;
+    }
+    closeFd(it->second.cpuStatFd);
+    closeFd(it->second.cpuUsageFd);
+    statFiles_.erase(it);
 }
 
 bool CgroupController::writeCgroupFile(const std::string& path, const std::string& content) const {
@@ -200,4 +795,152 @@ std::string CgroupController::readCgroupFile(const std::string& path) const {
     }
 }
 
+CgroupAttachBatch::CgroupAttachBatch(CgroupController& controller, std::string tenantId, size_t expected)
+    : controller_(controller), tenantId_(std::move(tenantId)), expected_(expected) {
+    tids_.reserve(expected);
+}
+
+void CgroupAttachBatch::arrive(pid_t tid) {
+    std::vector<pid_t> tids;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tids_.push_back(tid);
+        if (tids_.size() < expected_) {
+            return;
+        }
+        tids.swap(tids_);
+    }
+    controller_.addThreads(tenantId_, tids);
+}
+
+std::string CgroupController::ioControllerName() const {
+    return version_ == CgroupVersion::V2 ? "io" : "blkio";
+}
+
+bool CgroupController::setIoLimit(const std::string& tenantId, const std::string& device, const CgroupIoLimit& limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string controller = ioControllerName();
+    if (device.empty()) {
+        return false;
+    }
+    // 解除上限总是允许，设置上限要求v2的io cgroup中确有进程
+    if (!limit.unlimited() && !ioEnforceableLocked(tenantId)) {
+        std::cerr << "IO limit not enforced for tenant " << tenantId
+                  << ": io cgroup has no member processes (io is a domain controller in cgroup v2)" << std::endl;
+        return false;
+    }
+    if (!ensureProcessCgroup(controller, tenantId)) {
+        return false;
+    }
+
+    std::string path = processCgroupPath(controller, tenantId);
+    if (version_ == CgroupVersion::V2) {
+        auto format = [](uint64_t value) { return value == 0 ? std::string("max") : std::to_string(value); };
+        return writeCgroupFile(path + "/io.max", device + " rbps=" + format(limit.readBps) +
+                                                     " wbps=" + format(limit.writeBps) +
+                                                     " riops=" + format(limit.readIops) +
+                                                     " wiops=" + format(limit.writeIops));
+    }
+    // v1每个文件一条规则，写0删除该设备的规则
+    return writeCgroupFile(path + "/blkio.throttle.read_bps_device", device + " " + std::to_string(limit.readBps)) &&
+           writeCgroupFile(path + "/blkio.throttle.write_bps_device", device + " " + std::to_string(limit.writeBps)) &&
+           writeCgroupFile(path + "/blkio.throttle.read_iops_device", device + " " + std::to_string(limit.readIops)) &&
+           writeCgroupFile(path + "/blkio.throttle.write_iops_device", device + " " + std::to_string(limit.writeIops));
+}
+
+bool CgroupController::setIoWeight(const std::string& tenantId, unsigned weight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string controller = ioControllerName();
+    if (!ioEnforceableLocked(tenantId)) {
+        std::cerr << "IO weight not enforced for tenant " << tenantId
+                  << ": io cgroup has no member processes (io is a domain controller in cgroup v2)" << std::endl;
+        return false;
+    }
+    if (!ensureProcessCgroup(controller, tenantId)) {
+        return false;
+    }
+
+    std::string path = processCgroupPath(controller, tenantId);
+    if (version_ == CgroupVersion::V2) {
+        return writeCgroupFile(path + "/io.weight", "default " + std::to_string(std::min(std::max(weight, 1u), 10000u)));
+    }
+    // v2默认100对应v1默认500
+    return writeCgroupFile(path + "/blkio.weight", std::to_string(std::min(std::max(weight * 5, 10u), 1000u)));
+}
+
+bool CgroupController::hasIoCgroup(const std::string& tenantId) const {
+    return hasProcessCgroup(ioControllerName(), tenantId);
+}
+
+bool CgroupController::hasIoMembers(const std::string& tenantId) const {
+    return hasProcessMembers(ioControllerName(), tenantId);
+}
+
+bool CgroupController::canEnforceIo(const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ioEnforceableLocked(tenantId);
+}
+
+bool CgroupController::ioEnforceableLocked(const std::string& tenantId) const {
+    return version_ == CgroupVersion::V1 || processCgroupHasMembers("io", tenantId);
+}
+
+bool CgroupController::readIoStats(const std::string& tenantId, std::vector<CgroupIoStat>& stats) const {
+    std::string path = processCgroupPath(ioControllerName(), tenantId);
+    stats.clear();
+    if (path.empty()) {
+        return false;
+    }
+    char buffer[4096];
+
+    if (version_ == CgroupVersion::V2) {
+        // 每行形如"8:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=0 dios=0"
+        ssize_t n = readSmallFile(path + "/io.stat", buffer, sizeof(buffer));
+        if (n < 0) {
+            return false;
+        }
+        forEachFields(buffer, buffer + n, [&stats](const std::vector<std::string_view>& fields) {
+            CgroupIoStat& stat = ioStatOf(stats, fields[0]);
+            for (size_t i = 1; i < fields.size(); ++i) {
+                size_t eq = fields[i].find('=');
+                if (eq == std::string_view::npos) {
+                    continue;
+                }
+                std::string_view key = fields[i].substr(0, eq);
+                uint64_t value = 0;
+                parseUnsigned(fields[i].data() + eq + 1, fields[i].data() + fields[i].size(), value);
+                if (key == "rbytes") {
+                    stat.readBytes = value;
+                } else if (key == "wbytes") {
+                    stat.writeBytes = value;
+                } else if (key == "rios") {
+                    stat.readIos = value;
+                } else if (key == "wios") {
+                    stat.writeIos = value;
+                }
+            }
+        });
+        return true;
+    }
+
+    // 每行形如"8:0 Read 4096"，最后一行为不带设备号的"Total"
+    auto readV1 = [&](const char* file, uint64_t CgroupIoStat::*read, uint64_t CgroupIoStat::*write) {
+        ssize_t n = readSmallFile(path + file, buffer, sizeof(buffer));
+        if (n < 0) {
+            return false;
+        }
+        forEachFields(buffer, buffer + n, [&](const std::vector<std::string_view>& fields) {
+            if (fields.size() != 3 || (fields[1] != "Read" && fields[1] != "Write")) {
+                return;
+            }
+            uint64_t value = 0;
+            parseUnsigned(fields[2].data(), fields[2].data() + fields[2].size(), value);
+            ioStatOf(stats, fields[0]).*(fields[1] == "Read" ? read : write) = value;
+        });
+        return true;
+    };
+    return readV1("/blkio.throttle.io_service_bytes", &CgroupIoStat::readBytes, &CgroupIoStat::writeBytes) &&
+           readV1("/blkio.throttle.io_serviced", &CgroupIoStat::readIos, &CgroupIoStat::writeIos);
+}
+
 } // namespace yao
\ No newline at end of file
@@ -6,21 +6,107 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <sys/types.h>
 
 namespace yao {
 
+/**
+ * @brief cgroup层级版本
+ */
+enum class CgroupVersion {
+    None,   ///< 未挂载可用的CPU控制器
+    V1,     ///< 独立挂载的cpu子系统（cpu.shares、tasks、cpuacct.usage）
+    V2      ///< 统一层级（cpu.weight、cpu.max、cgroup.threads、cpu.stat）
+};
+
+/**
+ * @brief 探测cgroup挂载点使用的层级版本
+ * 根目录下有cgroup.controllers且包含cpu控制器时为V2，存在cpu子系统目录时为V1
+ * @param root cgroup挂载根目录
+ */
+CgroupVersion detectCgroupVersion(const std::string& root = "/sys/fs/cgroup");
+
+/**
+ * @brief 一个租户cgroup的CPU统计采样
+ */
+struct CgroupCpuSample {
+    std::string tenantId;
+    uint64_t usageNs = 0;           ///< 累计CPU时间（纳秒）
+    uint64_t throttledNs = 0;       ///< 累计被带宽限制的时间（纳秒）
+    uint64_t periods = 0;           ///< 经历的带宽周期数
+    uint64_t throttledPeriods = 0;  ///< 被限制的周期数
+};
+
+/**
+ * @brief 租户内存cgroup的事件计数（累计值）
+ */
+struct CgroupMemoryEvents {
+    uint64_t high = 0;      ///< 超过memory.high被节流回收的次数（v1无此项）
+    uint64_t max = 0;       ///< 触及memory.max的次数（v1为memory.failcnt）
+    uint64_t oom = 0;       ///< 触发OOM的次数（v1为under_oom）
+    uint64_t oomKill = 0;   ///< 被OOM杀死的进程数
+};
+
+/**
+ * @brief 租户在一个块设备上的IO上限，0表示不限制
+ */
+struct CgroupIoLimit {
+    uint64_t readBps = 0;    ///< 读带宽（字节/秒）
+    uint64_t writeBps = 0;   ///< 写带宽（字节/秒）
+    uint64_t readIops = 0;   ///< 读IOPS
+    uint64_t writeIops = 0;  ///< 写IOPS
+
+    bool unlimited() const { return readBps == 0 && writeBps == 0 && readIops == 0 && writeIops == 0; }
+};
+
+/**
+ * @brief 租户在一个块设备上的IO统计（累计值）
+ */
+struct CgroupIoStat {
+    std::string device;      ///< 设备号，"主:次"
+    uint64_t readBytes = 0;
+    uint64_t writeBytes = 0;
+    uint64_t readIos = 0;
+    uint64_t writeIos = 0;
+};
+
+/**
+ * @brief 当前线程的内核线程ID（gettid），写入tasks/cgroup.threads时使用
+ */
+pid_t currentThreadTid();
+
 /**
  * @brief cgroup控制器
- * 管理Linux cgroup v1的CPU子系统
+ * 管理Linux cgroup的CPU控制器，支持v1和v2（线程化子树）两种层级；
+ * 内存等按进程计费的控制器作用于租户的工作进程（见processCgroupPath）
  */
 class CgroupController {
 public:
-    CgroupController(const std::string& basePath = "/sys/fs/cgroup/cpu/yaobase");
+    /**
+     * @brief 探测/sys/fs/cgroup选择层级版本，基础目录取该版本的默认位置
+     */
+    CgroupController();
+
+    /**
+     * @brief 指定基础目录和层级版本（测试时可指向临时目录）
+     */
+    explicit CgroupController(const std::string& basePath, CgroupVersion version = CgroupVersion::V1);
     ~CgroupController();
 
+    /**
+     * @brief 层级版本对应的默认基础目录
+     */
+    static std::string defaultBasePath(CgroupVersion version);
+
+    CgroupVersion getVersion() const { return version_; }
+    const std::string& getBasePath() const { return basePath_; }
+
     /**
      * @brief 初始化cgroup
+     * v2下会在父目录和基础目录启用cpu控制器，并把本进程移入基础目录，
+     * 使其成为线程化子树的根，租户cgroup才能按线程划分
      * @return 是否成功
      */
     bool initialize();
@@ -42,27 +128,161 @@ public:
 
     /**
      * @brief 设置CPU份额
+     * v2下按份额换算为cpu.weight（1024对应100）
      * @param tenantId 租户ID
      * @param shares CPU份额
      * @return 是否成功
      */
     bool setCpuShares(const std::string& tenantId, int shares);
 
+    /**
+     * @brief 设置CPU带宽上限
+     * v2写cpu.max与cpu.max.burst，v1写cpu.cfs_quota_us/cpu.cfs_period_us与cpu.cfs_burst_us。
+     * 内核不支持突发（5.14之前）时只打印警告，不影响上限本身
+     * @param tenantId 租户ID
+     * @param quotaUs 每周期可用的CPU时间（微秒），负数表示不限制
+     * @param periodUs 周期（微秒）
+     * @param burstUs 可累积到后续周期使用的未用配额上限（微秒），0表示不允许突发
+     * @return 是否成功
+     */
+    bool setCpuMax(const std::string& tenantId, int64_t quotaUs, uint64_t periodUs = 100000, uint64_t burstUs = 0);
+
+    /**
+     * @brief 路径所在的块设备号，分区解析为所属的整盘（io.max只接受整盘）
+     * @param path 文件或目录路径
+     * @return "主:次"，无法解析时为空
+     */
+    static std::string blockDeviceOf(const std::string& path);
+
+    /**
+     * @brief 租户cgroup是否已创建
+     */
+    bool hasTenantCgroup(const std::string& tenantId) const;
+
+    /**
+     * @brief 租户工作进程所在的域cgroup目录
+     * 内存、IO按进程计费，是域控制器，不能在v2的线程化子树中启用，也无法区分同一进程内
+     * 不同租户的线程：v2下使用与基础目录平级的"<基础目录>-procs"子树，v1下使用各子系统
+     * 自己的层级（如/sys/fs/cgroup/memory/yaobase）
+     * @param controller 控制器名，如"memory"
+     * @param tenantId 租户ID
+     */
+    std::string processCgroupPath(const std::string& controller, const std::string& tenantId) const;
+
+    /**
+     * @brief 设置租户内存上限，首次调用时创建租户的内存cgroup
+     * v2写memory.high/memory.max，v1写memory.soft_limit_in_bytes/memory.limit_in_bytes
+     * @param tenantId 租户ID
+     * @param highBytes 超过后内核节流并回收的软上限，0表示不限制
+     * @param maxBytes 硬上限，超过后在cgroup内触发OOM，0表示不限制
+     * @return 是否成功
+     */
+    bool setMemoryLimit(const std::string& tenantId, uint64_t highBytes, uint64_t maxBytes);
+
+    /**
+     * @brief 租户内存cgroup是否已创建
+     */
+    bool hasMemoryCgroup(const std::string& tenantId) const;
+
+    /**
+     * @brief 租户内存cgroup中是否有进程
+     * 内存按进程计费，只有经attachProcess加入的进程受上限约束；所有租户由同一进程服务时
+     * 该cgroup为空，上限与memory.events都不反映租户的实际用量
+     */
+    bool hasMemoryMembers(const std::string& tenantId) const;
+
+    /**
+     * @brief 把为租户单独运行的工作进程加入其已创建的各个进程级cgroup（内存等）
+     * @param tenantId 租户ID
+     * @param pid 进程ID
+     * @return 是否成功
+     */
+    bool attachProcess(const std::string& tenantId, pid_t pid);
+
+    /**
+     * @brief 获取租户内存cgroup当前的内存用量
+     * @return 字节数，不可读时为0
+     */
+    uint64_t getMemoryUsage(const std::string& tenantId) const;
+
+    /**
+     * @brief 读取租户内存cgroup的事件计数
+     * @return 是否可读
+     */
+    bool readMemoryEvents(const std::string& tenantId, CgroupMemoryEvents& events) const;
+
+    /**
+     * @brief 设置租户在块设备上的带宽与IOPS上限，首次调用时创建租户的IO cgroup
+     * v2写io.max，v1写blkio.throttle.{read,write}_{bps,iops}_device。
+     * v1下已加入租户CPU cgroup的工作线程随之写入blkio的tasks，之后addThreads加入的线程同样写入；
+     * v2的io是域控制器，线程化子树中的工作线程无法加入，上限只约束经attachProcess加入的进程
+     * @param tenantId 租户ID
+     * @param device 设备号，"主:次"
+     * @param limit 上限，各项为0表示不限制
+     * @return 是否成功；v2下租户IO cgroup中没有进程时上限无法生效，记录日志并返回false（解除上限除外）
+     */
+    bool setIoLimit(const std::string& tenantId, const std::string& device, const CgroupIoLimit& limit);
+
+    /**
+     * @brief 设置租户IO权重，首次调用时创建租户的IO cgroup
+     * @param weight v2的io.weight取值（1-10000，默认100），v1按比例换算为blkio.weight（10-1000）
+     * @return 是否成功（需要内核的IO调度器支持权重）；v2下租户IO cgroup中没有进程时返回false
+     */
+    bool setIoWeight(const std::string& tenantId, unsigned weight);
+
+    /**
+     * @brief 租户IO cgroup是否已创建
+     */
+    bool hasIoCgroup(const std::string& tenantId) const;
+
+    /**
+     * @brief 租户IO cgroup中是否有成员（v1为按线程加入的工作线程，v2为经attachProcess加入的进程）
+     */
+    bool hasIoMembers(const std::string& tenantId) const;
+
+    /**
+     * @brief 租户的IO上限与权重能否生效：v1按线程加入总是可以，v2要求租户IO cgroup中有进程
+     */
+    bool canEnforceIo(const std::string& tenantId) const;
+
+    /**
+     * @brief 读取租户各块设备的IO统计
+     * v2读io.stat，v1读blkio.throttle.io_service_bytes与blkio.throttle.io_serviced
+     * @param stats 输出，按设备号排序
+     * @return 是否可读
+     */
+    bool readIoStats(const std::string& tenantId, std::vector<CgroupIoStat>& stats) const;
+
+    /**
+     * @brief cpu.shares换算为cpu.weight
+     */
+    static uint64_t sharesToWeight(int shares);
+
     /**
      * @brief 添加线程到cgroup
      * @param tenantId 租户ID
-     * @param threadId 线程ID
+     * @param tid 内核线程ID
      * @return 是否成功
      */
-    bool addThread(const std::string& tenantId, std::thread::id threadId);
+    bool addThread(const std::string& tenantId, pid_t tid);
+
+    /**
+     * @brief 批量添加线程到cgroup，只打开一次tasks/cgroup.threads文件
+     * 内核每次write只接受一个TID，单个线程写入失败（如已退出）不影响其余线程
+     * @param tenantId 租户ID
+     * @param tids 内核线程ID
+     * @return 是否全部成功
+     */
+    bool addThreads(const std::string& tenantId, const std::vector<pid_t>& tids);
 
     /**
      * @brief 从cgroup移除线程
+     * v1下租户blkio cgroup已创建时，线程同时移回blkio层级根
      * @param tenantId 租户ID
-     * @param threadId 线程ID
+     * @param tid 内核线程ID
      * @return 是否成功
      */
-    bool removeThread(const std::string& tenantId, std::thread::id threadId);
+    bool removeThread(const std::string& tenantId, pid_t tid);
 
     /**
      * @brief 获取CPU使用统计
@@ -78,6 +298,25 @@ public:
      */
     uint64_t getThrottledTime(const std::string& tenantId) const;
 
+    /**
+     * @brief 读取租户cgroup的CPU统计
+     * @param tenantId 租户ID
+     * @param sample 输出，成功时tenantId不变，只更新统计字段
+     * @return 统计文件是否可读
+     */
+    bool readCpuSample(const std::string& tenantId, CgroupCpuSample& sample) const;
+
+    /**
+     * @brief 采集所有租户cgroup的CPU统计
+     * 复用samples中已有的元素（及其tenantId的内存），稳定状态下不分配内存；
+     * 统计文件不可读的租户被跳过
+     * @param samples 输出，调整为采集到的租户数
+     * @return 采集到的租户数
+     */
+    size_t collectAll(std::vector<CgroupCpuSample>& samples) const;
+
+    std::vector<CgroupCpuSample> collectAll() const;
+
 private:
     /**
      * @brief 写入cgroup文件
@@ -89,9 +328,98 @@ private:
      */
     std::string readCgroupFile(const std::string& path) const;
 
+    /**
+     * @brief 缓存的统计文件描述符，首次读取时打开，删除租户cgroup时关闭
+     * v1的用量在cpuacct.usage，v2只需要cpu.stat
+     */
+    struct StatFiles {
+        int cpuStatFd = -1;
+        int cpuUsageFd = -1;
+    };
+
+    /**
+     * @brief 读取CPU统计（调用方持有mutex_）
+     */
+    bool readCpuSampleLocked(const std::string& tenantId, CgroupCpuSample& sample) const;
+
+    /**
+     * @brief 关闭租户缓存的文件描述符（调用方持有mutex_）
+     */
+    void closeStatFiles(const std::string& tenantId);
+
+    /**
+     * @brief 确保租户在controller下的进程级cgroup存在（调用方持有mutex_）
+     * v2下首次使用某控制器时在域子树中启用它
+     */
+    bool ensureProcessCgroup(const std::string& controller, const std::string& tenantId);
+
+    /**
+     * @brief 进程级cgroup的基础目录，v1下该子系统未挂载时为空
+     */
+    std::string processBasePath(const std::string& controller) const;
+
+    /**
+     * @brief 是否已为租户创建controller下的进程级cgroup
+     */
+    bool hasProcessCgroup(const std::string& controller, const std::string& tenantId) const;
+
+    /**
+     * @brief 租户在controller下的进程级cgroup是否有成员（v2读cgroup.procs，v1读tasks）
+     */
+    bool hasProcessMembers(const std::string& controller, const std::string& tenantId) const;
+
+    /**
+     * @brief 租户在controller下的进程级目录中是否有成员，不要求已登记该cgroup（不加锁）
+     */
+    bool processCgroupHasMembers(const std::string& controller, const std::string& tenantId) const;
+
+    /**
+     * @brief canEnforceIo的实现（调用方持有mutex_）
+     */
+    bool ioEnforceableLocked(const std::string& tenantId) const;
+
+    /**
+     * @brief IO控制器名：v2为io，v1为blkio
+     */
+    std::string ioControllerName() const;
+
+    /**
+     * @brief v1下把租户工作线程写入其blkio cgroup的tasks（调用方持有mutex_）
+     * v1允许按线程划分blkio；v2的io是域控制器，线程化子树中的线程无法加入
+     * @return IO cgroup尚未创建或全部写入成功时返回true
+     */
+    bool attachIoThreadsLocked(const std::string& tenantId, const std::vector<pid_t>& tids);
+
+    std::string tenantPath(const std::string& tenantId) const { return basePath_ + "/" + tenantId; }
+
     std::string basePath_;
-    std::unordered_map<std::string, std::vector<std::thread::id>> tenantThreads_;
+    CgroupVersion version_;
+    std::unordered_map<std::string, std::vector<pid_t>> tenantThreads_;
+    mutable std::unordered_map<std::string, StatFiles> statFiles_;
+    std::unordered_map<std::string, std::vector<std::string>> processCgroups_;  ///< 租户 -> 已创建的进程级控制器
+    std::vector<std::string> enabledProcessControllers_;  ///< v2域子树中已启用的控制器
     mutable std::mutex mutex_;
 };
 
+/**
+ * @brief 一次启动或扩容中新线程的批量cgroup加入
+ * 新线程启动后登记自己的内核TID，最后一个登记的线程把全部TID一次写入租户cgroup
+ */
+class CgroupAttachBatch {
+public:
+    CgroupAttachBatch(CgroupController& controller, std::string tenantId, size_t expected);
+
+    /**
+     * @brief 登记一个线程的TID（由该线程自己调用）
+     */
+    void arrive(pid_t tid);
+
+private:
+    CgroupController& controller_;
+    std::string tenantId_;
+    std::mutex mutex_;
+    std::vector<pid_t> tids_;
+    size_t expected_;
+};
+
 } // namespace yao
\ No newline at end of file
@@ -1,9 +1,12 @@
 #include "core/resource/CpuMonitor.h"
 #include "core/resource/CpuResourceManager.h"
+#include "core/resource/ThreadPoolManager.h"
+#include "core/tenant/TenantContext.h"
 #include <chrono>
 #include <thread>
 #include <iostream>
-#include <cstdlib>  // for rand()
+#include <utility>
+#include <vector>
 
 namespace yao {
 
@@ -29,25 +32,86 @@ void CpuMonitor::stopMonitoring() {
     }
 }
 
-void CpuMonitor::registerTenant(const std::string& tenantId) {
-    tenantUsages_[tenantId] = 0.0;
+void CpuMonitor::registerTenant(const std::shared_ptr<TenantContext>& tenant) {
+    if (!tenant) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    TenantSample sample;
+    sample.tenant = tenant;
+    tenants_[tenant->getTenantId()] = std::move(sample);
 }
 
 void CpuMonitor::unregisterTenant(const std::string& tenantId) {
-    tenantUsages_.erase(tenantId);
+    std::lock_guard<std::mutex> lock(mutex_);
+    tenants_.erase(tenantId);
+}
+
+double CpuMonitor::getTenantUsage(const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenantId);
+    return it != tenants_.end() ? it->second.usage : -1.0;
+}
+
+void CpuMonitor::sample() {
+    // 读取CPU时间时不持有mutex_：TenantManager会在持有自己的锁时注销租户
+    std::vector<std::pair<std::string, std::shared_ptr<TenantContext>>> tenants;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tenants.reserve(tenants_.size());
+        for (const auto& pair : tenants_) {
+            if (auto tenant = pair.second.tenant.lock()) {
+                tenants.emplace_back(pair.first, std::move(tenant));
+            }
+        }
+    }
+
+    auto& threadManager = ThreadPoolManager::getInstance();
+    auto& cpuManager = CpuResourceManager::getInstance();
+    for (const auto& [tenantId, tenant] : tenants) {
+        uint64_t cpuNs = 0;
+        if (!threadManager.getTenantCpuTime(tenantId, cpuNs)) {
+            continue;  // 线程组尚未创建
+        }
+        auto now = std::chrono::steady_clock::now();
+
+        double usage;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = tenants_.find(tenantId);
+            if (it == tenants_.end()) {
+                continue;  // 采样期间已注销
+            }
+            TenantSample& sample = it->second;
+            uint64_t previousNs = sample.cpuNs;
+            auto previousAt = sample.sampledAt;
+            bool hasPrevious = sample.sampled;
+            sample.cpuNs = cpuNs;
+            sample.sampledAt = now;
+            sample.sampled = true;
+
+            double elapsed = std::chrono::duration<double>(now - previousAt).count();
+            if (!hasPrevious || elapsed <= 0) {
+                continue;
+            }
+            // 退出的线程转交累计值时可能短暂少计，增量为负时按0处理
+            double cores = (cpuNs > previousNs ? cpuNs - previousNs : 0) / 1e9 / elapsed;
+            int millicores = tenant->getCpuQuotaMillicores();
+            sample.usage = millicores > 0 ? cores * 1000.0 / millicores : cores;
+            usage = sample.usage;
+        }
+
+        // 未分配或已释放CPU资源的租户不写入，避免抢先占位导致分配时跳过cgroup配置
+        cpuManager.updateAllocatedCpuUsage(tenantId, usage);
+    }
 }
 
 void CpuMonitor::monitorLoop() {
     while (running_) {
-        // 模拟收集CPU使用情况（实际应从系统获取）
-        for (auto& pair : tenantUsages_) {
-            // 随机使用率用于演示
-            double usage = (std::rand() % 100) / 100.0;
-            pair.second = usage;
-            CpuResourceManager::getInstance().updateCpuUsage(pair.first, usage);
-        }
+        sample();
+        CpuResourceManager::getInstance().refreshThrottleStats();
         std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
     }
 }
 
-} // namespace yao
\ No newline at end of file
+} // namespace yao
@@ -3,13 +3,20 @@
 #include <string>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <cstdint>
 #include <unordered_map>
 
 namespace yao {
 
+class TenantContext;
+
 /**
  * @brief CPU监控器
- * 负责实时监控和统计CPU使用情况
+ * 负责实时监控和统计CPU使用情况：按间隔读取各租户线程组的累计CPU时间，
+ * 换算为相对配额的使用率，不依赖cgroup
  */
 class CpuMonitor {
 public:
@@ -33,9 +40,9 @@ public:
 
     /**
      * @brief 注册租户监控
-     * @param tenantId 租户ID
+     * @param tenant 租户上下文，按其当前的CPU配额换算使用率
      */
-    void registerTenant(const std::string& tenantId);
+    void registerTenant(const std::shared_ptr<TenantContext>& tenant);
 
     /**
      * @brief 注销租户监控
@@ -43,6 +50,19 @@ public:
      */
     void unregisterTenant(const std::string& tenantId);
 
+    /**
+     * @brief 采样一次：读取各租户累计的CPU时间，以两次采样之间占用的核数除以配额核数作为使用率，
+     * 写入CpuResourceManager（只更新已分配CPU资源的租户）。监控线程每个间隔调用一次
+     */
+    void sample();
+
+    /**
+     * @brief 获取租户最近一次采样的使用率
+     * @param tenantId 租户ID
+     * @return 1.0表示用满配额；未注册或尚未采样两次时返回-1
+     */
+    double getTenantUsage(const std::string& tenantId) const;
+
 private:
     CpuMonitor() = default;
     ~CpuMonitor() { stopMonitoring(); }
@@ -50,6 +70,17 @@ private:
     CpuMonitor(const CpuMonitor&) = delete;
     CpuMonitor& operator=(const CpuMonitor&) = delete;
 
+    /**
+     * @brief 租户的上次采样
+     */
+    struct TenantSample {
+        std::weak_ptr<TenantContext> tenant;
+        uint64_t cpuNs = 0;                             ///< 上次采样时的累计CPU时间
+        std::chrono::steady_clock::time_point sampledAt;
+        bool sampled = false;
+        double usage = -1.0;
+    };
+
     /**
      * @brief 监控循环
      */
@@ -58,7 +89,8 @@ private:
     std::thread monitorThread_;
     std::atomic<bool> running_ = false;
     int intervalMs_ = 1000;
-    std::unordered_map<std::string, double> tenantUsages_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, TenantSample> tenants_;
 };
 
-} // namespace yao
\ No newline at end of file
+} // namespace yao
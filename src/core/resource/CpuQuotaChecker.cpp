@@ -18,7 +18,16 @@ bool CpuQuotaChecker::checkQuota(const std::string& tenantId) const {
         return false;
     }
     int quota = tenant->getCpuQuota();
-    return usage < quota;
+    if (usage >= quota) {
+        return false;
+    }
+    double throttledRatio = cpuManager.getThrottleStats(tenantId).throttledRatio;
+    if (throttledRatio >= kMaxThrottledRatio) {
+        std::cerr << "Tenant " << tenantId << " is throttled at its CPU cap (" << throttledRatio * 100
+                  << "% of periods)" << std::endl;
+        return false;
+    }
+    return true;
 }
 
 void CpuQuotaChecker::updateUsage(const std::string& tenantId, double usage) {
@@ -9,8 +9,12 @@ namespace yao {
  */
 class CpuQuotaChecker {
 public:
+    /// 最近一个采样间隔内被CFS限流的周期超过该比例时，说明租户已顶在硬上限，新请求只会排队
+    static constexpr double kMaxThrottledRatio = 0.9;
+
     /**
      * @brief 检查CPU配额
+     * 同时参考cgroup限流统计：持续被限流的租户不再接受新请求
      * @param tenantId 租户ID
      * @return 是否允许执行
      */
@@ -1,5 +1,8 @@
 #include "core/resource/CpuResourceManager.h"
+#include "core/resource/CgroupController.h"
 #include <iostream>  // 临时用于输出，实际应使用日志
+#include <algorithm>
+#include <vector>
 
 namespace yao {
 
@@ -8,16 +11,36 @@ CpuResourceManager& CpuResourceManager::getInstance() {
     return instance;
 }
 
-bool CpuResourceManager::initializeCgroup(bool enableCgroup) {
+bool CpuResourceManager::initializeCgroup(bool enableCgroup, const std::shared_ptr<CgroupController>& controller) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_cgroupEnabled = enableCgroup;
+    m_cgroup = enableCgroup ? controller : nullptr;
     if (enableCgroup) {
-        // TODO: 初始化cgroup目录和权限
-        std::cout << "Cgroup initialized" << std::endl;
+        std::cout << "Cgroup initialized" << (controller ? " with CFS bandwidth control" : " (bookkeeping only)")
+                  << std::endl;
     }
     return true;
 }
 
+void CpuResourceManager::configureBandwidth(uint64_t periodUs, unsigned burstPercent) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 内核允许的周期范围为1ms~1s
+    m_cfsPeriodUs = std::min<uint64_t>(std::max<uint64_t>(periodUs, 1000), 1000000);
+    m_burstPercent = burstPercent;
+}
+
+CpuBandwidth CpuResourceManager::computeBandwidth(int millicores, uint64_t periodUs, unsigned burstPercent) {
+    CpuBandwidth bandwidth;
+    bandwidth.periodUs = periodUs;
+    if (millicores <= 0) {
+        return bandwidth;
+    }
+    // 1000毫核即每周期可用一个周期的CPU时间；内核要求配额不小于1ms
+    bandwidth.quotaUs = std::max<int64_t>(static_cast<int64_t>(millicores) * static_cast<int64_t>(periodUs) / 1000, 1000);
+    bandwidth.burstUs = static_cast<uint64_t>(bandwidth.quotaUs) * burstPercent / 100;
+    return bandwidth;
+}
+
 bool CpuResourceManager::allocateCpuResource(const std::shared_ptr<TenantContext>& tenant) {
     if (!tenant) {
         return false;
@@ -33,18 +56,39 @@ bool CpuResourceManager::allocateCpuResource(const std::shared_ptr<TenantContext
     m_cpuUsage[tenantId] = 0.0;
 
     if (m_cgroupEnabled) {
-        return setCgroupCpuQuota(tenantId, tenant->getCpuQuota());
+        return setCgroupCpuQuota(tenantId, tenant->getCpuQuotaMillicores());
+    }
+
+    return true;
+}
+
+bool CpuResourceManager::updateCpuQuota(const std::shared_ptr<TenantContext>& tenant) {
+    if (!tenant) {
+        return false;
     }
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::string& tenantId = tenant->getTenantId();
+    if (m_cpuUsage.find(tenantId) == m_cpuUsage.end()) {
+        return false;
+    }
+    if (m_cgroupEnabled) {
+        return setCgroupCpuQuota(tenantId, tenant->getCpuQuotaMillicores());
+    }
     return true;
 }
 
 bool CpuResourceManager::releaseCpuResource(const std::string& tenantId) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_cpuUsage.erase(tenantId);
+    m_throttleStats.erase(tenantId);
 
     if (m_cgroupEnabled) {
-        // TODO: 清理cgroup设置
+        // 租户cgroup随线程组一起删除；仍存在时解除上限
+        auto cgroup = m_cgroup.lock();
+        if (cgroup && cgroup->hasTenantCgroup(tenantId)) {
+            cgroup->setCpuMax(tenantId, -1, m_cfsPeriodUs);
+        }
         std::cout << "Released cgroup for tenant: " << tenantId << std::endl;
     }
 
@@ -65,10 +109,72 @@ void CpuResourceManager::updateCpuUsage(const std::string& tenantId, double usag
     m_cpuUsage[tenantId] = usage;
 }
 
-bool CpuResourceManager::setCgroupCpuQuota(const std::string& tenantId, int quota) {
-    // TODO: 实现cgroup CPU配额设置
-    // 例如：写入 /sys/fs/cgroup/cpu/yaobase/tenantId/cpu.shares
-    std::cout << "Setting cgroup CPU quota for tenant " << tenantId << " to " << quota << std::endl;
+bool CpuResourceManager::updateAllocatedCpuUsage(const std::string& tenantId, double usage) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_cpuUsage.find(tenantId);
+    if (it == m_cpuUsage.end()) {
+        return false;
+    }
+    it->second = usage;
+    return true;
+}
+
+void CpuResourceManager::refreshThrottleStats() {
+    std::shared_ptr<CgroupController> cgroup;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cgroup = m_cgroup.lock();
+    }
+    if (!cgroup) {
+        return;
+    }
+
+    // 读文件不持有m_mutex，避免阻塞配额检查
+    std::vector<CgroupCpuSample> samples = cgroup->collectAll();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& sample : samples) {
+        if (m_cpuUsage.find(sample.tenantId) == m_cpuUsage.end()) {
+            continue;  // 不是本管理器分配的租户
+        }
+        CpuThrottleStats& stats = m_throttleStats[sample.tenantId];
+        uint64_t periods = sample.periods - std::min(stats.periods, sample.periods);
+        uint64_t throttled = sample.throttledPeriods - std::min(stats.throttledPeriods, sample.throttledPeriods);
+        stats.throttledRatio = periods > 0 ? static_cast<double>(throttled) / periods : 0.0;
+        stats.periods = sample.periods;
+        stats.throttledPeriods = sample.throttledPeriods;
+        stats.throttledNs = sample.throttledNs;
+    }
+}
+
+CpuThrottleStats CpuResourceManager::getThrottleStats(const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_throttleStats.find(tenantId);
+    return it != m_throttleStats.end() ? it->second : CpuThrottleStats();
+}
+
+bool CpuResourceManager::setCgroupCpuQuota(const std::string& tenantId, int millicores) {
+    CpuBandwidth bandwidth = computeBandwidth(millicores, m_cfsPeriodUs, m_burstPercent);
+    auto cgroup = m_cgroup.lock();
+    if (!cgroup) {
+        std::cout << "Setting cgroup CPU quota for tenant " << tenantId << " to " << millicores << "m" << std::endl;
+        return true;
+    }
+
+    // 份额决定空闲竞争时的比例，带宽决定硬上限：按1000毫核对应默认1024份额
+    int shares = millicores > 0 ? std::max(millicores * 1024 / 1000, 2) : 1024;
+    if (!cgroup->hasTenantCgroup(tenantId) && !cgroup->createTenantCgroup(tenantId, shares)) {
+        std::cerr << "Failed to create cgroup for tenant " << tenantId << std::endl;
+        return false;
+    }
+    if (!cgroup->setCpuShares(tenantId, shares) ||
+        !cgroup->setCpuMax(tenantId, bandwidth.quotaUs, bandwidth.periodUs, bandwidth.burstUs)) {
+        std::cerr << "Failed to set CPU bandwidth for tenant " << tenantId << std::endl;
+        return false;
+    }
+    std::cout << "Set CPU cap for tenant " << tenantId << ": " << millicores << "m ("
+              << bandwidth.quotaUs << "us per " << bandwidth.periodUs << "us, burst "
+              << bandwidth.burstUs << "us)" << std::endl;
     return true;
 }
 
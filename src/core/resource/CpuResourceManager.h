@@ -6,9 +6,31 @@
 #include <memory>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
 
 namespace yao {
 
+class CgroupController;
+
+/**
+ * @brief CFS带宽参数
+ */
+struct CpuBandwidth {
+    int64_t quotaUs = -1;       ///< 每周期可用的CPU时间（微秒），负数表示不限制
+    uint64_t periodUs = 100000; ///< 周期（微秒）
+    uint64_t burstUs = 0;       ///< 允许突发使用的累积配额（微秒）
+};
+
+/**
+ * @brief 租户cgroup的CPU限流统计
+ */
+struct CpuThrottleStats {
+    uint64_t periods = 0;           ///< 累计带宽周期数
+    uint64_t throttledPeriods = 0;  ///< 累计被限流的周期数
+    uint64_t throttledNs = 0;       ///< 累计被限流的时间（纳秒）
+    double throttledRatio = 0.0;    ///< 最近一次采样间隔内被限流周期的比例
+};
+
 /**
  * @brief CPU资源管理器
  * 负责CPU资源的分配、监控和cgroup集成
@@ -24,9 +46,26 @@ public:
     /**
      * @brief 初始化cgroup支持
      * @param enableCgroup 是否启用cgroup
+     * @param controller 写入CFS带宽的cgroup控制器（由ThreadPoolManager持有），为空时只记账；
+     *                   只保存弱引用，ThreadPoolManager关闭后退化为只记账
      * @return 是否初始化成功
      */
-    bool initializeCgroup(bool enableCgroup);
+    bool initializeCgroup(bool enableCgroup, const std::shared_ptr<CgroupController>& controller = nullptr);
+
+    /**
+     * @brief 配置CFS带宽参数，对之后分配的租户生效
+     * @param periodUs 周期（微秒）
+     * @param burstPercent 允许突发的配额占每周期配额的百分比，0表示不允许突发
+     */
+    void configureBandwidth(uint64_t periodUs, unsigned burstPercent);
+
+    /**
+     * @brief 把千分之一核的配额换算为CFS带宽
+     * @param millicores CPU配额，非正数表示不限制
+     * @param periodUs 周期（微秒）
+     * @param burstPercent 突发百分比
+     */
+    static CpuBandwidth computeBandwidth(int millicores, uint64_t periodUs, unsigned burstPercent);
 
     /**
      * @brief 分配CPU资源给租户
@@ -35,6 +74,13 @@ public:
      */
     bool allocateCpuResource(const std::shared_ptr<TenantContext>& tenant);
 
+    /**
+     * @brief 租户配额变更后按新的千分之一核配额更新cgroup份额与带宽
+     * @param tenant 租户上下文
+     * @return 是否更新成功，租户未分配CPU资源时返回false
+     */
+    bool updateCpuQuota(const std::shared_ptr<TenantContext>& tenant);
+
     /**
      * @brief 释放租户的CPU资源
      * @param tenantId 租户ID
@@ -56,6 +102,27 @@ public:
      */
     void updateCpuUsage(const std::string& tenantId, double usage);
 
+    /**
+     * @brief 仅在租户已分配CPU资源时更新使用率，检查与更新在同一次加锁内完成
+     * @param tenantId 租户ID
+     * @param usage CPU使用率
+     * @return 租户是否已分配CPU资源
+     */
+    bool updateAllocatedCpuUsage(const std::string& tenantId, double usage);
+
+    /**
+     * @brief 读取所有租户cgroup的限流统计，计算与上次采样之间被限流周期的比例
+     * 由CpuMonitor按监控间隔调用，未启用cgroup时不做任何事
+     */
+    void refreshThrottleStats();
+
+    /**
+     * @brief 获取租户最近一次采样的限流统计
+     * @param tenantId 租户ID
+     * @return 租户不存在或未启用cgroup时各项为0
+     */
+    CpuThrottleStats getThrottleStats(const std::string& tenantId) const;
+
 private:
     CpuResourceManager() = default;
     ~CpuResourceManager() = default;
@@ -63,16 +130,20 @@ private:
     CpuResourceManager& operator=(const CpuResourceManager&) = delete;
 
     /**
-     * @brief 设置cgroup CPU配额
+     * @brief 设置cgroup CPU配额：按配额设置份额，并用CFS带宽限制硬上限
      * @param tenantId 租户ID
-     * @param quota CPU配额
+     * @param millicores CPU配额（千分之一核）
      * @return 是否设置成功
      */
-    bool setCgroupCpuQuota(const std::string& tenantId, int quota);
+    bool setCgroupCpuQuota(const std::string& tenantId, int millicores);
 
     mutable std::mutex m_mutex;  ///< 互斥锁
     bool m_cgroupEnabled = false;  ///< 是否启用cgroup
+    std::weak_ptr<CgroupController> m_cgroup;  ///< cgroup控制器，为空或已释放时只记账
+    uint64_t m_cfsPeriodUs = 100000;  ///< CFS周期（微秒）
+    unsigned m_burstPercent = 0;  ///< 突发百分比
     std::unordered_map<std::string, double> m_cpuUsage;  ///< 租户CPU使用率映射
+    std::unordered_map<std::string, CpuThrottleStats> m_throttleStats;  ///< 租户限流统计
 };
 
 } // namespace yao
\ No newline at end of file
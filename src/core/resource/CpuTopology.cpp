@@ -0,0 +1,152 @@
+#include "core/resource/CpuTopology.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace fs = std::filesystem;
+
+namespace yao {
+
+namespace {
+
+std::string readFirstLine(const fs::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+    return line;
+}
+
+/**
+ * @brief 读取CPU最高级统一缓存的共享CPU列表，得到缓存域编号
+ */
+int readCacheDomain(const fs::path& cpuDir, int cpu) {
+    int bestLevel = -1;
+    int domain = cpu;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(cpuDir / "cache", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("index", 0) != 0) continue;
+
+        std::string type = readFirstLine(entry.path() / "type");
+        if (type != "Unified") continue;
+
+        int level = std::atoi(readFirstLine(entry.path() / "level").c_str());
+        std::vector<int> shared = CpuTopology::parseCpuList(readFirstLine(entry.path() / "shared_cpu_list"));
+        if (level > bestLevel && !shared.empty()) {
+            bestLevel = level;
+            domain = *std::min_element(shared.begin(), shared.end());
+        }
+    }
+    return domain;
+}
+
+} // namespace
+
+std::vector<int> CpuTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) continue;
+
+        try {
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (first < 0 || last < first) {
+                return {};
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+CpuTopology CpuTopology::uniform(size_t cpuCount) {
+    CpuTopology topology;
+    for (size_t i = 0; i < std::max<size_t>(cpuCount, 1); ++i) {
+        topology.cpus_.push_back({static_cast<int>(i), 0, 0});
+    }
+    return topology;
+}
+
+CpuTopology CpuTopology::detect(const std::string& sysRoot) {
+    fs::path root(sysRoot);
+    std::vector<int> online = parseCpuList(readFirstLine(root / "cpu" / "online"));
+    if (online.empty()) {
+        return uniform(std::thread::hardware_concurrency());
+    }
+
+    // NUMA节点：未出现在任何节点中的CPU归入节点0
+    std::map<int, int> nodeOfCpu;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(root / "node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(static_cast<unsigned char>(name[4]))) {
+            continue;
+        }
+        int node = std::atoi(name.c_str() + 4);
+        for (int cpu : parseCpuList(readFirstLine(entry.path() / "cpulist"))) {
+            nodeOfCpu[cpu] = node;
+        }
+    }
+
+    std::vector<Cpu> cpus;
+    for (int cpu : online) {
+        Cpu info;
+        info.id = cpu;
+        auto it = nodeOfCpu.find(cpu);
+        info.node = it != nodeOfCpu.end() ? it->second : 0;
+        info.cacheDomain = readCacheDomain(root / "cpu" / ("cpu" + std::to_string(cpu)), cpu);
+        cpus.push_back(info);
+    }
+    return fromCpus(std::move(cpus));
+}
+
+CpuTopology CpuTopology::fromCpus(std::vector<Cpu> cpus) {
+    CpuTopology topology;
+    topology.cpus_ = std::move(cpus);
+    std::sort(topology.cpus_.begin(), topology.cpus_.end(), [](const Cpu& a, const Cpu& b) {
+        return std::tie(a.node, a.cacheDomain, a.id) < std::tie(b.node, b.cacheDomain, b.id);
+    });
+    return topology;
+}
+
+size_t CpuTopology::getNodeCount() const {
+    std::set<int> nodes;
+    for (const Cpu& cpu : cpus_) {
+        nodes.insert(cpu.node);
+    }
+    return nodes.size();
+}
+
+size_t CpuTopology::getCacheDomainCount() const {
+    std::set<int> domains;
+    for (const Cpu& cpu : cpus_) {
+        domains.insert(cpu.cacheDomain);
+    }
+    return domains.size();
+}
+
+int CpuTopology::nodeOf(int cpu) const {
+    for (const Cpu& info : cpus_) {
+        if (info.id == cpu) return info.node;
+    }
+    return -1;
+}
+
+} // namespace yao
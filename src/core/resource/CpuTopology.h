@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 机器CPU拓扑：在线CPU及其所属NUMA节点和末级缓存域
+ * Linux下从sysfs读取（node/nodeN/cpulist、cpu/cpuN/cache/indexN/shared_cpu_list），
+ * 读取失败或非Linux平台退化为单节点、单缓存域。
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief 单个逻辑CPU的位置
+     */
+    struct Cpu {
+        int id = 0;
+        int node = 0;        ///< NUMA节点编号
+        int cacheDomain = 0; ///< 末级缓存域编号（共享该缓存的最小CPU编号）
+    };
+
+    /**
+     * @brief 探测当前机器的拓扑
+     * @param sysRoot sysfs中system目录，测试时可指向伪造的目录树
+     */
+    static CpuTopology detect(const std::string& sysRoot = "/sys/devices/system");
+
+    /**
+     * @brief 构造指定CPU数的单节点、单缓存域拓扑
+     */
+    static CpuTopology uniform(size_t cpuCount);
+
+    /**
+     * @brief 由给定的CPU列表构造拓扑
+     */
+    static CpuTopology fromCpus(std::vector<Cpu> cpus);
+
+    /**
+     * @brief 解析cpulist格式（如 "0-3,8,10-11"）
+     * @return CPU编号列表，格式错误时返回空
+     */
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    /**
+     * @brief 按 (节点, 缓存域, CPU编号) 排序的在线CPU
+     */
+    const std::vector<Cpu>& getCpus() const { return cpus_; }
+
+    size_t getCpuCount() const { return cpus_.size(); }
+    size_t getNodeCount() const;
+    size_t getCacheDomainCount() const;
+
+    /**
+     * @brief 查询CPU所在NUMA节点，未知CPU返回-1
+     */
+    int nodeOf(int cpu) const;
+
+private:
+    std::vector<Cpu> cpus_;
+};
+
+} // namespace yao
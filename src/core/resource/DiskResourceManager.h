@@ -5,6 +5,8 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <vector>
+#include "core/resource/CgroupController.h"
 
 namespace yao {
 
@@ -21,6 +23,29 @@ public:
     // 初始化
     bool initialize(size_t totalDiskGB = 100);  // 默认100GB
 
+    /**
+     * @brief 启用块设备IO隔离，对之后分配的租户生效
+     * 分配时按CPU配额比例设置IO权重，并写入默认的带宽/IOPS上限。
+     * v1下租户的工作线程按线程加入blkio cgroup，上限约束这些线程发起的IO；
+     * v2的io是域控制器，上限只约束经CgroupController::attachProcess加入的进程，单进程部署下不生效
+     * @param controller cgroup控制器（由ThreadPoolManager持有，只保存弱引用），为空时只记账
+     * @param device 数据所在块设备号"主:次"
+     * @param defaultLimit 每个租户默认的IO上限，各项为0表示不限制
+     */
+    bool initializeCgroup(const std::shared_ptr<CgroupController>& controller, const std::string& device, const CgroupIoLimit& defaultLimit);
+
+    /**
+     * @brief 调整租户在数据设备上的IO上限
+     * @return 未启用IO隔离或写入失败时返回false
+     */
+    bool setTenantIoLimit(const std::string& tenantId, const CgroupIoLimit& limit);
+
+    /**
+     * @brief 获取租户各块设备的累计IO统计（来自io.stat/blkio）
+     * @return 未启用IO隔离或租户IO cgroup中没有成员时为空
+     */
+    std::vector<CgroupIoStat> getTenantIoStats(const std::string& tenantId) const;
+
     // 磁盘资源分配
     bool allocateDiskResource(const std::shared_ptr<TenantContext>& tenant);
 
@@ -78,6 +103,9 @@ private:
     };
 
     std::unordered_map<std::string, DiskStats> tenantDiskStats_;
+    std::weak_ptr<CgroupController> cgroup_;  ///< 为空或已释放时只记账
+    std::string ioDevice_;                ///< 数据所在块设备号
+    CgroupIoLimit defaultIoLimit_;
     mutable std::mutex mutex_;
     size_t totalDiskGB_ = 0;
     std::atomic<size_t> allocatedTotalGB_ = 0;
@@ -0,0 +1,188 @@
+#include "core/resource/EpochReclaimer.h"
+#include <thread>
+
+namespace yao {
+
+namespace {
+
+// 每退休多少个对象尝试一次回收
+constexpr size_t kCollectThreshold = 64;
+
+} // namespace
+
+EpochReclaimer& EpochReclaimer::getInstance() {
+    static EpochReclaimer instance;
+    return instance;
+}
+
+EpochReclaimer::~EpochReclaimer() {
+    // 进程退出时不再有并发访问，直接释放全部记录和待回收对象
+    ThreadRecord* record = records_.load();
+    while (record) {
+        ThreadRecord* next = record->next;
+        for (auto& bucket : record->buckets) {
+            freeBucket(record, bucket);
+        }
+        delete record;
+        record = next;
+    }
+}
+
+EpochReclaimer::LocalRecord::~LocalRecord() {
+    if (record) {
+        record->state.store(0);
+        record->depth = 0;
+        record->inUse.store(false, std::memory_order_release);
+    }
+}
+
+EpochReclaimer::ThreadRecord* EpochReclaimer::localRecord() {
+    thread_local LocalRecord local;
+    if (!local.record) {
+        local.record = getInstance().acquireRecord();
+    }
+    return local.record;
+}
+
+EpochReclaimer::ThreadRecord* EpochReclaimer::acquireRecord() {
+    // 优先复用已退出线程留下的记录
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if (!record->inUse.load(std::memory_order_relaxed) &&
+            record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    auto* record = new ThreadRecord();
+    record->inUse.store(true, std::memory_order_relaxed);
+    ThreadRecord* head = records_.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!records_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+    return record;
+}
+
+EpochReclaimer::Guard::Guard() : record_(localRecord()) {
+    getInstance().enter(record_);
+}
+
+EpochReclaimer::Guard::~Guard() {
+    getInstance().leave(record_);
+}
+
+void EpochReclaimer::enter(ThreadRecord* record) {
+    if (record->depth++ > 0) return;
+
+    // 登记纪元后需确认全局纪元未变化，否则推进者可能已跳过本线程
+    uint64_t epoch = globalEpoch_.load();
+    while (true) {
+        record->state.store((epoch << 1) | 1);
+        uint64_t current = globalEpoch_.load();
+        if (current == epoch) break;
+        epoch = current;
+    }
+}
+
+void EpochReclaimer::leave(ThreadRecord* record) {
+    if (--record->depth > 0) return;
+    record->state.store(0, std::memory_order_release);
+}
+
+void EpochReclaimer::retire(void* ptr, void (*deleter)(void*)) {
+    ThreadRecord* record = localRecord();
+    uint64_t epoch = globalEpoch_.load();
+
+    Bucket& bucket = record->buckets[epoch % 3];
+    if (bucket.epoch != epoch) {
+        // 同一槽位中的旧对象至少落后三代，可以安全释放
+        freeBucket(record, bucket);
+        bucket.epoch = epoch;
+    }
+    bucket.items.push_back({ptr, deleter});
+    record->pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (++record->retiredSinceCollect >= kCollectThreshold) {
+        collect();
+    }
+}
+
+void EpochReclaimer::collect() {
+    ThreadRecord* record = localRecord();
+    record->retiredSinceCollect = 0;
+    tryAdvance();
+    reclaim(record, globalEpoch_.load());
+}
+
+void EpochReclaimer::synchronize() {
+    // 推进两代后，调用前退休的对象都已越过宽限期
+    uint64_t target = globalEpoch_.load() + 2;
+    while (globalEpoch_.load() < target) {
+        if (!tryAdvance()) {
+            std::this_thread::yield();
+        }
+    }
+
+    uint64_t epoch = globalEpoch_.load();
+    reclaim(localRecord(), epoch);
+
+    // 顺带清理已退出线程遗留的记录
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if (record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            reclaim(record, epoch);
+            record->inUse.store(false, std::memory_order_release);
+        }
+    }
+}
+
+uint64_t EpochReclaimer::getEpoch() const {
+    return globalEpoch_.load();
+}
+
+size_t EpochReclaimer::getPendingCount() const {
+    size_t pending = 0;
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        pending += record->pending.load(std::memory_order_relaxed);
+    }
+    return pending;
+}
+
+bool EpochReclaimer::tryAdvance() {
+    uint64_t epoch = globalEpoch_.load();
+    for (ThreadRecord* record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        uint64_t state = record->state.load();
+        if ((state & 1) && (state >> 1) != epoch) {
+            return false;  // 仍有线程停留在上一纪元
+        }
+    }
+    return globalEpoch_.compare_exchange_strong(epoch, epoch + 1);
+}
+
+void EpochReclaimer::reclaim(ThreadRecord* record, uint64_t epoch) {
+    for (auto& bucket : record->buckets) {
+        if (!bucket.items.empty() && bucket.epoch + 2 <= epoch) {
+            freeBucket(record, bucket);
+        }
+    }
+}
+
+void EpochReclaimer::freeBucket(ThreadRecord* record, Bucket& bucket) {
+    if (bucket.items.empty()) return;
+
+    // 释放函数可能再次退休对象，先摘下整个列表
+    std::vector<Retired> items;
+    items.swap(bucket.items);
+    for (const auto& item : items) {
+        item.deleter(item.ptr);
+    }
+    record->pending.fetch_sub(items.size(), std::memory_order_relaxed);
+
+    // 保留容量，避免下一轮重新分配
+    items.clear();
+    if (bucket.items.empty()) {
+        bucket.items.swap(items);
+    }
+}
+
+} // namespace yao
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "common/utils/CacheLine.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 基于纪元（epoch）的内存安全回收器
+ * 无锁结构摘除的节点可能仍被其他线程读取，不能立即delete。
+ * 访问共享节点的线程需持有Guard，Guard登记线程进入时的全局纪元；
+ * 摘除节点的线程调用retire()把节点挂到当前纪元的待回收列表。
+ * 只有当所有活跃线程都越过该纪元两代之后，节点才会被真正释放。
+ */
+class EpochReclaimer {
+    struct ThreadRecord;
+
+public:
+    /**
+     * @brief 获取单例实例
+     * @return EpochReclaimer实例
+     */
+    static EpochReclaimer& getInstance();
+
+    /**
+     * @brief 临界区守卫（RAII），可嵌套
+     */
+    class Guard {
+    public:
+        Guard();
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        ThreadRecord* record_;
+    };
+
+    /**
+     * @brief 退休一个已从共享结构中摘除的对象
+     * @param ptr 对象指针
+     */
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    /**
+     * @brief 退休一个已从共享结构中摘除的对象
+     * @param ptr 对象指针
+     * @param deleter 释放函数
+     */
+    void retire(void* ptr, void (*deleter)(void*));
+
+    /**
+     * @brief 尝试推进全局纪元并释放当前线程可回收的对象
+     */
+    void collect();
+
+    /**
+     * @brief 等待宽限期结束并释放所有已退休对象
+     * 调用线程不得持有Guard，否则会一直等待
+     */
+    void synchronize();
+
+    /**
+     * @brief 获取当前全局纪元
+     */
+    uint64_t getEpoch() const;
+
+    /**
+     * @brief 获取已退休但尚未释放的对象数量（近似值）
+     */
+    size_t getPendingCount() const;
+
+private:
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    struct Bucket {
+        uint64_t epoch = 0;
+        std::vector<Retired> items;
+    };
+
+    /**
+     * @brief 线程记录，线程退出后标记为空闲并被后续线程复用
+     */
+    struct alignas(kCacheLineSize) ThreadRecord {
+        std::atomic<uint64_t> state{0};    ///< 活跃时为 (纪元 << 1) | 1，空闲时为0
+        std::atomic<bool> inUse{false};
+        std::atomic<size_t> pending{0};
+        ThreadRecord* next = nullptr;
+        unsigned depth = 0;
+        size_t retiredSinceCollect = 0;
+        Bucket buckets[3];
+    };
+
+    struct LocalRecord {
+        ThreadRecord* record = nullptr;
+        ~LocalRecord();
+    };
+
+    EpochReclaimer() = default;
+    ~EpochReclaimer();
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    static ThreadRecord* localRecord();
+
+    ThreadRecord* acquireRecord();
+    void enter(ThreadRecord* record);
+    void leave(ThreadRecord* record);
+    bool tryAdvance();
+    void reclaim(ThreadRecord* record, uint64_t epoch);
+    static void freeBucket(ThreadRecord* record, Bucket& bucket);
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> globalEpoch_{0};
+    alignas(kCacheLineSize) std::atomic<ThreadRecord*> records_{nullptr};
+};
+
+} // namespace yao
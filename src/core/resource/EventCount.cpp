@@ -0,0 +1,114 @@
+#include "core/resource/EventCount.h"
+#include <climits>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace yao {
+
+#ifdef __linux__
+namespace {
+
+uint32_t* futexAddress(std::atomic<uint32_t>& value) {
+    return reinterpret_cast<uint32_t*>(&value);
+}
+
+void futexWait(std::atomic<uint32_t>& value, uint32_t expected, const struct timespec* timeout) {
+    syscall(SYS_futex, futexAddress(value), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& value, int count) {
+    syscall(SYS_futex, futexAddress(value), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+} // namespace
+#endif
+
+EventCount::Key EventCount::prepareWait() {
+    waiters_.fetch_add(1);
+    // 与notify()中的屏障配对：要么通知方看到等待者，要么等待方看到新条件
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_acquire);
+}
+
+void EventCount::cancelWait() {
+    waiters_.fetch_sub(1);
+}
+
+void EventCount::wait(Key key) {
+#ifdef __linux__
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        futexWait(epoch_, key, nullptr);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this, key]() { return epoch_.load(std::memory_order_acquire) != key; });
+    }
+#endif
+    waiters_.fetch_sub(1);
+}
+
+bool EventCount::waitFor(Key key, std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool notified = true;
+#ifdef __linux__
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            notified = false;
+            break;
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000);
+        futexWait(epoch_, key, &ts);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notified = cv_.wait_until(lock, deadline, [this, key]() {
+            return epoch_.load(std::memory_order_acquire) != key;
+        });
+    }
+#endif
+    waiters_.fetch_sub(1);
+    return notified;
+}
+
+void EventCount::notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) {
+        return;  // 没有等待者，无需系统调用
+    }
+    wake(false);
+}
+
+void EventCount::notifyAll() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    wake(true);
+}
+
+void EventCount::wake(bool all) {
+    epoch_.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+    futexWake(epoch_, all ? INT_MAX : 1);
+#else
+    // 加锁保证等待方不会在检查纪元与进入休眠之间错过通知
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    if (all) {
+        cv_.notify_all();
+    } else {
+        cv_.notify_one();
+    }
+#endif
+}
+
+} // namespace yao
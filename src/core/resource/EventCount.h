@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#ifndef __linux__
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace yao {
+
+/**
+ * @brief 自旋等待时的CPU提示指令
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief 事件计数器（eventcount）
+ * 用于"检查条件，不满足则休眠"且不丢失唤醒的等待：
+ *   auto key = ec.prepareWait();
+ *   if (条件已满足) ec.cancelWait(); else ec.wait(key);
+ * 通知方在使条件成立之后调用notify()，没有等待者时notify只有一次原子读。
+ * Linux上基于futex实现，其他平台使用mutex与condition_variable。
+ */
+class EventCount {
+public:
+    using Key = uint32_t;
+
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    /**
+     * @brief 登记为等待者并返回当前纪元
+     * @return 等待凭据，传给wait()
+     */
+    Key prepareWait();
+
+    /**
+     * @brief 条件已满足，撤销prepareWait()的登记
+     */
+    void cancelWait();
+
+    /**
+     * @brief 休眠直到prepareWait()之后有通知到来
+     * @param key prepareWait()返回的凭据
+     */
+    void wait(Key key);
+
+    /**
+     * @brief 带超时的休眠
+     * @param key prepareWait()返回的凭据
+     * @param timeout 最长等待时间
+     * @return 收到通知返回true，超时返回false
+     */
+    bool waitFor(Key key, std::chrono::nanoseconds timeout);
+
+    /**
+     * @brief 唤醒一个等待者
+     */
+    void notify();
+
+    /**
+     * @brief 唤醒所有等待者
+     */
+    void notifyAll();
+
+private:
+    void wake(bool all);
+
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+#ifndef __linux__
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+};
+
+} // namespace yao
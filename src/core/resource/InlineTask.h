@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include "core/resource/TaskMemoryPool.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace yao {
+
+/**
+ * @brief 内联存储的类型擦除任务
+ * 把任意可调用对象包装成Task：捕获状态不超过kInlineSize时直接放在对象内部，
+ * 超出时放入TaskMemoryPool的块中；InlineTask对象本身也从TaskMemoryPool分配。
+ * 因此稳定状态下提交一个任务不触发malloc，同时仍可作为std::unique_ptr<Task>
+ * 进入任意TaskQueue，与虚接口Task的其他实现混用。
+ */
+class InlineTask final : public Task {
+public:
+    /// 内联存储的字节数
+    static constexpr size_t kInlineSize = 64;
+
+    template <typename F, typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<!std::is_same<Fn, InlineTask>::value>::type>
+    explicit InlineTask(F&& fn) {
+        constexpr bool fitsInline = sizeof(Fn) <= kInlineSize &&
+                                    alignof(Fn) <= alignof(std::max_align_t) &&
+                                    std::is_nothrow_move_constructible<Fn>::value;
+        if constexpr (fitsInline) {
+            target_ = new (storage_) Fn(std::forward<F>(fn));
+        } else {
+            void* block = TaskMemoryPool::getInstance().allocate(sizeof(Fn));
+            try {
+                target_ = new (block) Fn(std::forward<F>(fn));
+            } catch (...) {
+                TaskMemoryPool::getInstance().deallocate(block, sizeof(Fn));
+                throw;
+            }
+            overflowSize_ = sizeof(Fn);
+        }
+        invoke_ = [](void* target) { (*static_cast<Fn*>(target))(); };
+        destroy_ = [](void* target) { static_cast<Fn*>(target)->~Fn(); };
+    }
+
+    ~InlineTask() override {
+        destroy_(target_);
+        if (overflowSize_ > 0) {
+            TaskMemoryPool::getInstance().deallocate(target_, overflowSize_);
+        }
+    }
+
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    void execute() override { invoke_(target_); }
+    bool isValid() const override { return target_ != nullptr; }
+
+    /**
+     * @brief 捕获状态是否存放在对象内部
+     */
+    bool isInline() const { return overflowSize_ == 0; }
+
+    static void* operator new(size_t size) { return TaskMemoryPool::getInstance().allocate(size); }
+    static void operator delete(void* ptr, size_t size) { TaskMemoryPool::getInstance().deallocate(ptr, size); }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    void* target_ = nullptr;
+    size_t overflowSize_ = 0;   ///< 非0表示捕获状态在内存池块中
+    void (*invoke_)(void*) = nullptr;
+    void (*destroy_)(void*) = nullptr;
+};
+
+/**
+ * @brief 创建内联任务
+ * @param fn 可调用对象，按值捕获所需状态
+ * @param priority 任务优先级
+ * @return 任务指针
+ */
+template <typename F>
+std::unique_ptr<Task> makeInlineTask(F&& fn, TaskPriority priority = TaskPriority::Normal) {
+    std::unique_ptr<Task> task(new InlineTask(std::forward<F>(fn)));
+    task->setPriority(priority);
+    return task;
+}
+
+} // namespace yao
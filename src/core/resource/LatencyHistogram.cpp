@@ -0,0 +1,118 @@
+#include "core/resource/LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace yao {
+
+namespace {
+
+/**
+ * @brief 最高有效位的位置（value > 0）
+ */
+inline unsigned highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+size_t LatencyHistogram::indexOf(uint64_t nanos) {
+    if (nanos < kSubBuckets) {
+        return static_cast<size_t>(nanos);
+    }
+    unsigned msb = highestBit(nanos);
+    if (msb >= kMaxValueBits) {
+        return kBucketCount - 1;
+    }
+    // 第shift段覆盖[2^msb, 2^(msb+1))，按高kSubBucketBits+1位细分
+    unsigned shift = msb - kSubBucketBits;
+    size_t sub = static_cast<size_t>(nanos >> shift) - kSubBuckets;
+    return kSubBuckets + shift * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::upperBoundOf(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    size_t shift = (index - kSubBuckets) / kSubBuckets;
+    size_t sub = (index - kSubBuckets) % kSubBuckets;
+    uint64_t lower = static_cast<uint64_t>(kSubBuckets + sub) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    uint64_t count = 0;
+    for (const auto& bucket : counts_) {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+std::chrono::nanoseconds LatencyHistogram::getPercentile(double percentile) const {
+    std::vector<uint64_t> counts(kBucketCount);
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(clamped / 100.0 * total)), 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::chrono::nanoseconds(upperBoundOf(i));
+        }
+    }
+    return std::chrono::nanoseconds(upperBoundOf(kBucketCount - 1));
+}
+
+LatencySummary LatencyHistogram::summarize() const {
+    // 一次读取全部计数，各分位数来自同一份快照
+    std::vector<uint64_t> counts(kBucketCount);
+    uint64_t total = 0;
+    size_t highest = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+        if (counts[i] > 0) highest = i;
+    }
+
+    LatencySummary summary;
+    summary.count = total;
+    if (total == 0) {
+        return summary;
+    }
+
+    const double percentiles[] = {50.0, 99.0, 99.9};
+    std::chrono::nanoseconds* outputs[] = {&summary.p50, &summary.p99, &summary.p999};
+    size_t next = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount && next < 3; ++i) {
+        seen += counts[i];
+        while (next < 3 &&
+               seen >= std::max<uint64_t>(static_cast<uint64_t>(std::ceil(percentiles[next] / 100.0 * total)), 1)) {
+            *outputs[next++] = std::chrono::nanoseconds(upperBoundOf(i));
+        }
+    }
+    summary.max = std::chrono::nanoseconds(upperBoundOf(highest));
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : counts_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace yao
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace yao {
+
+/**
+ * @brief 延迟分位数摘要
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds p999{0};
+    std::chrono::nanoseconds max{0};
+};
+
+/**
+ * @brief 无锁对数-线性延迟直方图（HdrHistogram风格）
+ * 数值按最高有效位分段，每段再线性细分为kSubBuckets个桶，相对误差不超过
+ * 1/kSubBuckets（约3%）；小于kSubBuckets纳秒的值精确记录，超过上限的值
+ * 记入最后一个桶。record()只做一次relaxed原子加，可被多个线程并发调用；
+ * 读取分位数时遍历计数，得到的是近似一致的快照。
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr unsigned kMaxValueBits = 42;   ///< 可区分的最大值约73分钟
+    static constexpr size_t kBucketCount = kSubBuckets * (kMaxValueBits - kSubBucketBits + 1);
+
+    /**
+     * @brief 记录一个延迟值
+     * @param nanos 纳秒
+     */
+    void record(uint64_t nanos) {
+        counts_[indexOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record(std::chrono::nanoseconds value) {
+        record(value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0);
+    }
+
+    /**
+     * @brief 已记录的样本数
+     */
+    uint64_t getCount() const;
+
+    /**
+     * @brief 获取分位数对应的值（所在桶的上界）
+     * @param percentile 百分位，如99.9
+     * @return 没有样本时为0
+     */
+    std::chrono::nanoseconds getPercentile(double percentile) const;
+
+    /**
+     * @brief 获取p50/p99/p999及最大值摘要
+     */
+    LatencySummary summarize() const;
+
+    /**
+     * @brief 清空计数
+     */
+    void reset();
+
+    /**
+     * @brief 值所在的桶
+     */
+    static size_t indexOf(uint64_t nanos);
+
+    /**
+     * @brief 桶内可表示的最大值
+     */
+    static uint64_t upperBoundOf(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+};
+
+} // namespace yao
@@ -1,4 +1,5 @@
 #include "core/resource/LockFreeQueue.h"
+#include "core/resource/EpochReclaimer.h"
 #include <iostream>
 
 namespace yao {
@@ -11,7 +12,7 @@ LockFreeQueue::LockFreeQueue(size_t capacity)
 }
 
 LockFreeQueue::~LockFreeQueue() {
-    // 清理所有节点
+    // 清理所有节点（已出队的旧节点由EpochReclaimer负责释放）
     Node* current = head_.load();
     while (current) {
         Node* next = current->next.load();
@@ -25,6 +26,8 @@ bool LockFreeQueue::enqueue(std::unique_ptr<Task> task) {
 
     Node* new_node = new Node(std::move(task));
 
+    // tail节点可能被并发出队并退休，访问期间需持有纪元守卫
+    EpochReclaimer::Guard guard;
     while (true) {
         Node* tail = tail_.load();
         Node* next = tail->next.load();
@@ -45,6 +48,8 @@ bool LockFreeQueue::enqueue(std::unique_ptr<Task> task) {
 }
 
 std::unique_ptr<Task> LockFreeQueue::dequeue() {
+    // 其他消费者可能仍在读取head->next，旧节点只能退休而不能立即删除
+    EpochReclaimer::Guard guard;
     while (true) {
         Node* head = head_.load();
         Node* tail = tail_.load();
@@ -62,7 +67,7 @@ std::unique_ptr<Task> LockFreeQueue::dequeue() {
                 if (head_.compare_exchange_weak(head, next)) {
                     std::unique_ptr<Task> task = std::move(next->task);
                     size_.fetch_sub(1);
-                    delete head;  // 删除旧的dummy节点
+                    EpochReclaimer::getInstance().retire(head);  // 退休旧的dummy节点
                     return task;
                 }
             }
@@ -70,12 +75,98 @@ std::unique_ptr<Task> LockFreeQueue::dequeue() {
     }
 }
 
+size_t LockFreeQueue::enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) {
+    // 在本地把任务串成链，此时链对其他线程不可见，无需原子操作
+    Node* first = nullptr;
+    Node* last = nullptr;
+    size_t count = 0;
+    for (auto& task : tasks) {
+        if (!task) continue;
+        Node* node = new Node(std::move(task));
+        if (last) {
+            last->next.store(node, std::memory_order_relaxed);
+        } else {
+            first = node;
+        }
+        last = node;
+        ++count;
+    }
+    tasks.clear();
+    if (count == 0) return 0;
+
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* tail = tail_.load();
+        Node* next = tail->next.load();
+
+        if (tail == tail_.load()) {
+            if (next == nullptr) {
+                // 一次CAS发布整条链
+                if (tail->next.compare_exchange_weak(next, first)) {
+                    tail_.compare_exchange_weak(tail, last);
+                    size_.fetch_add(count);
+                    return count;
+                }
+            } else {
+                tail_.compare_exchange_weak(tail, next);
+            }
+        }
+    }
+}
+
+size_t LockFreeQueue::dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) {
+    if (maxCount == 0) return 0;
+
+    EpochReclaimer::Guard guard;
+    while (true) {
+        Node* head = head_.load();
+        Node* tail = tail_.load();
+        Node* next = head->next.load();
+
+        if (head != head_.load()) continue;
+
+        if (head == tail) {
+            if (next == nullptr) {
+                return 0;  // 队列为空
+            }
+            tail_.compare_exchange_weak(tail, next);
+            continue;
+        }
+
+        // 向后最多走maxCount个节点，且不越过tail，保证head不会超过tail
+        Node* last = next;
+        size_t count = 1;
+        while (count < maxCount && last != tail) {
+            Node* following = last->next.load();
+            if (following == nullptr) break;
+            last = following;
+            ++count;
+        }
+
+        if (head_.compare_exchange_weak(head, last)) {
+            // head到last之间的节点已归本线程所有，last成为新的dummy节点
+            auto& reclaimer = EpochReclaimer::getInstance();
+            Node* node = head;
+            while (node != last) {
+                Node* following = node->next.load();
+                out.push_back(std::move(following->task));
+                reclaimer.retire(node);
+                node = following;
+            }
+            size_.fetch_sub(count);
+            return count;
+        }
+    }
+}
+
 size_t LockFreeQueue::size() const {
-    return size_.load();
+    // 入队计数晚于节点发布，瞬时可能出现负值
+    size_t size = size_.load();
+    return static_cast<std::ptrdiff_t>(size) < 0 ? 0 : size;
 }
 
 bool LockFreeQueue::empty() const {
-    return size_.load() == 0;
+    return size() == 0;
 }
 
 } // namespace yao
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "core/resource/TaskQueue.h"
+#include "core/resource/TaskMemoryPool.h"
 #include <memory>
 #include <vector>
 #include <thread>
@@ -8,49 +10,49 @@
 
 namespace yao {
 
-/**
- * @brief 任务接口
- */
-class Task {
-public:
-    virtual ~Task() = default;
-    virtual void execute() = 0;
-    virtual bool isValid() const = 0;
-};
-
 /**
  * @brief 无锁任务队列
- * 基于CAS实现的多生产者多消费者无锁队列
+ * 基于CAS实现的多生产者多消费者无锁队列，出队节点经EpochReclaimer延迟释放
  */
-class LockFreeQueue {
+class LockFreeQueue : public TaskQueue {
 public:
     LockFreeQueue(size_t capacity = 1024);
-    ~LockFreeQueue();
+    ~LockFreeQueue() override;
 
     /**
      * @brief 入队操作
      * @param task 任务指针
      * @return 是否成功
      */
-    bool enqueue(std::unique_ptr<Task> task);
+    bool enqueue(std::unique_ptr<Task> task) override;
 
     /**
      * @brief 出队操作
      * @return 任务指针，如果队列为空返回nullptr
      */
-    std::unique_ptr<Task> dequeue();
+    std::unique_ptr<Task> dequeue() override;
+
+    /**
+     * @brief 批量入队：先在本地串好节点链，再用一次CAS挂到队尾
+     */
+    size_t enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) override;
+
+    /**
+     * @brief 批量出队：一次CAS把head向前推进多个节点
+     */
+    size_t dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) override;
 
     /**
      * @brief 获取队列大小
      * @return 当前队列中的任务数量
      */
-    size_t size() const;
+    size_t size() const override;
 
     /**
      * @brief 检查队列是否为空
      * @return 是否为空
      */
-    bool empty() const;
+    bool empty() const override;
 
 private:
     struct Node {
@@ -58,6 +60,10 @@ private:
         std::atomic<Node*> next;
         Node() : next(nullptr) {}
         explicit Node(std::unique_ptr<Task> t) : task(std::move(t)), next(nullptr) {}
+
+        // 节点在提交线程分配、在消费线程经EpochReclaimer释放，走内存池避免每次入队malloc
+        static void* operator new(size_t size) { return TaskMemoryPool::getInstance().allocate(size); }
+        static void operator delete(void* ptr, size_t size) { TaskMemoryPool::getInstance().deallocate(ptr, size); }
     };
 
     std::atomic<Node*> head_;
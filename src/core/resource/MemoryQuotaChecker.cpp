@@ -18,6 +18,15 @@ bool MemoryQuotaChecker::checkQuota(const std::shared_ptr<TenantContext>& tenant
     const std::string& tenantId = tenant->getTenantId();
     auto& memoryManager = MemoryResourceManager::getInstance();
 
+    // 租户内存cgroup中有进程时以实际用量为准，内核最近在cgroup内触发过OOM时拒绝新请求；
+    // cgroup为空（单进程部署）时上限不生效，只按记账检查
+    MemoryCgroupStats cgroupStats = memoryManager.refreshCgroupStats(tenantId);
+    if (cgroupStats.hasMembers && cgroupStats.oomEvents > 0) {
+        std::cerr << "Memory cgroup OOM for tenant: " << tenantId
+                  << " (" << cgroupStats.oomEvents << " recent events)" << std::endl;
+        return false;
+    }
+
     // 获取当前内存使用率
     double currentUsage = memoryManager.getTenantMemoryUsage(tenantId);
     if (currentUsage < 0) {
@@ -47,7 +56,12 @@ bool MemoryQuotaChecker::checkQuota(const std::shared_ptr<TenantContext>& tenant
                   << " (" << currentUsage * 100 << "%)" << std::endl;
     }
 
-    // 检查硬限制
+    // 检查硬限制；触及memory.high说明内核已在节流回收，同样视为达到硬限制
+    if (cgroupStats.hasMembers && cgroupStats.highEvents > 0) {
+        std::cerr << "Memory cgroup high limit reached for tenant: " << tenantId
+                  << " (" << cgroupStats.highEvents << " recent events)" << std::endl;
+        return false;
+    }
     if (currentUsage >= hardLimitThreshold_) {
         std::cerr << "Hard memory limit reached for tenant: " << tenantId
                   << " (" << currentUsage * 100 << "%)" << std::endl;
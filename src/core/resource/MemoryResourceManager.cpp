@@ -15,10 +15,23 @@ bool MemoryResourceManager::initialize(size_t totalMemoryMB) {
     totalMemoryMB_ = totalMemoryMB;
     allocatedTotalMB_ = 0;
     tenantMemoryStats_.clear();
+    cgroupSamples_.clear();
     std::cout << "MemoryResourceManager initialized with " << totalMemoryMB << " MB total memory" << std::endl;
     return true;
 }
 
+bool MemoryResourceManager::initializeCgroup(const std::shared_ptr<CgroupController>& controller, unsigned highPercent) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cgroup_ = controller;
+    highPercent_ = std::min(std::max(highPercent, 1u), 100u);
+    if (controller) {
+        std::cout << "Memory cgroup limits written at memory.high " << highPercent_
+                  << "% of quota; only processes attached to tenant cgroups are limited, "
+                  << "in-process tenants are checked by accounting" << std::endl;
+    }
+    return true;
+}
+
 bool MemoryResourceManager::allocateMemoryResource(const std::shared_ptr<TenantContext>& tenant) {
     if (!tenant) {
         return false;
@@ -32,9 +45,11 @@ bool MemoryResourceManager::allocateMemoryResource(const std::shared_ptr<TenantC
         return true;  // 已分配
     }
 
-    // 计算内存配额（基于CPU配额的比例）
-    double cpuQuota = tenant->getCpuQuota();
-    double memoryQuotaMB = (cpuQuota / 100.0) * totalMemoryMB_ * 0.8;  // 80%比例
+    // 优先使用租户的内存配额，未设置时按CPU配额的比例估算
+    size_t memoryQuotaBytes = tenant->getMemoryQuota();
+    double memoryQuotaMB = memoryQuotaBytes > 0
+        ? static_cast<double>(memoryQuotaBytes) / (1024 * 1024)
+        : (tenant->getCpuQuota() / 100.0) * totalMemoryMB_ * 0.8;  // 80%比例
 
     // 检查总分配是否超过限制
     if (allocatedTotalMB_ + memoryQuotaMB > totalMemoryMB_) {
@@ -42,6 +57,17 @@ bool MemoryResourceManager::allocateMemoryResource(const std::shared_ptr<TenantC
         return false;
     }
 
+    // 内核在memory.high处节流回收，在memory.max处触发cgroup内的OOM。内存按进程计费，
+    // 上限只约束经attachProcess加入的租户进程；租户请求都在本进程内执行时cgroup为空，仍按记账检查配额
+    auto cgroup = cgroup_.lock();
+    if (cgroup && memoryQuotaBytes > 0) {
+        uint64_t highBytes = static_cast<uint64_t>(memoryQuotaBytes) * highPercent_ / 100;
+        if (!cgroup->setMemoryLimit(tenantId, highBytes, memoryQuotaBytes)) {
+            std::cerr << "Failed to set memory cgroup limit for tenant: " << tenantId << std::endl;
+            return false;
+        }
+    }
+
     // 分配内存资源
     tenantMemoryStats_.emplace(tenantId, MemoryStats{memoryQuotaMB, 0.0, 0.0, {0.0}});
     allocatedTotalMB_ += memoryQuotaMB;
@@ -70,6 +96,67 @@ void MemoryResourceManager::updateMemoryUsage(const std::string& tenantId, doubl
     it->second.peakUsage = std::max(it->second.peakUsage.load(), usageMB);
 }
 
+MemoryCgroupStats MemoryResourceManager::refreshCgroupStats(const std::string& tenantId) {
+    std::shared_ptr<CgroupController> cgroup;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cgroup = cgroup_.lock();
+        auto it = cgroupSamples_.find(tenantId);
+        if (it != cgroupSamples_.end() && now - it->second.sampledAt < kCgroupSampleInterval) {
+            return it->second.stats;
+        }
+    }
+    if (!cgroup) {
+        return MemoryCgroupStats();
+    }
+    // 空cgroup的上限不生效，memory.current为0，不能用来覆盖按请求记账的用量
+    if (!cgroup->hasMemoryMembers(tenantId)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tenantMemoryStats_.find(tenantId) == tenantMemoryStats_.end()) {
+            return MemoryCgroupStats();
+        }
+        CgroupSample& sample = cgroupSamples_[tenantId];
+        if (sample.sampledAt == std::chrono::steady_clock::time_point() || sample.stats.hasMembers) {
+            std::cerr << "Warning: memory cgroup of tenant " << tenantId << " has no member processes, "
+                      << "memory limits are not enforced and the quota is checked by accounting only" << std::endl;
+        }
+        sample.stats.usageBytes = 0;
+        sample.stats.highEvents = 0;
+        sample.stats.oomEvents = 0;
+        sample.stats.hasMembers = false;
+        sample.sampledAt = now;
+        return sample.stats;
+    }
+
+    // 读文件不持有mutex_，避免阻塞配额检查
+    CgroupMemoryEvents events;
+    if (!cgroup->readMemoryEvents(tenantId, events)) {
+        return MemoryCgroupStats();
+    }
+    uint64_t usageBytes = cgroup->getMemoryUsage(tenantId);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto stats = tenantMemoryStats_.find(tenantId);
+    if (stats == tenantMemoryStats_.end()) {
+        return MemoryCgroupStats();  // 采样期间已释放
+    }
+    CgroupSample& sample = cgroupSamples_[tenantId];
+    const CgroupMemoryEvents& previous = sample.stats.total;
+    auto delta = [](uint64_t current, uint64_t last) { return current - std::min(current, last); };
+    sample.stats.highEvents = delta(events.high, previous.high);
+    sample.stats.oomEvents = delta(events.oom, previous.oom) + delta(events.oomKill, previous.oomKill);
+    sample.stats.usageBytes = usageBytes;
+    sample.stats.total = events;
+    sample.stats.hasMembers = true;
+    sample.sampledAt = now;
+
+    double usageMB = static_cast<double>(usageBytes) / (1024 * 1024);
+    stats->second.usedMB = usageMB;
+    stats->second.peakUsage = std::max(stats->second.peakUsage.load(), usageMB);
+    return sample.stats;
+}
+
 bool MemoryResourceManager::checkMemoryQuota(const std::string& tenantId, double requestedMB) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = tenantMemoryStats_.find(tenantId);
@@ -90,6 +177,13 @@ void MemoryResourceManager::releaseMemoryResource(const std::string& tenantId) {
 
     allocatedTotalMB_ -= it->second.quotaMB;
     tenantMemoryStats_.erase(it);
+    cgroupSamples_.erase(tenantId);
+
+    // 租户cgroup随线程组一起删除；仍存在时解除上限
+    auto cgroup = cgroup_.lock();
+    if (cgroup && cgroup->hasMemoryCgroup(tenantId)) {
+        cgroup->setMemoryLimit(tenantId, 0, 0);
+    }
 
     std::cout << "Released memory resources for tenant: " << tenantId << std::endl;
 }
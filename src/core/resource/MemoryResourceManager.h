@@ -5,11 +5,25 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "core/resource/CgroupController.h"
 
 namespace yao {
 
 class TenantContext;
 
+/**
+ * @brief 租户内存cgroup的用量与事件统计
+ */
+struct MemoryCgroupStats {
+    uint64_t usageBytes = 0;    ///< cgroup实际内存用量
+    uint64_t highEvents = 0;    ///< 最近一次采样间隔内触及memory.high的次数
+    uint64_t oomEvents = 0;     ///< 最近一次采样间隔内OOM及OOM kill的次数
+    CgroupMemoryEvents total;   ///< 累计事件计数
+    bool hasMembers = false;    ///< cgroup中有进程，上限生效且以上各项有效
+};
+
 /**
  * @brief 内存资源管理器
  * 负责管理租户的内存资源分配和监控
@@ -21,6 +35,27 @@ public:
     // 初始化
     bool initialize(size_t totalMemoryMB = 8192);  // 默认8GB
 
+    /**
+     * @brief 为之后分配的租户在内存cgroup中写入上限
+     * 上限只约束加入租户内存cgroup的进程（CgroupController::attachProcess）；
+     * 所有租户由本进程服务时cgroup为空，上限不生效，配额只按记账检查
+     * @param controller cgroup控制器（由ThreadPoolManager持有，只保存弱引用），为空时只记账
+     * @param highPercent memory.high占租户内存配额的百分比
+     */
+    bool initializeCgroup(const std::shared_ptr<CgroupController>& controller, unsigned highPercent = 90);
+
+    /**
+     * @brief 采样租户内存cgroup的用量与事件计数，并以实际用量更新使用统计
+     * 距上次采样不足kCgroupSampleInterval时直接返回上次的结果
+     * @param tenantId 租户ID
+     * @return 未启用cgroup或租户内存cgroup中没有进程时hasMembers为false、各项为0，且不覆盖记账的用量；
+     *         cgroup中没有进程时首次采样输出警告
+     */
+    MemoryCgroupStats refreshCgroupStats(const std::string& tenantId);
+
+    /// 内存cgroup两次采样的最小间隔
+    static constexpr std::chrono::milliseconds kCgroupSampleInterval{200};
+
     // 内存资源分配
     bool allocateMemoryResource(const std::shared_ptr<TenantContext>& tenant);
 
@@ -77,7 +112,18 @@ private:
         MemoryStats& operator=(const MemoryStats&) = delete;
     };
 
+    /**
+     * @brief 内存cgroup采样状态
+     */
+    struct CgroupSample {
+        MemoryCgroupStats stats;
+        std::chrono::steady_clock::time_point sampledAt;
+    };
+
     std::unordered_map<std::string, MemoryStats> tenantMemoryStats_;
+    std::unordered_map<std::string, CgroupSample> cgroupSamples_;
+    std::weak_ptr<CgroupController> cgroup_;  ///< 为空或已释放时只记账
+    unsigned highPercent_ = 90;
     mutable std::mutex mutex_;
     size_t totalMemoryMB_ = 0;
     std::atomic<size_t> allocatedTotalMB_ = 0;
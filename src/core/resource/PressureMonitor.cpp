@@ -0,0 +1,294 @@
+#include "core/resource/PressureMonitor.h"
+#include "core/resource/CgroupController.h"
+#include <iostream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace yao {
+
+namespace {
+
+constexpr size_t kPressureBufferSize = 256;
+
+/**
+ * @brief 解析"key=value"字段中的数值，返回字段之后的位置
+ */
+const char* parseField(const char* p, const char* end, std::string_view& key, double& value) {
+    const char* start = p;
+    while (p < end && *p != '=' && *p != ' ' && *p != '\n') ++p;
+    key = std::string_view(start, static_cast<size_t>(p - start));
+    value = 0.0;
+    if (p < end && *p == '=') {
+        char* parsed = nullptr;
+        value = std::strtod(p + 1, &parsed);
+        p = parsed > p + 1 ? parsed : p + 1;
+    }
+    while (p < end && *p != ' ' && *p != '\n') ++p;
+    return p;
+}
+
+/**
+ * @brief 从文件开头读取，PSI文件每次读取都是最新的快照
+ */
+ssize_t readPressureFile(int fd, char* buffer, size_t size) {
+    ssize_t n;
+    do {
+        n = ::pread(fd, buffer, size - 1, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n >= 0) {
+        buffer[n] = '\0';  // strtod需要结尾
+    }
+    return n;
+}
+
+} // namespace
+
+PressureMonitor& PressureMonitor::getInstance() {
+    static PressureMonitor instance;
+    return instance;
+}
+
+PressureMonitor::~PressureMonitor() {
+    stopMonitoring();
+    std::lock_guard<std::mutex> sampleLock(sampleMutex_);
+    closeSource(system_);
+    for (auto& pair : tenants_) {
+        closeSource(pair.second);
+    }
+}
+
+bool PressureMonitor::parsePressure(const char* begin, const char* end, PressureSample& sample) {
+    bool hasSome = false;
+    const char* p = begin;
+    while (p < end) {
+        const char* line = p;
+        while (p < end && *p != ' ' && *p != '\n') ++p;
+        std::string_view kind(line, static_cast<size_t>(p - line));
+        if (kind == "some" || kind == "full") {
+            bool some = kind == "some";
+            hasSome = hasSome || some;
+            while (p < end && *p == ' ') {
+                std::string_view key;
+                double value;
+                p = parseField(p + 1, end, key, value);
+                if (key == "avg10") {
+                    (some ? sample.someAvg10 : sample.fullAvg10) = value;
+                } else if (key == "total") {
+                    (some ? sample.someTotalUs : sample.fullTotalUs) = static_cast<uint64_t>(value);
+                }
+            }
+        }
+        while (p < end && *p != '\n') ++p;
+        if (p < end) ++p;
+    }
+    return hasSome;
+}
+
+bool PressureMonitor::initialize(const std::string& procRoot, const std::shared_ptr<CgroupController>& cgroup) {
+    std::lock_guard<std::mutex> sampleLock(sampleMutex_);
+    closeSource(system_);
+    for (auto& pair : tenants_) {
+        closeSource(pair.second);
+    }
+    tenants_.clear();
+    procRoot_ = procRoot;
+    cgroup_ = cgroup;
+    lastSample_ = std::chrono::steady_clock::time_point();
+
+    // 内核未开启PSI时目录不存在，或以psi=0启动时读取返回EOPNOTSUPP
+    readStall(system_.cpu, procRoot_ + "/cpu", 0);
+    bool available = system_.cpu.sampled;
+    closeSource(system_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        systemLevel_ = PressureLevel();
+        for (auto& pair : tenantLevels_) {
+            pair.second = PressureLevel();
+        }
+    }
+    available_ = available;
+    if (available) {
+        std::cout << "PressureMonitor initialized with PSI at " << procRoot_ << std::endl;
+    } else {
+        std::cout << "PSI unavailable at " << procRoot_ << ", pressure-based admission disabled" << std::endl;
+    }
+    return available_;
+}
+
+void PressureMonitor::configure(double stallThreshold, double softLimit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stallThreshold_ = stallThreshold;
+    softLimit_ = softLimit;
+}
+
+bool PressureMonitor::startMonitoring(int intervalMs) {
+    if (!available_ || running_) {
+        return false;
+    }
+    intervalMs_ = intervalMs;
+    running_ = true;
+    monitorThread_ = std::thread(&PressureMonitor::monitorLoop, this);
+    return true;
+}
+
+void PressureMonitor::stopMonitoring() {
+    running_ = false;
+    if (monitorThread_.joinable()) {
+        monitorThread_.join();
+    }
+}
+
+void PressureMonitor::registerTenant(const std::string& tenantId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tenantLevels_.emplace(tenantId, PressureLevel());
+}
+
+void PressureMonitor::unregisterTenant(const std::string& tenantId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tenantLevels_.erase(tenantId);
+}
+
+double PressureMonitor::readStall(PressureFile& file, const std::string& path, uint64_t elapsedUs) {
+    if (file.fd < 0) {
+        file.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file.fd < 0) {
+            return 0.0;
+        }
+    }
+
+    char buffer[kPressureBufferSize];
+    ssize_t n = readPressureFile(file.fd, buffer, sizeof(buffer));
+    PressureSample sample;
+    if (n <= 0 || !parsePressure(buffer, buffer + n, sample)) {
+        // cgroup被删除后描述符失效，下次重新打开
+        ::close(file.fd);
+        file.fd = -1;
+        file.sampled = false;
+        return 0.0;
+    }
+
+    double stall = sample.someAvg10 / 100.0;
+    if (file.sampled && elapsedUs > 0) {
+        uint64_t stalled = sample.someTotalUs - std::min(file.lastTotalUs, sample.someTotalUs);
+        stall = std::min(static_cast<double>(stalled) / elapsedUs, 1.0);
+    }
+    file.lastTotalUs = sample.someTotalUs;
+    file.sampled = true;
+    return stall;
+}
+
+void PressureMonitor::closeSource(PressureSource& source) {
+    for (PressureFile* file : {&source.cpu, &source.memory, &source.io}) {
+        if (file->fd >= 0) {
+            ::close(file->fd);
+        }
+        *file = PressureFile();
+    }
+}
+
+void PressureMonitor::sample() {
+    if (!available_) {
+        return;
+    }
+
+    // 读文件期间只持有sampleMutex_，准入判断不会等待文件IO
+    std::lock_guard<std::mutex> sampleLock(sampleMutex_);
+    auto now = std::chrono::steady_clock::now();
+    uint64_t elapsedUs = lastSample_ == std::chrono::steady_clock::time_point()
+        ? 0
+        : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - lastSample_).count());
+    lastSample_ = now;
+
+    PressureLevel system;
+    system.cpu = readStall(system_.cpu, procRoot_ + "/cpu", elapsedUs);
+    system.memory = readStall(system_.memory, procRoot_ + "/memory", elapsedUs);
+    system.io = readStall(system_.io, procRoot_ + "/io", elapsedUs);
+
+    // 按当前注册的租户同步描述符：新注册的租户首次打开，已注销的租户关闭
+    std::unordered_map<std::string, PressureSource> sources;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sources.reserve(tenantLevels_.size());
+        for (const auto& pair : tenantLevels_) {
+            auto it = tenants_.find(pair.first);
+            if (it != tenants_.end()) {
+                sources.emplace(pair.first, it->second);
+                tenants_.erase(it);
+            } else {
+                sources.emplace(pair.first, PressureSource());
+            }
+        }
+    }
+    for (auto& pair : tenants_) {
+        closeSource(pair.second);
+    }
+    tenants_.swap(sources);
+
+    // 只有v2的cgroup提供PSI；内存和IO在租户的进程级cgroup中
+    std::vector<std::pair<std::string, PressureLevel>> levels;
+    auto cgroup = cgroup_.lock();
+    if (cgroup && cgroup->getVersion() == CgroupVersion::V2) {
+        levels.reserve(tenants_.size());
+        for (auto& pair : tenants_) {
+            const std::string& tenantId = pair.first;
+            PressureSource& source = pair.second;
+            std::string processPath = cgroup->processCgroupPath("memory", tenantId);
+            PressureLevel level;
+            level.cpu = readStall(source.cpu, cgroup->getBasePath() + "/" + tenantId + "/cpu.pressure", elapsedUs);
+            level.memory = readStall(source.memory, processPath + "/memory.pressure", elapsedUs);
+            level.io = readStall(source.io, processPath + "/io.pressure", elapsedUs);
+            levels.emplace_back(tenantId, level);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    systemLevel_ = system;
+    for (const auto& [tenantId, level] : levels) {
+        auto it = tenantLevels_.find(tenantId);
+        if (it != tenantLevels_.end()) {
+            it->second = level;  // 采样期间注销的租户不再发布
+        }
+    }
+}
+
+bool PressureMonitor::shouldShed(const std::string& tenantId, double usageRatio) const {
+    if (!available_) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (usageRatio < softLimit_) {
+        return false;
+    }
+    if (systemLevel_.worst() >= stallThreshold_) {
+        return true;
+    }
+    auto it = tenantLevels_.find(tenantId);
+    return it != tenantLevels_.end() && it->second.worst() >= stallThreshold_;
+}
+
+PressureLevel PressureMonitor::getSystemPressure() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return systemLevel_;
+}
+
+PressureLevel PressureMonitor::getTenantPressure(const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenantLevels_.find(tenantId);
+    return it != tenantLevels_.end() ? it->second : PressureLevel();
+}
+
+void PressureMonitor::monitorLoop() {
+    while (running_) {
+        sample();
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs_));
+    }
+}
+
+} // namespace yao
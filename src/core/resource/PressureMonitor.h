@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace yao {
+
+class CgroupController;
+
+/**
+ * @brief 一个PSI文件（cpu/memory/io.pressure）的解析结果
+ */
+struct PressureSample {
+    double someAvg10 = 0.0;     ///< 最近10秒至少一个任务停顿的时间百分比
+    double fullAvg10 = 0.0;     ///< 最近10秒所有任务同时停顿的时间百分比
+    uint64_t someTotalUs = 0;   ///< 累计some停顿时间（微秒）
+    uint64_t fullTotalUs = 0;   ///< 累计full停顿时间（微秒）
+};
+
+/**
+ * @brief 主机或租户cgroup的停顿比例（0-1），取两次采样之间some停顿时间的增量
+ */
+struct PressureLevel {
+    double cpu = 0.0;
+    double memory = 0.0;
+    double io = 0.0;
+
+    double worst() const { return std::max(cpu, std::max(memory, io)); }
+};
+
+/**
+ * @brief PSI压力监控器
+ * 后台线程按间隔读取/proc/pressure和租户cgroup的cpu/memory/io.pressure，
+ * 读文件时不持有准入路径使用的锁，读完后再发布结果。内核不支持PSI时不做任何限制。
+ */
+class PressureMonitor {
+public:
+    static PressureMonitor& getInstance();
+
+    /**
+     * @brief 初始化
+     * @param procRoot 系统PSI目录
+     * @param cgroup 读取租户cgroup压力的控制器（仅v2，只保存弱引用），为空或已释放时只看主机压力
+     * @return PSI是否可用
+     */
+    bool initialize(const std::string& procRoot = "/proc/pressure",
+                    const std::shared_ptr<CgroupController>& cgroup = nullptr);
+
+    /**
+     * @brief 设置准入阈值
+     * @param stallThreshold 停顿比例达到该值视为有压力
+     * @param softLimit 租户资源使用率达到该值视为超过软限制
+     */
+    void configure(double stallThreshold, double softLimit);
+
+    /**
+     * @brief 启动后台采样
+     * @param intervalMs 采样间隔（毫秒）
+     * @return PSI不可用或已启动时返回false
+     */
+    bool startMonitoring(int intervalMs = 1000);
+
+    /**
+     * @brief 停止后台采样
+     */
+    void stopMonitoring();
+
+    /**
+     * @brief 采样一次主机和已注册租户的压力（后台线程每个间隔调用）
+     */
+    void sample();
+
+    /**
+     * @brief 注册需要采样cgroup压力的租户，下次采样时打开其PSI文件
+     */
+    void registerTenant(const std::string& tenantId);
+
+    /**
+     * @brief 注销租户，其PSI文件在下次采样时关闭
+     */
+    void unregisterTenant(const std::string& tenantId);
+
+    /**
+     * @brief 准入判断：主机或租户cgroup出现停顿时，拒绝超过软限制的租户
+     * @param tenantId 租户ID
+     * @param usageRatio 租户各项资源使用率（相对配额）中的最大值
+     * @return 是否应拒绝
+     */
+    bool shouldShed(const std::string& tenantId, double usageRatio) const;
+
+    /**
+     * @brief 被拒绝的请求建议的重试间隔
+     */
+    std::chrono::milliseconds getRetryAfter() const { return std::chrono::milliseconds(intervalMs_); }
+
+    bool isAvailable() const { return available_; }
+    PressureLevel getSystemPressure() const;
+    PressureLevel getTenantPressure(const std::string& tenantId) const;
+
+    /**
+     * @brief 解析PSI文件内容
+     * 格式为"some avg10=0.12 avg60=0.05 avg300=0.01 total=123\nfull ..."
+     * @return 是否包含some行
+     */
+    static bool parsePressure(const char* begin, const char* end, PressureSample& sample);
+
+private:
+    PressureMonitor() = default;
+    ~PressureMonitor();
+    PressureMonitor(const PressureMonitor&) = delete;
+    PressureMonitor& operator=(const PressureMonitor&) = delete;
+
+    /**
+     * @brief 缓存描述符的一个PSI文件及上次采样
+     */
+    struct PressureFile {
+        int fd = -1;
+        uint64_t lastTotalUs = 0;
+        bool sampled = false;
+    };
+
+    /**
+     * @brief 一组cpu/memory/io PSI文件
+     */
+    struct PressureSource {
+        PressureFile cpu;
+        PressureFile memory;
+        PressureFile io;
+    };
+
+    /**
+     * @brief 读取一个PSI文件并计算停顿比例；首次采样使用avg10
+     */
+    static double readStall(PressureFile& file, const std::string& path, uint64_t elapsedUs);
+    static void closeSource(PressureSource& source);
+    void monitorLoop();
+
+    // 采样状态（描述符与上次的累计停顿时间），读文件期间持有sampleMutex_；加锁顺序为sampleMutex_、mutex_
+    std::mutex sampleMutex_;
+    std::string procRoot_ = "/proc/pressure";
+    std::weak_ptr<CgroupController> cgroup_;
+    PressureSource system_;
+    std::unordered_map<std::string, PressureSource> tenants_;
+    std::chrono::steady_clock::time_point lastSample_;
+
+    // 发布的采样结果与阈值，准入路径只短暂持有mutex_
+    mutable std::mutex mutex_;
+    std::atomic<bool> available_{false};
+    PressureLevel systemLevel_;
+    std::unordered_map<std::string, PressureLevel> tenantLevels_;  ///< 已注册的租户
+    double stallThreshold_ = 0.2;
+    double softLimit_ = 0.7;
+
+    std::thread monitorThread_;
+    std::atomic<bool> running_{false};
+    int intervalMs_ = 1000;
+};
+
+} // namespace yao
@@ -0,0 +1,131 @@
+#include "core/resource/PriorityTaskQueue.h"
+#include <algorithm>
+
+namespace yao {
+
+namespace {
+
+size_t laneIndex(TaskPriority priority) {
+    size_t index = static_cast<size_t>(priority);
+    return index < kTaskPriorityCount ? index : static_cast<size_t>(TaskPriority::Normal);
+}
+
+} // namespace
+
+PriorityTaskQueue::PriorityTaskQueue(TaskQueueEngine engine, size_t capacity, LanePolicy policy,
+                                     const LaneWeights& weights)
+    : policy_(policy) {
+    for (auto& lane : lanes_) {
+        lane = createTaskQueue(engine, capacity);
+    }
+
+    // 平滑加权轮询（smooth weighted round-robin）：高权重通道均匀分散在序列中，
+    // 权重限制在[1, 64]以控制序列长度
+    std::array<int64_t, kTaskPriorityCount> clamped{};
+    std::array<int64_t, kTaskPriorityCount> current{};
+    int64_t total = 0;
+    for (size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+        clamped[lane] = std::min<uint32_t>(std::max<uint32_t>(weights[lane], 1), 64);
+        total += clamped[lane];
+    }
+    for (int64_t i = 0; i < total; ++i) {
+        size_t best = 0;
+        for (size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+            current[lane] += clamped[lane];
+            if (current[lane] > current[best]) {
+                best = lane;
+            }
+        }
+        current[best] -= total;
+        schedule_.push_back(static_cast<uint8_t>(best));
+    }
+}
+
+size_t PriorityTaskQueue::firstLane() {
+    if (policy_ == LanePolicy::Strict) {
+        return 0;
+    }
+    return schedule_[tick_.fetch_add(1, std::memory_order_relaxed) % schedule_.size()];
+}
+
+bool PriorityTaskQueue::enqueue(std::unique_ptr<Task> task) {
+    if (!task) return false;
+    size_t lane = laneIndex(task->getPriority());
+    return lanes_[lane]->enqueue(std::move(task));
+}
+
+std::unique_ptr<Task> PriorityTaskQueue::dequeue() {
+    size_t first = firstLane();
+    if (auto task = lanes_[first]->dequeue()) {
+        return task;
+    }
+    // 选中的通道为空，按优先级从高到低取其他通道
+    for (size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+        if (lane == first) continue;
+        if (auto task = lanes_[lane]->dequeue()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+size_t PriorityTaskQueue::enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) {
+    // 按通道分组后各自批量入队，未能入队的任务放回tasks
+    std::array<std::vector<std::unique_ptr<Task>>, kTaskPriorityCount> perLane;
+    for (auto& task : tasks) {
+        if (!task) continue;
+        perLane[laneIndex(task->getPriority())].push_back(std::move(task));
+    }
+    tasks.clear();
+
+    size_t submitted = 0;
+    for (size_t lane = 0; lane < kTaskPriorityCount; ++lane) {
+        if (perLane[lane].empty()) continue;
+        submitted += lanes_[lane]->enqueueBulk(perLane[lane]);
+        for (auto& rejected : perLane[lane]) {
+            tasks.push_back(std::move(rejected));
+        }
+    }
+    return submitted;
+}
+
+size_t PriorityTaskQueue::dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) {
+    if (maxCount == 0) return 0;
+
+    size_t first = firstLane();
+    size_t taken = lanes_[first]->dequeueBulk(out, maxCount);
+    for (size_t lane = 0; lane < kTaskPriorityCount && taken < maxCount; ++lane) {
+        if (lane == first) continue;
+        taken += lanes_[lane]->dequeueBulk(out, maxCount - taken);
+    }
+    return taken;
+}
+
+size_t PriorityTaskQueue::size() const {
+    size_t total = 0;
+    for (const auto& lane : lanes_) {
+        total += lane->size();
+    }
+    return total;
+}
+
+bool PriorityTaskQueue::empty() const {
+    return std::all_of(lanes_.begin(), lanes_.end(),
+                       [](const std::unique_ptr<TaskQueue>& lane) { return lane->empty(); });
+}
+
+size_t PriorityTaskQueue::laneSize(TaskPriority priority) const {
+    return lanes_[laneIndex(priority)]->size();
+}
+
+LanePolicy parseLanePolicy(const std::string& name, LanePolicy defaultPolicy) {
+    if (name == "strict") {
+        return LanePolicy::Strict;
+    }
+    if (name == "weighted") {
+        return LanePolicy::Weighted;
+    }
+    return defaultPolicy;
+}
+
+} // namespace yao
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 优先级通道出队策略
+ */
+enum class LanePolicy {
+    Strict,    ///< 高优先级通道非空时总是先取高优先级
+    Weighted   ///< 按通道权重轮流出队，低优先级通道不会饿死
+};
+
+/**
+ * @brief 多优先级通道任务队列
+ * 每个TaskPriority对应一个独立的子队列，入队按任务优先级分流，
+ * 出队按LanePolicy选择通道；选中的通道为空时依次尝试其他通道，保证不空转。
+ */
+class PriorityTaskQueue : public TaskQueue {
+public:
+    using LaneWeights = std::array<uint32_t, kTaskPriorityCount>;
+
+    /**
+     * @brief 构造函数
+     * @param engine 各通道使用的队列引擎
+     * @param capacity 每个通道的容量
+     * @param policy 出队策略
+     * @param weights 各通道权重（High, Normal, Low），仅Weighted策略使用
+     */
+    PriorityTaskQueue(TaskQueueEngine engine, size_t capacity, LanePolicy policy,
+                      const LaneWeights& weights = LaneWeights{16, 4, 1});
+
+    bool enqueue(std::unique_ptr<Task> task) override;
+    std::unique_ptr<Task> dequeue() override;
+    size_t enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) override;
+    size_t dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) override;
+    size_t size() const override;
+    bool empty() const override;
+
+    /**
+     * @brief 获取指定通道的任务数量
+     */
+    size_t laneSize(TaskPriority priority) const;
+
+private:
+    /**
+     * @brief 本次出队首先尝试的通道
+     */
+    size_t firstLane();
+
+    std::array<std::unique_ptr<TaskQueue>, kTaskPriorityCount> lanes_;
+    LanePolicy policy_;
+    std::vector<uint8_t> schedule_;      ///< 平滑加权轮询序列，元素为通道下标
+    std::atomic<uint64_t> tick_{0};
+};
+
+/**
+ * @brief 解析通道出队策略名称（"strict" / "weighted"）
+ */
+LanePolicy parseLanePolicy(const std::string& name, LanePolicy defaultPolicy = LanePolicy::Weighted);
+
+} // namespace yao
@@ -0,0 +1,62 @@
+#include "core/resource/ResizeHandle.h"
+
+namespace yao {
+
+ResizeTracker::ResizeTracker(size_t pendingWorkers)
+    : pending_(pendingWorkers) {
+}
+
+void ResizeTracker::arrive() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_ > 0 && --pending_ == 0) {
+        cv_.notify_all();
+    }
+}
+
+bool ResizeTracker::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_ == 0;
+}
+
+bool ResizeTracker::waitFor(std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this]() { return pending_ == 0; });
+}
+
+void ResizeTracker::wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+ResizeHandle ResizeHandle::completed() {
+    ResizeHandle handle;
+    handle.accepted_ = true;
+    return handle;
+}
+
+ResizeHandle ResizeHandle::pending(std::shared_ptr<ResizeTracker> tracker) {
+    ResizeHandle handle;
+    handle.accepted_ = true;
+    handle.tracker_ = std::move(tracker);
+    return handle;
+}
+
+bool ResizeHandle::isDone() const {
+    return !tracker_ || tracker_->isDone();
+}
+
+bool ResizeHandle::wait() const {
+    if (tracker_) {
+        tracker_->wait();
+    }
+    return accepted_;
+}
+
+bool ResizeHandle::waitFor(std::chrono::milliseconds timeout) const {
+    if (tracker_ && !tracker_->waitFor(timeout)) {
+        return false;
+    }
+    return accepted_;
+}
+
+} // namespace yao
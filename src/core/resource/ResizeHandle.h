@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace yao {
+
+/**
+ * @brief 异步缩容的进度，由每个退出的工作线程调用arrive()
+ */
+class ResizeTracker {
+public:
+    explicit ResizeTracker(size_t pendingWorkers);
+
+    /**
+     * @brief 一个待退出的工作线程执行完当前任务并退出
+     */
+    void arrive();
+
+    bool isDone() const;
+
+    /**
+     * @brief 等待所有待退出线程退出
+     * @param timeout 超时时间
+     * @return 是否在超时前完成
+     */
+    bool waitFor(std::chrono::milliseconds timeout) const;
+
+    void wait() const;
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    size_t pending_;
+};
+
+/**
+ * @brief 线程组调整的完成句柄
+ * 调整请求被接受后立即返回：扩容的新线程已启动，缩容的线程在执行完
+ * 当前任务后自行退出。operator bool表示请求是否被接受，wait()等待
+ * 被移除的线程全部退出。
+ */
+class ResizeHandle {
+public:
+    /**
+     * @brief 构造被拒绝的句柄
+     */
+    ResizeHandle() = default;
+
+    /**
+     * @brief 已接受且无需等待的句柄
+     */
+    static ResizeHandle completed();
+
+    /**
+     * @brief 已接受、需等待tracker完成的句柄
+     */
+    static ResizeHandle pending(std::shared_ptr<ResizeTracker> tracker);
+
+    /**
+     * @brief 请求是否被接受
+     */
+    explicit operator bool() const { return accepted_; }
+
+    /**
+     * @brief 调整是否已全部生效（被拒绝的句柄视为已完成）
+     */
+    bool isDone() const;
+
+    /**
+     * @brief 等待调整完成
+     * @return 请求被接受且已完成时返回true
+     */
+    bool wait() const;
+
+    /**
+     * @brief 限时等待调整完成
+     * @return 请求被接受且在超时前完成时返回true
+     */
+    bool waitFor(std::chrono::milliseconds timeout) const;
+
+private:
+    bool accepted_ = false;
+    std::shared_ptr<ResizeTracker> tracker_;
+};
+
+} // namespace yao
@@ -0,0 +1,112 @@
+#include "core/resource/ResumableTask.h"
+#include "core/resource/ThreadCpuClock.h"
+
+namespace yao {
+
+/**
+ * @brief 提交到租户队列的一段任务
+ * 在队列中因超时/取消被丢弃（未执行即析构）时放弃整个任务
+ */
+class ResumableTask::Segment : public Task {
+public:
+    explicit Segment(std::shared_ptr<ResumableTask> owner) : owner_(std::move(owner)) {}
+
+    ~Segment() override {
+        if (!ran_ && owner_) {
+            owner_->abandon();
+        }
+    }
+
+    void execute() override {
+        ran_ = true;
+        owner_->runSegments();
+    }
+
+    bool isValid() const override { return owner_ != nullptr; }
+
+private:
+    std::shared_ptr<ResumableTask> owner_;
+    bool ran_ = false;
+};
+
+bool ResumableTask::Resumer::resume() const {
+    if (!task_) return false;
+
+    int state = task_->state_.load();
+    for (;;) {
+        if (state == kRunning) {
+            // step()尚未返回，由执行线程直接继续
+            if (task_->state_.compare_exchange_weak(state, kResumePending)) return true;
+        } else if (state == kSuspended) {
+            if (task_->state_.compare_exchange_weak(state, kQueued)) return task_->submitSegment();
+        } else {
+            return false;
+        }
+    }
+}
+
+bool ResumableTask::start(Submitter submitter) {
+    submitter_ = std::move(submitter);
+    state_.store(kQueued);
+    return submitSegment();
+}
+
+std::unique_ptr<Task> ResumableTask::begin(Submitter submitter) {
+    submitter_ = std::move(submitter);
+    state_.store(kQueued);
+    return makeSegment();
+}
+
+std::unique_ptr<Task> ResumableTask::makeSegment() {
+    auto segment = std::make_unique<Segment>(shared_from_this());
+    segment->setDeadline(deadline_);
+    segment->setCancellationToken(token_);
+    segment->setPriority(priority_);
+    return segment;
+}
+
+bool ResumableTask::submitSegment() {
+    if (!submitter_ || !submitter_(makeSegment())) {
+        abandon();
+        return false;
+    }
+    return true;
+}
+
+void ResumableTask::runSegments() {
+    state_.store(kRunning);
+    for (;;) {
+        uint64_t start = threadCpuTimeNs();
+        Step result;
+        try {
+            result = step();
+        } catch (...) {
+            cpuNs_.fetch_add(threadCpuTimeNs() - start);
+            segments_.fetch_add(1);
+            abandon();
+            throw;
+        }
+        cpuNs_.fetch_add(threadCpuTimeNs() - start);
+        segments_.fetch_add(1);
+
+        if (result == Step::Done) {
+            state_.store(kDone);
+            return;
+        }
+
+        int expected = kRunning;
+        if (state_.compare_exchange_strong(expected, kSuspended)) {
+            return;
+        }
+        // 挂起前已被resume()，继续执行下一段
+        state_.store(kRunning);
+    }
+}
+
+void ResumableTask::abandon() {
+    if (state_.exchange(kDone) != kDone) {
+        onAbandoned();
+    }
+}
+
+} // namespace yao
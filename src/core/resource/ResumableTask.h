@@ -0,0 +1,169 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace yao {
+
+/**
+ * @brief 可挂起的多段任务
+ * 以续体（continuation）方式编写的任务，在C++17下代替协程：工作线程每次
+ * 调用step()推进一段，step()返回Suspend时任务让出工作线程，等待外部
+ * （如DataServer/TransServer回包）通过Resumer::resume()把下一段重新提交到
+ * 所属租户的线程组。这样每个租户少量工作线程即可同时推进大量查询。
+ *
+ * 每一段都经提交函数进入租户自己的队列，在该租户的线程（及其cgroup）上执行，
+ * 各段消耗的线程CPU时间累加到getCpuTime()。
+ * resume()可以在step()返回之前调用（回调在发起线程上同步完成），此时不重新
+ * 提交，由当前线程直接继续执行下一段。
+ */
+class ResumableTask : public std::enable_shared_from_this<ResumableTask> {
+public:
+    /**
+     * @brief step()的返回值
+     */
+    enum class Step {
+        Done,     ///< 任务结束
+        Suspend   ///< 等待resume()后继续
+    };
+
+    /// 把一段任务提交到所属租户的线程组
+    using Submitter = std::function<bool(std::unique_ptr<Task>)>;
+
+    /**
+     * @brief 恢复句柄，由step()交给异步操作，完成时调用resume()
+     */
+    class Resumer {
+    public:
+        Resumer() = default;
+
+        /**
+         * @brief 恢复挂起的任务，每次挂起只有第一次调用生效
+         * @return 是否使任务继续（重复调用、任务已结束或无法提交时返回false）
+         */
+        bool resume() const;
+
+    private:
+        friend class ResumableTask;
+        explicit Resumer(std::shared_ptr<ResumableTask> task) : task_(std::move(task)) {}
+
+        std::shared_ptr<ResumableTask> task_;
+    };
+
+    virtual ~ResumableTask() = default;
+
+    /**
+     * @brief 提交第一段
+     * @param submitter 提交函数，之后每次恢复都经它提交
+     * @return 是否提交成功
+     */
+    bool start(Submitter submitter);
+
+    /**
+     * @brief 生成第一段交给调用方提交（如需经过准入控制），之后每次恢复经submitter提交
+     * 第一段未执行即被丢弃时任务被放弃
+     * @param submitter 恢复时使用的提交函数
+     * @return 第一段任务
+     */
+    std::unique_ptr<Task> begin(Submitter submitter);
+
+    /**
+     * @brief 设置各段共用的截止时间，需在start前设置
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+    /**
+     * @brief 设置各段共用的取消令牌，需在start前设置
+     */
+    void setCancellationToken(CancellationToken token) { token_ = std::move(token); }
+
+    /**
+     * @brief 设置各段的优先级，需在start前设置
+     */
+    void setPriority(TaskPriority priority) { priority_ = priority; }
+
+    /**
+     * @brief 执行中的段协作式检查：已取消或已超时时应尽快返回Done
+     */
+    bool shouldStop() const {
+        return token_.isCancelled() ||
+               (deadline_ != std::chrono::steady_clock::time_point::max() &&
+                std::chrono::steady_clock::now() >= deadline_);
+    }
+
+    /**
+     * @brief 任务是否已结束（完成或被放弃）
+     */
+    bool isDone() const { return state_.load() == kDone; }
+
+    /**
+     * @brief 已执行的段数
+     */
+    size_t getSegmentCount() const { return segments_.load(); }
+
+    /**
+     * @brief 各段累计消耗的线程CPU时间
+     */
+    std::chrono::nanoseconds getCpuTime() const { return std::chrono::nanoseconds(cpuNs_.load()); }
+
+protected:
+    /**
+     * @brief 推进一段，需要等待时先通过makeResumer()交出恢复句柄再返回Suspend
+     */
+    virtual Step step() = 0;
+
+    /**
+     * @brief 任务未完成就被放弃时调用（排队中超时/取消被丢弃，或无法重新提交）
+     */
+    virtual void onAbandoned() {}
+
+    /**
+     * @brief 创建恢复句柄，只能在step()内调用
+     */
+    Resumer makeResumer() { return Resumer(shared_from_this()); }
+
+private:
+    class Segment;
+
+    enum State : int {
+        kQueued,          ///< 段已提交等待执行
+        kRunning,         ///< 工作线程正在执行step()
+        kResumePending,   ///< 执行期间已被resume()，step()返回后直接继续
+        kSuspended,       ///< 等待resume()
+        kDone
+    };
+
+    /**
+     * @brief 由工作线程执行一段，期间被resume()时连续执行后续段
+     */
+    void runSegments();
+
+    /**
+     * @brief 生成下一段，继承截止时间、取消令牌与优先级
+     */
+    std::unique_ptr<Task> makeSegment();
+
+    /**
+     * @brief 提交下一段，失败时放弃任务
+     */
+    bool submitSegment();
+
+    /**
+     * @brief 结束任务并通知子类
+     */
+    void abandon();
+
+    Submitter submitter_;
+    std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+    CancellationToken token_;
+    TaskPriority priority_ = TaskPriority::Normal;
+    std::atomic<int> state_{kQueued};
+    std::atomic<size_t> segments_{0};
+    std::atomic<uint64_t> cpuNs_{0};
+};
+
+} // namespace yao
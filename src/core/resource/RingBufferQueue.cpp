@@ -0,0 +1,172 @@
+#include "core/resource/RingBufferQueue.h"
+#include <algorithm>
+
+namespace yao {
+
+namespace {
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+RingBufferQueue::RingBufferQueue(size_t capacity)
+    : mask_(roundUpToPowerOfTwo(capacity) - 1)
+    , slots_(new Slot[mask_ + 1])
+    , enqueuePos_(0)
+    , dequeuePos_(0) {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+RingBufferQueue::~RingBufferQueue() = default;
+
+bool RingBufferQueue::enqueue(std::unique_ptr<Task> task) {
+    if (!task) return false;
+
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // 槽位空闲，尝试占用
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // 队列已满
+        } else {
+            // 其他生产者已占用该位置，重新读取
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->task = std::move(task);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+std::unique_ptr<Task> RingBufferQueue::dequeue() {
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            // 槽位已发布，尝试取走
+            if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return nullptr;  // 队列为空
+        } else {
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_ptr<Task> task = std::move(slot->task);
+    // 释放槽位给下一轮的生产者
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return task;
+}
+
+size_t RingBufferQueue::enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) {
+    // 丢弃空任务，保持剩余任务的相对顺序
+    tasks.erase(std::remove(tasks.begin(), tasks.end(), nullptr), tasks.end());
+    if (tasks.empty()) return 0;
+
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    size_t count;
+    while (true) {
+        // 统计从pos开始连续空闲的槽位数
+        count = 0;
+        intptr_t firstDiff = 0;
+        while (count < tasks.size()) {
+            size_t seq = slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + count);
+            if (count == 0) firstDiff = diff;
+            if (diff != 0) break;
+            ++count;
+        }
+
+        if (count == 0) {
+            if (firstDiff < 0) {
+                return 0;  // 队列已满
+            }
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // 一次CAS占用count个槽位
+        if (enqueuePos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        Slot& slot = slots_[(pos + i) & mask_];
+        slot.task = std::move(tasks[i]);
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    tasks.erase(tasks.begin(), tasks.begin() + count);
+    return count;
+}
+
+size_t RingBufferQueue::dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) {
+    if (maxCount == 0) return 0;
+
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    size_t count;
+    while (true) {
+        // 统计从pos开始连续已发布的槽位数
+        count = 0;
+        intptr_t firstDiff = 0;
+        while (count < maxCount) {
+            size_t seq = slots_[(pos + count) & mask_].sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + count + 1);
+            if (count == 0) firstDiff = diff;
+            if (diff != 0) break;
+            ++count;
+        }
+
+        if (count == 0) {
+            if (firstDiff < 0) {
+                return 0;  // 队列为空
+            }
+            pos = dequeuePos_.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (dequeuePos_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        Slot& slot = slots_[(pos + i) & mask_];
+        out.push_back(std::move(slot.task));
+        slot.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+    }
+    return count;
+}
+
+size_t RingBufferQueue::size() const {
+    size_t tail = enqueuePos_.load(std::memory_order_acquire);
+    size_t head = dequeuePos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+bool RingBufferQueue::empty() const {
+    return size() == 0;
+}
+
+} // namespace yao
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include "common/utils/CacheLine.h"
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 定长环形缓冲无锁任务队列
+ * 基于槽位序号（sequence）的有界多生产者多消费者队列：
+ * 槽位在构造时一次性分配，入队/出队只需一次CAS，不产生节点分配；
+ * 队列满时入队返回false，由调用方决定丢弃或重试。
+ */
+class RingBufferQueue : public TaskQueue {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 队列容量，向上取整为2的幂
+     */
+    explicit RingBufferQueue(size_t capacity = 1024);
+    ~RingBufferQueue() override;
+
+    RingBufferQueue(const RingBufferQueue&) = delete;
+    RingBufferQueue& operator=(const RingBufferQueue&) = delete;
+
+    bool enqueue(std::unique_ptr<Task> task) override;
+    std::unique_ptr<Task> dequeue() override;
+
+    /**
+     * @brief 批量入队：一次CAS占用连续的空闲槽位
+     */
+    size_t enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) override;
+
+    /**
+     * @brief 批量出队：一次CAS取走连续的已发布槽位
+     */
+    size_t dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) override;
+    size_t size() const override;
+    bool empty() const override;
+
+    /**
+     * @brief 获取队列容量
+     * @return 实际容量（2的幂）
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<size_t> sequence;
+        std::unique_ptr<Task> task;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(kCacheLineSize) std::atomic<size_t> enqueuePos_;
+    alignas(kCacheLineSize) std::atomic<size_t> dequeuePos_;
+};
+
+} // namespace yao
@@ -0,0 +1,46 @@
+#include "core/resource/TaskBatch.h"
+#include <chrono>
+#include <iostream>
+
+namespace yao {
+
+size_t executeTaskBatch(std::vector<std::unique_ptr<Task>>& batch, AdmissionController& admission,
+                        const TaskBatchMetrics& metrics, const std::string& tenantId) {
+    size_t executed = 0;
+    // 相邻任务共用一次时钟读取：上一个任务的结束时间即下一个任务的开始时间
+    auto start = std::chrono::steady_clock::now();
+    for (auto& task : batch) {
+        if (!task) continue;
+        admission.release(*task);
+        if (!task->isValid()) continue;
+        // 逐个检查而不是整批出队时检查：批内靠后的任务可能在前面任务执行期间过期
+        switch (classifyDequeuedTask(*task, start)) {
+            case TaskDisposition::Expired:
+                metrics.expiredTasks.fetch_add(1);
+                continue;
+            case TaskDisposition::Cancelled:
+                metrics.cancelledTasks.fetch_add(1);
+                continue;
+            case TaskDisposition::Run:
+                break;
+        }
+        if (task->getEnqueueTime() != std::chrono::steady_clock::time_point()) {
+            metrics.queueWaitHistogram.record(start - task->getEnqueueTime());
+        }
+        try {
+            task->execute();
+            ++executed;
+            if (metrics.executedTasks) {
+                metrics.executedTasks->fetch_add(1);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Task execution failed for tenant " << tenantId << ": " << e.what() << std::endl;
+        }
+        auto end = std::chrono::steady_clock::now();
+        metrics.runHistogram.record(end - start);
+        start = end;
+    }
+    return executed;
+}
+
+} // namespace yao
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/resource/AdmissionController.h"
+#include "core/resource/LatencyHistogram.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 一批任务执行时更新的租户计数与直方图
+ * TenantThreadGroup与WeightedFairScheduler各自持有这些统计，执行逻辑共用executeTaskBatch
+ */
+struct TaskBatchMetrics {
+    std::atomic<size_t>& expiredTasks;      ///< 出队时已超时而丢弃的任务数
+    std::atomic<size_t>& cancelledTasks;    ///< 出队时已取消而丢弃的任务数
+    LatencyHistogram& queueWaitHistogram;   ///< 排队等待时间
+    LatencyHistogram& runHistogram;         ///< 执行时间
+    std::atomic<size_t>* executedTasks = nullptr;  ///< 非空时每执行完一个任务立即累加
+};
+
+/**
+ * @brief 在当前线程上执行一批已出队的任务
+ * 逐个扣除排队限额，丢弃无效、过期或已取消的任务，记录排队与执行时间，
+ * 任务抛出的异常只记录日志
+ * @param batch 已出队的任务
+ * @param admission 任务入队时计入的排队限额
+ * @param metrics 需要更新的统计
+ * @param tenantId 租户ID（用于日志）
+ * @return 实际执行的任务数
+ */
+size_t executeTaskBatch(std::vector<std::unique_ptr<Task>>& batch, AdmissionController& admission,
+                        const TaskBatchMetrics& metrics, const std::string& tenantId);
+
+} // namespace yao
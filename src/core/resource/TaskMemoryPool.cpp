@@ -0,0 +1,113 @@
+#include "core/resource/TaskMemoryPool.h"
+#include <new>
+
+namespace yao {
+
+/**
+ * @brief 线程本地的空闲块缓存，线程退出时交还全局列表
+ */
+struct TaskMemoryPool::ThreadCache {
+    std::array<std::vector<void*>, kClassCount> blocks;
+
+    ~ThreadCache() {
+        auto& pool = TaskMemoryPool::getInstance();
+        for (size_t i = 0; i < kClassCount; ++i) {
+            if (!blocks[i].empty()) {
+                pool.releaseBatch(i, std::move(blocks[i]));
+            }
+        }
+    }
+};
+
+TaskMemoryPool& TaskMemoryPool::getInstance() {
+    // 有意不析构：EpochReclaimer等其他单例析构时、以及晚于静态析构退出的
+    // 线程仍可能归还内存块，内存随进程退出一并回收
+    static TaskMemoryPool* instance = new TaskMemoryPool();
+    return *instance;
+}
+
+TaskMemoryPool::ThreadCache& TaskMemoryPool::localCache() {
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+size_t TaskMemoryPool::classIndex(size_t size) {
+    size_t index = 0;
+    size_t blockSize = 64;
+    while (blockSize < size) {
+        blockSize <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+size_t TaskMemoryPool::classSize(size_t index) {
+    return static_cast<size_t>(64) << index;
+}
+
+void* TaskMemoryPool::allocate(size_t size) {
+    if (size > kMaxBlockSize) {
+        return ::operator new(size);
+    }
+
+    size_t index = classIndex(size);
+    std::vector<void*>& local = localCache().blocks[index];
+    if (local.empty() && !fetchBatch(index, local)) {
+        return ::operator new(classSize(index));
+    }
+    void* block = local.back();
+    local.pop_back();
+    return block;
+}
+
+void TaskMemoryPool::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+    if (size > kMaxBlockSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    size_t index = classIndex(size);
+    std::vector<void*>& local = localCache().blocks[index];
+    local.push_back(ptr);
+    if (local.size() >= kMaxLocalBlocks) {
+        // 保留一批在本地，其余整批交还，供分配线程取用
+        std::vector<void*> batch(local.end() - kBatchSize, local.end());
+        local.resize(local.size() - kBatchSize);
+        releaseBatch(index, std::move(batch));
+    }
+}
+
+bool TaskMemoryPool::fetchBatch(size_t index, std::vector<void*>& local) {
+    SizeClass& sizeClass = classes_[index];
+    std::vector<void*> batch;
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.batches.empty()) {
+            return false;
+        }
+        batch = std::move(sizeClass.batches.back());
+        sizeClass.batches.pop_back();
+    }
+    local.insert(local.end(), batch.begin(), batch.end());
+    return true;
+}
+
+void TaskMemoryPool::releaseBatch(size_t index, std::vector<void*> batch) {
+    SizeClass& sizeClass = classes_[index];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.batches.push_back(std::move(batch));
+}
+
+size_t TaskMemoryPool::getGlobalCachedBlocks() const {
+    size_t total = 0;
+    for (const auto& sizeClass : classes_) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        for (const auto& batch : sizeClass.batches) {
+            total += batch.size();
+        }
+    }
+    return total;
+}
+
+} // namespace yao
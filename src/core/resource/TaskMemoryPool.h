@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 任务对象的定长块内存池
+ * 按大小分级（64 ~ 1024字节），每个线程持有各级空闲块的本地缓存，
+ * 分配与释放都不加锁。任务通常在提交线程分配、在工作线程释放，
+ * 本地缓存超过上限时整批交还全局列表，缓存为空时从全局列表整批取回，
+ * 使跨线程的分配/释放在稳定状态下不再调用malloc。
+ */
+class TaskMemoryPool {
+public:
+    /// 池化的最大块大小，更大的请求直接使用operator new
+    static constexpr size_t kMaxBlockSize = 1024;
+
+    /**
+     * @brief 获取单例实例
+     * @return TaskMemoryPool实例
+     */
+    static TaskMemoryPool& getInstance();
+
+    /**
+     * @brief 分配内存
+     * @param size 字节数
+     * @return 至少size字节、按max_align_t对齐的内存
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief 释放allocate()分配的内存
+     * @param ptr 内存地址
+     * @param size 分配时的字节数
+     */
+    void deallocate(void* ptr, size_t size);
+
+    /**
+     * @brief 获取全局列表中缓存的空闲块数量（不含线程本地缓存）
+     */
+    size_t getGlobalCachedBlocks() const;
+
+private:
+    static constexpr size_t kClassCount = 5;       ///< 64, 128, 256, 512, 1024
+    static constexpr size_t kBatchSize = 32;       ///< 线程缓存与全局列表之间每次转移的块数
+    static constexpr size_t kMaxLocalBlocks = 2 * kBatchSize;
+
+    struct ThreadCache;
+
+    struct SizeClass {
+        mutable std::mutex mutex;
+        std::vector<std::vector<void*>> batches;  ///< 整批缓存的空闲块
+    };
+
+    TaskMemoryPool() = default;
+    ~TaskMemoryPool() = default;
+    TaskMemoryPool(const TaskMemoryPool&) = delete;
+    TaskMemoryPool& operator=(const TaskMemoryPool&) = delete;
+
+    static size_t classIndex(size_t size);
+    static size_t classSize(size_t index);
+    static ThreadCache& localCache();
+
+    /**
+     * @brief 从全局列表取一批空闲块
+     * @return 是否取到
+     */
+    bool fetchBatch(size_t index, std::vector<void*>& local);
+
+    /**
+     * @brief 把一批空闲块交还全局列表
+     */
+    void releaseBatch(size_t index, std::vector<void*> batch);
+
+    std::array<SizeClass, kClassCount> classes_;
+};
+
+} // namespace yao
@@ -0,0 +1,27 @@
+#include "core/resource/TaskQueue.h"
+#include "core/resource/LockFreeQueue.h"
+#include "core/resource/RingBufferQueue.h"
+
+namespace yao {
+
+std::unique_ptr<TaskQueue> createTaskQueue(TaskQueueEngine engine, size_t capacity) {
+    switch (engine) {
+        case TaskQueueEngine::RingBuffer:
+            return std::make_unique<RingBufferQueue>(capacity);
+        case TaskQueueEngine::Linked:
+        default:
+            return std::make_unique<LockFreeQueue>(capacity);
+    }
+}
+
+TaskQueueEngine parseTaskQueueEngine(const std::string& name, TaskQueueEngine defaultEngine) {
+    if (name == "ring" || name == "ring_buffer") {
+        return TaskQueueEngine::RingBuffer;
+    }
+    if (name == "linked" || name == "lockfree") {
+        return TaskQueueEngine::Linked;
+    }
+    return defaultEngine;
+}
+
+} // namespace yao
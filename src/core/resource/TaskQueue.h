@@ -0,0 +1,219 @@
+#pragma once
+
+#include "core/resource/CancellationToken.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 任务优先级（开启优先级通道时决定任务进入的通道）
+ */
+enum class TaskPriority {
+    High = 0,    ///< 交互型短任务，如点查询
+    Normal = 1,  ///< 默认优先级
+    Low = 2      ///< 后台或分析型长任务
+};
+
+/// 优先级通道数量
+constexpr size_t kTaskPriorityCount = 3;
+
+class AdmissionController;
+
+/**
+ * @brief 任务接口
+ */
+class Task {
+public:
+    virtual ~Task() = default;
+    virtual void execute() = 0;
+    virtual bool isValid() const = 0;
+
+    /**
+     * @brief 任务在队列中占用的内存（字节），用于租户排队字节数限制
+     * 持有较大负载（如SQL文本、参数）的任务应覆盖此方法
+     */
+    virtual size_t getQueuedBytes() const { return sizeof(Task); }
+
+    /**
+     * @brief 获取任务优先级
+     */
+    TaskPriority getPriority() const { return priority_; }
+
+    /**
+     * @brief 设置任务优先级，需在提交前设置
+     */
+    void setPriority(TaskPriority priority) { priority_ = priority; }
+
+    /**
+     * @brief 设置截止时间，超过后尚未开始执行的任务在出队时被丢弃，需在提交前设置
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+    /**
+     * @brief 获取截止时间，未设置时为time_point::max()
+     */
+    std::chrono::steady_clock::time_point getDeadline() const { return deadline_; }
+
+    /**
+     * @brief 是否设置了截止时间
+     */
+    bool hasDeadline() const { return deadline_ != std::chrono::steady_clock::time_point::max(); }
+
+    /**
+     * @brief 设置取消令牌，需在提交前设置
+     */
+    void setCancellationToken(CancellationToken token) { token_ = std::move(token); }
+
+    /**
+     * @brief 获取取消令牌
+     */
+    const CancellationToken& getCancellationToken() const { return token_; }
+
+    /**
+     * @brief 任务是否已被取消
+     */
+    bool isCancelled() const { return token_.isCancelled(); }
+
+    /**
+     * @brief 任务在now时刻是否已超过截止时间
+     */
+    bool isExpired(std::chrono::steady_clock::time_point now) const { return now >= deadline_; }
+
+    /**
+     * @brief 记录进入租户队列的时间，用于统计排队等待时长（由线程组在提交时调用）
+     */
+    void markEnqueued(std::chrono::steady_clock::time_point now) { enqueueTime_ = now; }
+
+    /**
+     * @brief 获取进入租户队列的时间，未经线程组提交时为time_point()
+     */
+    std::chrono::steady_clock::time_point getEnqueueTime() const { return enqueueTime_; }
+
+    /**
+     * @brief 供执行中的长任务协作式检查：已取消或已超时时应尽快返回
+     */
+    bool shouldStop() const {
+        return isCancelled() || (hasDeadline() && isExpired(std::chrono::steady_clock::now()));
+    }
+
+private:
+    friend class AdmissionController;
+
+    TaskPriority priority_ = TaskPriority::Normal;
+    size_t admittedBytes_ = 0;   ///< 准入时计入的字节数，由AdmissionController维护
+    bool admitted_ = false;      ///< 是否已计入排队限额
+    std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+    std::chrono::steady_clock::time_point enqueueTime_;
+    CancellationToken token_;
+};
+
+/**
+ * @brief 任务出队后的处置
+ */
+enum class TaskDisposition {
+    Run,        ///< 正常执行
+    Expired,    ///< 已超过截止时间，丢弃
+    Cancelled   ///< 已被取消，丢弃
+};
+
+/**
+ * @brief 判断出队任务在now时刻是否仍需执行
+ */
+inline TaskDisposition classifyDequeuedTask(const Task& task, std::chrono::steady_clock::time_point now) {
+    if (task.isCancelled()) {
+        return TaskDisposition::Cancelled;
+    }
+    if (task.isExpired(now)) {
+        return TaskDisposition::Expired;
+    }
+    return TaskDisposition::Run;
+}
+
+/**
+ * @brief 判断出队任务是否仍需执行，未设置截止时间的任务不读取时钟
+ */
+inline TaskDisposition classifyDequeuedTask(const Task& task) {
+    if (!task.hasDeadline()) {
+        return task.isCancelled() ? TaskDisposition::Cancelled : TaskDisposition::Run;
+    }
+    return classifyDequeuedTask(task, std::chrono::steady_clock::now());
+}
+
+/**
+ * @brief 任务队列引擎类型
+ */
+enum class TaskQueueEngine {
+    Linked,      ///< 链表节点队列（LockFreeQueue），每个任务分配一个节点，容量不受限
+    RingBuffer   ///< 定长环形缓冲队列（RingBufferQueue），无节点分配，容量有界
+};
+
+/**
+ * @brief 租户任务队列接口
+ * 多生产者多消费者队列的统一抽象，供TenantThreadGroup选择不同实现
+ */
+class TaskQueue {
+public:
+    virtual ~TaskQueue() = default;
+
+    /**
+     * @brief 入队操作
+     * @param task 任务指针
+     * @return 是否成功（有界队列已满时返回false）
+     */
+    virtual bool enqueue(std::unique_ptr<Task> task) = 0;
+
+    /**
+     * @brief 出队操作
+     * @return 任务指针，如果队列为空返回nullptr
+     */
+    virtual std::unique_ptr<Task> dequeue() = 0;
+
+    /**
+     * @brief 批量入队，整批任务通过一次原子操作发布
+     * @param tasks 待入队任务，成功入队的任务从头部移出，空任务被丢弃；
+     *              有界队列空间不足时未入队的任务保留在tasks中
+     * @return 成功入队的任务数量
+     */
+    virtual size_t enqueueBulk(std::vector<std::unique_ptr<Task>>& tasks) = 0;
+
+    /**
+     * @brief 批量出队，一次原子操作取走多个任务
+     * @param out 输出，出队任务按顺序追加到末尾
+     * @param maxCount 最多出队数量
+     * @return 实际出队数量
+     */
+    virtual size_t dequeueBulk(std::vector<std::unique_ptr<Task>>& out, size_t maxCount) = 0;
+
+    /**
+     * @brief 获取队列大小
+     * @return 当前队列中的任务数量
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief 检查队列是否为空
+     * @return 是否为空
+     */
+    virtual bool empty() const = 0;
+};
+
+/**
+ * @brief 创建任务队列
+ * @param engine 队列引擎
+ * @param capacity 队列容量
+ * @return 任务队列
+ */
+std::unique_ptr<TaskQueue> createTaskQueue(TaskQueueEngine engine, size_t capacity);
+
+/**
+ * @brief 解析队列引擎名称（"linked" / "ring"）
+ * @param name 引擎名称
+ * @param defaultEngine 无法识别时使用的默认引擎
+ * @return 队列引擎
+ */
+TaskQueueEngine parseTaskQueueEngine(const std::string& name, TaskQueueEngine defaultEngine = TaskQueueEngine::Linked);
+
+} // namespace yao
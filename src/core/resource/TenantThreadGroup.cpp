@@ -1,50 +1,170 @@
 #include "core/resource/TenantThreadGroup.h"
+#include "core/resource/ThreadBorrowBroker.h"
 #include "core/resource/CgroupController.h"
+#include "core/resource/EpochReclaimer.h"
+#include "core/resource/TaskBatch.h"
+#include "core/resource/ThreadCpuClock.h"
+#include "common/config/ConfigManager.h"
 #include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <chrono>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace yao {
 
+namespace {
+
+/// 当前线程所属的WorkerThread，非工作线程为nullptr
+thread_local WorkerThread* currentWorker = nullptr;
+
+} // namespace
+
+ThreadGroupOptions ThreadGroupOptions::fromConfig(const ConfigManager& config) {
+    ThreadGroupOptions options;
+    std::string mode = config.getString("thread_scheduling_mode", "dedicated");
+    if (mode == "shared") {
+        options.schedulingMode = SchedulingMode::Shared;
+    } else if (mode != "dedicated") {
+        std::cerr << "Unknown thread_scheduling_mode '" << mode << "', using dedicated" << std::endl;
+    }
+    options.queueEngine = parseTaskQueueEngine(config.getString("task_queue_engine", "linked"), options.queueEngine);
+    int capacity = config.getInt("task_queue_capacity", static_cast<int>(options.queueCapacity));
+    if (capacity > 0) {
+        options.queueCapacity = static_cast<size_t>(capacity);
+    }
+    int batch = config.getInt("task_dequeue_batch", static_cast<int>(options.dequeueBatchSize));
+    if (batch > 0) {
+        options.dequeueBatchSize = static_cast<size_t>(batch);
+    }
+    int spinUs = config.getInt("worker_idle_spin_us", static_cast<int>(options.idleSpin.count()));
+    if (spinUs >= 0) {
+        options.idleSpin = std::chrono::microseconds(spinUs);
+    }
+    options.enableBorrowing = config.getBool("thread_borrowing", options.enableBorrowing);
+    int burst = config.getInt("thread_borrow_burst_percent", static_cast<int>(options.borrowBurstPercent));
+    if (burst >= 0) {
+        options.borrowBurstPercent = static_cast<size_t>(burst);
+    }
+    options.priorityLanes = config.getBool("task_priority_lanes", options.priorityLanes);
+    options.lanePolicy = parseLanePolicy(config.getString("task_lane_policy", "weighted"), options.lanePolicy);
+    std::string weights = config.getString("task_lane_weights", "");
+    if (!weights.empty()) {
+        std::istringstream stream(weights);
+        std::string item;
+        for (size_t lane = 0; lane < kTaskPriorityCount && std::getline(stream, item, ','); ++lane) {
+            try {
+                options.laneWeights[lane] = static_cast<uint32_t>(std::max(std::stoi(item), 1));
+            } catch (const std::exception&) {
+                std::cerr << "Invalid task_lane_weights entry '" << item << "'" << std::endl;
+            }
+        }
+    }
+    options.threadAffinity = config.getBool("thread_affinity", options.threadAffinity);
+    options.autoscale = AutoscalePolicy::fromConfig(config);
+    int localCapacity = config.getInt("worker_local_queue_capacity", static_cast<int>(options.localQueueCapacity));
+    if (localCapacity >= 0) {
+        options.localQueueCapacity = static_cast<size_t>(localCapacity);
+    }
+    int maxTasks = config.getInt("tenant_max_queued_tasks", static_cast<int>(options.maxQueuedTasks));
+    if (maxTasks >= 0) {
+        options.maxQueuedTasks = static_cast<size_t>(maxTasks);
+    }
+    int maxKb = config.getInt("tenant_max_queued_kb", static_cast<int>(options.maxQueuedBytes / 1024));
+    if (maxKb >= 0) {
+        options.maxQueuedBytes = static_cast<size_t>(maxKb) * 1024;
+    }
+    return options;
+}
+
+std::unique_ptr<TaskQueue> ThreadGroupOptions::makeTaskQueue() const {
+    if (priorityLanes) {
+        return std::make_unique<PriorityTaskQueue>(queueEngine, queueCapacity, lanePolicy, laneWeights);
+    }
+    return createTaskQueue(queueEngine, queueCapacity);
+}
+
+AdmissionController::Limits ThreadGroupOptions::admissionLimits() const {
+    AdmissionController::Limits limits;
+    limits.maxQueuedTasks = maxQueuedTasks;
+    limits.maxQueuedBytes = maxQueuedBytes;
+    return limits;
+}
+
 // WorkerThread implementation
-WorkerThread::WorkerThread(const std::string& tenantId, LockFreeQueue& queue, CgroupController* cgroup)
-    : tenantId_(tenantId), taskQueue_(queue), cgroup_(cgroup), running_(false), busy_(false), executedTasks_(0) {
+WorkerThread::WorkerThread(TenantThreadGroup& group, CgroupController* cgroup, size_t localQueueCapacity)
+    : group_(group), tenantId_(group.getTenantId()), cgroup_(cgroup)
+    , running_(false), busy_(false), executedTasks_(0) {
+    if (localQueueCapacity > 0) {
+        localQueue_ = std::make_unique<WorkStealingDeque>(localQueueCapacity);
+    }
 }
 
 WorkerThread::~WorkerThread() {
     stop();
 }
 
-void WorkerThread::start() {
+void WorkerThread::start(std::shared_ptr<CgroupAttachBatch> attach) {
     if (running_) return;
 
     running_ = true;
+    // 线程自己登记内核TID后加入cgroup，父线程此时拿不到新线程的TID
+    attach_ = std::move(attach);
     thread_ = std::make_unique<std::thread>(&WorkerThread::run, this);
 
-    // Add thread to cgroup if available
-    if (cgroup_) {
-        cgroup_->addThread(tenantId_, getId());
+    CpuPlacement placement = group_.getCpuPlacement();
+    if (!placement.cpus.empty()) {
+        setAffinity(placement.cpus);
     }
 }
 
 void WorkerThread::stop() {
-    if (!running_) return;
+    if (!thread_ || !thread_->joinable()) return;
 
-    running_ = false;
-    if (thread_ && thread_->joinable()) {
-        thread_->join();
-    }
+    requestStop();
+    thread_->join();
 
     // Remove thread from cgroup
-    if (cgroup_) {
-        cgroup_->removeThread(tenantId_, getId());
+    if (cgroup_ && tid_.load() != 0) {
+        cgroup_->removeThread(tenantId_, tid_.load());
     }
 }
 
+void WorkerThread::requestStop(std::shared_ptr<ResizeTracker> tracker) {
+    if (tracker) {
+        retireTracker_ = std::move(tracker);
+    }
+    running_ = false;
+    // 同组其他线程共用同一个wakeup_，被唤醒后发现自己仍在运行会重新休眠
+    group_.wakeup_.notifyAll();
+}
+
+bool WorkerThread::hasExited() const {
+    return !thread_ || exited_.load();
+}
+
 std::thread::id WorkerThread::getId() const {
     return thread_ ? thread_->get_id() : std::thread::id();
 }
 
+pid_t WorkerThread::getNativeTid() const {
+    return tid_.load();
+}
+
+uint64_t WorkerThread::getCpuTimeNs() const {
+#ifdef __linux__
+    // 时钟编码了线程ID，线程退出后clock_gettime返回错误而不会访问已释放的资源
+    struct timespec ts;
+    if (cpuClockReady_.load(std::memory_order_acquire) && clock_gettime(cpuClock_, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+#endif
+    return 0;
+}
+
 bool WorkerThread::isBusy() const {
     return busy_.load();
 }
@@ -53,41 +173,230 @@ size_t WorkerThread::getExecutedTasks() const {
     return executedTasks_.load();
 }
 
+size_t WorkerThread::getLocalQueueSize() const {
+    return localQueue_ ? localQueue_->size() : 0;
+}
+
+bool WorkerThread::setAffinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (!thread_) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpus.empty()) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &set);
+        }
+    } else {
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+    }
+    int rc = pthread_setaffinity_np(thread_->native_handle(), sizeof(set), &set);
+    if (rc != 0) {
+        std::cerr << "Failed to set CPU affinity for tenant " << tenantId_ << " worker: error " << rc << std::endl;
+        return false;
+    }
+    return true;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool WorkerThread::pushLocal(std::unique_ptr<Task>& task) {
+    if (!localQueue_) return false;
+
+    if (lifoSlot_) {
+        if (!localQueue_->push(lifoSlot_)) {
+            return false;
+        }
+        // 槽中原有任务变为可窃取，叫醒一个休眠的同组线程
+        group_.wakeup_.notify();
+    }
+    lifoSlot_ = std::move(task);
+    return true;
+}
+
+std::unique_ptr<Task> WorkerThread::takeLocal() {
+    if (lifoSlot_) {
+        return std::move(lifoSlot_);
+    }
+    return localQueue_ ? localQueue_->pop() : nullptr;
+}
+
+void WorkerThread::drainLocalTasks() {
+    std::vector<std::unique_ptr<Task>> pending;
+    for (;;) {
+        while (auto task = takeLocal()) {
+            pending.push_back(std::move(task));
+        }
+        if (pending.empty()) {
+            return;
+        }
+        size_t handed = group_.taskQueue_->enqueueBulk(pending);
+        if (handed > 0) {
+            group_.wakeup_.notifyAll();
+        }
+        if (pending.empty()) {
+            return;
+        }
+        // 共享队列已满时就地执行剩余任务：丢弃可挂起任务的续体会让请求永远得不到响应。
+        // 执行期间派生的任务进入本地队列，由下一轮继续转交
+        setBusy(true);
+        executedTasks_.fetch_add(group_.executeBatch(pending));
+        setBusy(false);
+        pending.clear();
+    }
+}
+
+void WorkerThread::runTask(std::unique_ptr<Task> task, std::vector<std::unique_ptr<Task>>& batch) {
+    batch.clear();
+    batch.push_back(std::move(task));
+    setBusy(true);
+    executedTasks_.fetch_add(group_.executeBatch(batch));
+    setBusy(false);
+}
+
 void WorkerThread::run() {
-    while (running_) {
-        auto task = taskQueue_.dequeue();
-        if (task && task->isValid()) {
-            busy_ = true;
-            try {
-                task->execute();
-                executedTasks_.fetch_add(1);
-            } catch (const std::exception& e) {
-                std::cerr << "Task execution failed for tenant " << tenantId_ << ": " << e.what() << std::endl;
+    std::vector<std::unique_ptr<Task>> batch;
+    batch.reserve(group_.dequeueBatchSize_);
+    currentWorker = this;
+    tid_.store(currentThreadTid());
+#ifdef __linux__
+    if (pthread_getcpuclockid(pthread_self(), &cpuClock_) == 0) {
+        cpuClockReady_.store(true, std::memory_order_release);
+    }
+#endif
+    if (attach_) {
+        attach_->arrive(tid_.load());
+        attach_.reset();
+    }
+
+    for (unsigned tick = 1; running_; ++tick) {
+        // 优先执行本线程派生的任务，定期让位给共享队列
+        if (tick % kSharedQueueInterval != 0) {
+            if (auto task = takeLocal()) {
+                runTask(std::move(task), batch);
+                continue;
             }
-            busy_ = false;
-        } else {
-            // Sleep briefly to avoid busy waiting
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
+
+        // 每次唤醒取走一小批任务，摊薄出队的同步开销
+        batch.clear();
+        if (group_.taskQueue_->dequeueBulk(batch, group_.dequeueBatchSize_) > 0) {
+            // 提交方入队时本组线程可能尚未被调度起来（仍计为休眠），
+            // 取走任务后仍有积压说明已饱和，由工作线程补发借用请求
+            if (!group_.taskQueue_->empty()) {
+                group_.requestBorrowIfSaturated();
+            }
+            setBusy(true);
+            executedTasks_.fetch_add(group_.executeBatch(batch));
+            setBusy(false);
+            continue;
+        }
+
+        if (auto task = takeLocal()) {
+            runTask(std::move(task), batch);
+            continue;
+        }
+        if (auto task = group_.stealTask(*this)) {
+            runTask(std::move(task), batch);
+            continue;
+        }
+
+        // 本组没有积压时，把线程借给其他有积压的租户；借出期间不计入本组忙碌线程，
+        // 否则只借出线程的组会被自动伸缩当作高负载而扩容
+        ThreadBorrowBroker* broker = group_.broker_.load();
+        if (broker && broker->runBorrowedBatch(group_, batch)) {
+            continue;
+        }
+
+        waitForWork();
+    }
+
+    // 残留的本地任务转回共享队列后再报告退出
+    drainLocalTasks();
+    currentWorker = nullptr;
+#ifdef __linux__
+    // 线程退出后其CPU时钟失效，把被移除时尚未转交的CPU时间转交线程组
+    {
+        std::lock_guard<std::mutex> lock(group_.cpuMutex_);
+        if (cpuClockReady_.exchange(false)) {
+            uint64_t used = threadCpuTimeNs();
+            uint64_t handedOver = handedOverCpuNs_.load();
+            group_.exitedCpuNs_.fetch_add(used > handedOver ? used - handedOver : 0);
+        }
+    }
+#endif
+    exited_ = true;
+    if (retireTracker_) {
+        retireTracker_->arrive();
     }
 }
 
+void WorkerThread::setBusy(bool busy) {
+    busy_.store(busy);
+    if (busy) {
+        group_.busyWorkers_.fetch_add(1);
+    } else {
+        group_.busyWorkers_.fetch_sub(1);
+    }
+}
+
+void WorkerThread::waitForWork() {
+    TaskQueue& queue = *group_.taskQueue_;
+
+    // 短暂自旋，接住紧随其后的任务，避免一次休眠/唤醒的系统调用
+    if (group_.idleSpin_.count() > 0) {
+        auto deadline = std::chrono::steady_clock::now() + group_.idleSpin_;
+        for (unsigned spins = 0; running_; ++spins) {
+            if (!queue.empty() || group_.hasStealableTasks()) return;
+            cpuRelax();
+            if ((spins & 63) == 63 && std::chrono::steady_clock::now() >= deadline) break;
+        }
+    }
+
+    // 先登记再检查队列，保证与submitTask/pushLocal中的notify不会错过
+    EventCount::Key key = group_.wakeup_.prepareWait();
+    if (!running_ || !queue.empty() || group_.hasStealableTasks()) {
+        group_.wakeup_.cancelWait();
+        return;
+    }
+    group_.parkedWorkers_.fetch_add(1);
+    group_.wakeup_.wait(key);
+    group_.parkedWorkers_.fetch_sub(1);
+}
+
 // TenantThreadGroup implementation
-TenantThreadGroup::TenantThreadGroup(const std::string& tenantId, size_t threadCount, CgroupController* cgroup)
-    : tenantId_(tenantId), cgroup_(cgroup), running_(false) {
+TenantThreadGroup::TenantThreadGroup(const std::string& tenantId, size_t threadCount, CgroupController* cgroup,
+                                     const ThreadGroupOptions& options)
+    : tenantId_(tenantId)
+    , taskQueue_(options.makeTaskQueue())
+    , admission_(options.admissionLimits())
+    , cgroup_(cgroup)
+    , dequeueBatchSize_(options.dequeueBatchSize)
+    , idleSpin_(options.idleSpin)
+    , localQueueCapacity_(options.localQueueCapacity)
+    , running_(false)
+    , borrowBurstPercent_(options.borrowBurstPercent) {
     resize(threadCount);
 }
 
 TenantThreadGroup::~TenantThreadGroup() {
     stop();
+    delete workers_.load();
 }
 
 bool TenantThreadGroup::start() {
     if (running_) return true;
 
     running_ = true;
+    auto attach = makeAttachBatch(threads_.size());
     for (auto& worker : threads_) {
-        worker->start();
+        worker->start(attach);
     }
     return true;
 }
@@ -99,51 +408,284 @@ void TenantThreadGroup::stop() {
     for (auto& worker : threads_) {
         worker->stop();
     }
+    reapRetiredWorkers(true);
+}
+
+SubmitResult TenantThreadGroup::submitTask(std::unique_ptr<Task> task, TaskPriority priority) {
+    if (!task) return SubmitResult::noTenant();
+    task->setPriority(priority);
+    return submitTask(std::move(task));
+}
+
+SubmitResult TenantThreadGroup::submitTask(std::unique_ptr<Task> task) {
+    if (task) {
+        task->markEnqueued(std::chrono::steady_clock::now());
+    }
+    SubmitResult result = admission_.submit(*taskQueue_, std::move(task));
+    if (!result) {
+        return result;
+    }
+    wakeup_.notify();
+    requestBorrowIfSaturated();
+    return result;
+}
+
+size_t TenantThreadGroup::submitTasks(std::vector<std::unique_ptr<Task>>& tasks, SubmitResult* rejection) {
+    auto now = std::chrono::steady_clock::now();
+    for (auto& task : tasks) {
+        if (task) task->markEnqueued(now);
+    }
+    size_t submitted = admission_.submitBulk(*taskQueue_, tasks, rejection);
+    if (submitted == 1) {
+        wakeup_.notify();
+    } else if (submitted > 1) {
+        wakeup_.notifyAll();
+    }
+    if (submitted > 0) {
+        requestBorrowIfSaturated();
+    }
+    return submitted;
+}
+
+bool TenantThreadGroup::spawnTask(std::unique_ptr<Task> task) {
+    if (!task) return false;
+    task->markEnqueued(std::chrono::steady_clock::now());
+
+    WorkerThread* worker = currentWorker;
+    if (worker && &worker->group_ == this && worker->pushLocal(task)) {
+        return true;
+    }
+    if (!admission_.submitCharged(*taskQueue_, std::move(task))) {
+        return false;
+    }
+    wakeup_.notify();
+    requestBorrowIfSaturated();
+    return true;
+}
+
+std::unique_ptr<Task> TenantThreadGroup::stealTask(WorkerThread& thief) {
+    EpochReclaimer::Guard guard;
+    const auto* workers = workers_.load(std::memory_order_acquire);
+    if (!workers || workers->empty()) {
+        return nullptr;
+    }
+
+    // 每个窃取者从各自的游标开始轮询，避免所有线程挤在同一个目标上
+    size_t count = workers->size();
+    for (size_t i = 0; i < count; ++i) {
+        WorkerThread* victim = (*workers)[(thief.stealCursor_ + i) % count];
+        if (victim == &thief || !victim->localQueue_) continue;
+        if (auto task = victim->localQueue_->steal()) {
+            thief.stealCursor_ = (thief.stealCursor_ + i) % count;
+            return task;
+        }
+    }
+    thief.stealCursor_ = (thief.stealCursor_ + 1) % count;
+    return nullptr;
+}
+
+bool TenantThreadGroup::hasStealableTasks() const {
+    EpochReclaimer::Guard guard;
+    const auto* workers = workers_.load(std::memory_order_acquire);
+    if (!workers) return false;
+    for (const WorkerThread* worker : *workers) {
+        if (worker->getLocalQueueSize() > 0) return true;
+    }
+    return false;
+}
+
+void TenantThreadGroup::publishWorkers() {
+    auto* next = new std::vector<WorkerThread*>();
+    next->reserve(threads_.size());
+    for (auto& worker : threads_) {
+        next->push_back(worker.get());
+    }
+
+    const auto* previous = workers_.exchange(next, std::memory_order_acq_rel);
+    if (previous) {
+        EpochReclaimer::getInstance().retire(const_cast<std::vector<WorkerThread*>*>(previous));
+    }
+}
+
+void TenantThreadGroup::reapRetiredWorkers(bool waitForExit) {
+    auto it = retiring_.begin();
+    while (it != retiring_.end()) {
+        if (!waitForExit && !(*it)->hasExited()) {
+            ++it;
+            continue;
+        }
+        (*it)->stop();
+        EpochReclaimer::getInstance().retire((*it).release());
+        it = retiring_.erase(it);
+    }
+}
+
+bool TenantThreadGroup::setCpuPlacement(const CpuPlacement& placement) {
+    {
+        std::lock_guard<std::mutex> lock(placementMutex_);
+        placement_ = placement;
+    }
+
+    bool ok = true;
+    if (running_) {
+        for (auto& worker : threads_) {
+            ok = worker->setAffinity(placement.cpus) && ok;
+        }
+    }
+    return ok;
+}
+
+CpuPlacement TenantThreadGroup::getCpuPlacement() const {
+    std::lock_guard<std::mutex> lock(placementMutex_);
+    return placement_;
+}
+
+void TenantThreadGroup::requestBorrowIfSaturated() {
+    // 本组还有休眠线程可用，或借用已达上限时不打扰其他租户
+    ThreadBorrowBroker* broker = broker_.load();
+    if (!broker || parkedWorkers_.load() > 0 ||
+        borrowedWorkers_.load() >= borrowCeiling_.load()) {
+        return;
+    }
+    broker->requestHelp(*this);
+}
+
+size_t TenantThreadGroup::executeBatch(std::vector<std::unique_ptr<Task>>& batch) {
+    // 本组的CPU时间由各工作线程的时钟累计，这里不按批记账
+    return executeTaskBatch(batch, admission_,
+                            TaskBatchMetrics{expiredTasks_, cancelledTasks_, queueWaitHistogram_, runHistogram_},
+                            tenantId_);
+}
+
+void TenantThreadGroup::setBorrowBroker(ThreadBorrowBroker* broker) {
+    broker_.store(broker);
+}
+
+const std::string& TenantThreadGroup::getTenantId() const {
+    return tenantId_;
+}
+
+uint64_t TenantThreadGroup::getCpuTimeNs() const {
+    uint64_t total;
+    {
+        std::lock_guard<std::mutex> lock(cpuMutex_);
+        total = exitedCpuNs_.load();
+        EpochReclaimer::Guard guard;
+        const auto* workers = workers_.load(std::memory_order_acquire);
+        if (workers) {
+            for (const WorkerThread* worker : *workers) {
+                total += worker->getCpuTimeNs();
+            }
+        }
+    }
+    // 借出的时间已计入本组线程，借入的时间计入了其他租户的线程
+    uint64_t lent = lentCpuNs_.load();
+    total = total > lent ? total - lent : 0;
+    return total + borrowedCpuNs_.load();
+}
+
+double TenantThreadGroup::getLentCpuSeconds() const {
+    return lentCpuNs_.load() / 1e9;
 }
 
-bool TenantThreadGroup::submitTask(std::unique_ptr<Task> task) {
-    return taskQueue_.enqueue(std::move(task));
+double TenantThreadGroup::getBorrowedCpuSeconds() const {
+    return borrowedCpuNs_.load() / 1e9;
+}
+
+size_t TenantThreadGroup::getQueuedBytes() const {
+    return admission_.getQueuedBytes();
+}
+
+size_t TenantThreadGroup::getRejectedTasks() const {
+    return admission_.getRejectedTasks();
+}
+
+LatencySummary TenantThreadGroup::getQueueWaitLatency() const {
+    return queueWaitHistogram_.summarize();
+}
+
+LatencySummary TenantThreadGroup::getRunLatency() const {
+    return runHistogram_.summarize();
+}
+
+size_t TenantThreadGroup::getExpiredTasks() const {
+    return expiredTasks_.load();
+}
+
+size_t TenantThreadGroup::getCancelledTasks() const {
+    return cancelledTasks_.load();
 }
 
 size_t TenantThreadGroup::getQueueSize() const {
-    return taskQueue_.size();
+    size_t size = taskQueue_->size();
+    EpochReclaimer::Guard guard;
+    if (const auto* workers = workers_.load(std::memory_order_acquire)) {
+        for (const WorkerThread* worker : *workers) {
+            size += worker->getLocalQueueSize();
+        }
+    }
+    return size;
 }
 
 size_t TenantThreadGroup::getBusyThreads() const {
-    return std::count_if(threads_.begin(), threads_.end(),
-                        [](const std::unique_ptr<WorkerThread>& worker) {
-                            return worker->isBusy();
-                        });
+    return busyWorkers_.load();
 }
 
 size_t TenantThreadGroup::getTotalThreads() const {
-    return threads_.size();
+    return threadCount_.load();
+}
+
+std::shared_ptr<CgroupAttachBatch> TenantThreadGroup::makeAttachBatch(size_t workers) const {
+    if (!cgroup_ || workers == 0) {
+        return nullptr;
+    }
+    return std::make_shared<CgroupAttachBatch>(*cgroup_, tenantId_, workers);
 }
 
-bool TenantThreadGroup::resize(size_t newThreadCount) {
-    if (newThreadCount == threads_.size()) return true;
+ResizeHandle TenantThreadGroup::resize(size_t newThreadCount) {
+    reapRetiredWorkers(false);
+    ResizeHandle handle = ResizeHandle::completed();
 
     if (newThreadCount > threads_.size()) {
         // Add threads
         size_t toAdd = newThreadCount - threads_.size();
         for (size_t i = 0; i < toAdd; ++i) {
-            threads_.emplace_back(std::make_unique<WorkerThread>(tenantId_, taskQueue_, cgroup_));
+            threads_.emplace_back(std::make_unique<WorkerThread>(*this, cgroup_, localQueueCapacity_));
         }
+        publishWorkers();
         if (running_) {
+            auto attach = makeAttachBatch(toAdd);
             for (size_t i = threads_.size() - toAdd; i < threads_.size(); ++i) {
-                threads_[i]->start();
+                threads_[i]->start(attach);
             }
         }
-    } else {
-        // Remove threads
+    } else if (newThreadCount < threads_.size()) {
+        // 先从窃取列表中摘除，再通知线程执行完当前任务后自行退出
         size_t toRemove = threads_.size() - newThreadCount;
-        for (size_t i = 0; i < toRemove; ++i) {
-            threads_.back()->stop();
-            threads_.pop_back();
+        auto tracker = std::make_shared<ResizeTracker>(running_ ? toRemove : 0);
+        for (size_t i = newThreadCount; i < threads_.size(); ++i) {
+            retiring_.push_back(std::move(threads_[i]));
+        }
+        threads_.resize(newThreadCount);
+        {
+            // 摘除前把已用的CPU时间转入exitedCpuNs_，退出前的余量在线程退出时补交
+            std::lock_guard<std::mutex> lock(cpuMutex_);
+            for (size_t i = retiring_.size() - toRemove; i < retiring_.size(); ++i) {
+                uint64_t used = retiring_[i]->getCpuTimeNs();
+                retiring_[i]->handedOverCpuNs_.store(used);
+                exitedCpuNs_.fetch_add(used);
+            }
+            publishWorkers();
         }
+        for (size_t i = retiring_.size() - toRemove; i < retiring_.size(); ++i) {
+            retiring_[i]->requestStop(running_ ? tracker : nullptr);
+        }
+        handle = ResizeHandle::pending(std::move(tracker));
     }
 
-    return true;
+    threadCount_.store(newThreadCount);
+    borrowCeiling_.store(newThreadCount * borrowBurstPercent_ / 100);
+    return handle;
 }
 
 } // namespace yao
\ No newline at end of file
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "core/resource/AdmissionController.h"
 #include "core/resource/LockFreeQueue.h"
+#include "core/resource/PriorityTaskQueue.h"
+#include "core/resource/EventCount.h"
+#include "core/resource/LatencyHistogram.h"
+#include "core/resource/WorkStealingDeque.h"
+#include "core/resource/ResizeHandle.h"
+#include "core/resource/ThreadAutoscaler.h"
 #include <string>
 #include <vector>
 #include <thread>
@@ -8,34 +15,128 @@
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <mutex>
+#include <sys/types.h>
 
 namespace yao {
 
 class CgroupController;
+class CgroupAttachBatch;
+class ConfigManager;
+class TenantThreadGroup;
+class ThreadBorrowBroker;
+
+/**
+ * @brief 租户线程调度方式
+ */
+enum class SchedulingMode {
+    Dedicated,   ///< 每个租户独占一组工作线程（TenantThreadGroup）
+    Shared       ///< 所有租户共享一组工作线程，按CPU配额加权公平调度（WeightedFairScheduler）
+};
+
+/**
+ * @brief 租户线程组配置
+ */
+struct ThreadGroupOptions {
+    SchedulingMode schedulingMode = SchedulingMode::Dedicated;  ///< 调度方式
+    TaskQueueEngine queueEngine = TaskQueueEngine::Linked;  ///< 任务队列引擎
+    size_t queueCapacity = 1024;                            ///< 任务队列容量
+    size_t dequeueBatchSize = 4;                            ///< 工作线程每次唤醒最多取走的任务数
+    std::chrono::microseconds idleSpin{50};                 ///< 队列为空时先自旋等待的时长，超过后休眠
+    bool enableBorrowing = false;                           ///< 空闲线程是否可借给有积压的其他租户（仅Dedicated模式）
+    size_t borrowBurstPercent = 50;                         ///< 租户最多同时借用自身线程数的百分比
+    bool priorityLanes = false;                             ///< 是否按任务优先级分通道排队
+    LanePolicy lanePolicy = LanePolicy::Weighted;           ///< 通道出队策略
+    PriorityTaskQueue::LaneWeights laneWeights{16, 4, 1};   ///< 通道权重（High, Normal, Low）
+    size_t localQueueCapacity = 256;                        ///< 工作线程本地队列容量，0表示不使用本地队列
+    bool threadAffinity = false;                            ///< 是否按NUMA/缓存拓扑绑定租户线程（仅Dedicated模式）
+    AutoscalePolicy autoscale;                              ///< 线程数自动伸缩策略（见AutoscalePolicy::fromConfig）
+    size_t maxQueuedTasks = 0;                              ///< 每个租户最多排队的任务数，0表示不限制
+    size_t maxQueuedBytes = 0;                              ///< 每个租户排队任务最多占用的字节数，0表示不限制
+
+    /**
+     * @brief 从配置读取线程组配置
+     * thread_scheduling_mode: dedicated | shared
+     * task_queue_engine: linked | ring
+     * task_queue_capacity: 队列容量
+     * task_dequeue_batch: 工作线程批量出队大小
+     * worker_idle_spin_us: 工作线程休眠前的自旋时长（微秒，0表示直接休眠）
+     * thread_borrowing: 是否允许线程组之间借用空闲线程
+     * thread_borrow_burst_percent: 借用上限（自身线程数的百分比）
+     * task_priority_lanes: 是否开启优先级通道
+     * task_lane_policy: strict | weighted
+     * task_lane_weights: 通道权重，如 16,4,1
+     * worker_local_queue_capacity: 工作线程本地队列容量（0表示派生任务也走共享队列）
+     * thread_affinity: 是否把租户线程绑定到紧凑的CPU集合
+     * tenant_max_queued_tasks: 租户排队任务数上限（0表示不限制）
+     * tenant_max_queued_kb: 租户排队任务占用内存上限（KB，0表示不限制）
+     */
+    static ThreadGroupOptions fromConfig(const ConfigManager& config);
+
+    /**
+     * @brief 按配置创建租户任务队列（开启优先级通道时为PriorityTaskQueue）
+     */
+    std::unique_ptr<TaskQueue> makeTaskQueue() const;
+
+    /**
+     * @brief 租户准入限额
+     */
+    AdmissionController::Limits admissionLimits() const;
+};
+
+/**
+ * @brief 线程组的CPU放置结果
+ */
+struct CpuPlacement {
+    std::vector<int> cpus;       ///< 绑定的CPU编号，为空表示不限制
+    std::vector<int> numaNodes;  ///< 这些CPU所在的NUMA节点
+};
 
 /**
  * @brief 工作线程类
  */
 class WorkerThread {
 public:
-    WorkerThread(const std::string& tenantId, LockFreeQueue& queue, CgroupController* cgroup = nullptr);
+    WorkerThread(TenantThreadGroup& group, CgroupController* cgroup = nullptr, size_t localQueueCapacity = 0);
     ~WorkerThread();
 
     /**
      * @brief 启动线程
+     * @param attach 新线程启动后在其中登记内核TID，由批次统一加入租户cgroup，可为空
      */
-    void start();
+    void start(std::shared_ptr<CgroupAttachBatch> attach = nullptr);
 
     /**
-     * @brief 停止线程
+     * @brief 停止线程并等待其退出
      */
     void stop();
 
+    /**
+     * @brief 通知线程在执行完当前任务后自行退出，不等待
+     * @param tracker 线程退出时通知的缩容进度，可为空
+     */
+    void requestStop(std::shared_ptr<ResizeTracker> tracker = nullptr);
+
+    /**
+     * @brief 线程是否已退出（未启动的线程视为已退出）
+     */
+    bool hasExited() const;
+
     /**
      * @brief 获取线程ID
      */
     std::thread::id getId() const;
 
+    /**
+     * @brief 获取内核线程ID，线程尚未运行时为0
+     */
+    pid_t getNativeTid() const;
+
+    /**
+     * @brief 线程已消耗的CPU时间（纳秒），通过线程的CPU时钟读取，线程未运行或已退出时为0
+     */
+    uint64_t getCpuTimeNs() const;
+
     /**
      * @brief 检查线程是否忙碌
      */
@@ -46,16 +147,77 @@ public:
      */
     size_t getExecutedTasks() const;
 
+    /**
+     * @brief 获取本地队列中可被窃取的任务数量
+     */
+    size_t getLocalQueueSize() const;
+
+    /**
+     * @brief 把线程绑定到指定CPU集合（仅Linux生效）
+     * @param cpus CPU编号，为空表示解除绑定
+     * @return 是否成功
+     */
+    bool setAffinity(const std::vector<int>& cpus);
+
 private:
+    friend class TenantThreadGroup;
+
+    /// 连续执行多少个任务后优先检查一次共享队列，避免派生任务饿死外部提交
+    static constexpr unsigned kSharedQueueInterval = 61;
+
     void run();
 
+    /**
+     * @brief 把本线程派生的任务放入LIFO槽，槽中原有任务移入本地队列（仅本线程调用）
+     * @param task 任务，本地队列已满时保留在task中
+     * @return 是否放入本地
+     */
+    bool pushLocal(std::unique_ptr<Task>& task);
+
+    /**
+     * @brief 取出本地任务：先取LIFO槽，再从本地队列底部弹出（仅本线程调用）
+     */
+    std::unique_ptr<Task> takeLocal();
+
+    /**
+     * @brief 线程退出后把残留的本地任务转交线程组共享队列，共享队列已满时就地执行
+     */
+    void drainLocalTasks();
+
+    /**
+     * @brief 执行单个任务并更新忙碌状态与计数
+     */
+    void runTask(std::unique_ptr<Task> task, std::vector<std::unique_ptr<Task>>& batch);
+
+    /**
+     * @brief 队列为空时等待新任务：先自旋，仍无任务则在线程组的wakeup_上休眠
+     */
+    void waitForWork();
+
+    /**
+     * @brief 更新忙碌状态并同步线程组的忙碌计数
+     */
+    void setBusy(bool busy);
+
+    TenantThreadGroup& group_;
     std::string tenantId_;
-    LockFreeQueue& taskQueue_;
     CgroupController* cgroup_;
     std::unique_ptr<std::thread> thread_;
     std::atomic<bool> running_;
     std::atomic<bool> busy_;
     std::atomic<size_t> executedTasks_;
+    std::atomic<bool> exited_{false};
+    std::shared_ptr<ResizeTracker> retireTracker_;  ///< 在running_置为false之前写入
+    std::shared_ptr<CgroupAttachBatch> attach_;     ///< 在线程创建之前写入，线程登记后释放
+    std::atomic<pid_t> tid_{0};
+    clockid_t cpuClock_{};                      ///< 线程的CPU时钟，cpuClockReady_为true后可读
+    std::atomic<bool> cpuClockReady_{false};
+    std::atomic<uint64_t> handedOverCpuNs_{0};  ///< 被移除时已转交线程组的CPU时间
+
+    // 本地任务：LIFO槽只由本线程访问，本地队列可被同组线程窃取
+    std::unique_ptr<Task> lifoSlot_;
+    std::unique_ptr<WorkStealingDeque> localQueue_;
+    size_t stealCursor_ = 0;
 };
 
 /**
@@ -64,7 +226,8 @@ private:
  */
 class TenantThreadGroup {
 public:
-    TenantThreadGroup(const std::string& tenantId, size_t threadCount, CgroupController* cgroup = nullptr);
+    TenantThreadGroup(const std::string& tenantId, size_t threadCount, CgroupController* cgroup = nullptr,
+                      const ThreadGroupOptions& options = ThreadGroupOptions());
     ~TenantThreadGroup();
 
     /**
@@ -78,12 +241,37 @@ public:
     void stop();
 
     /**
-     * @brief 提交任务到队列
+     * @brief 提交任务到队列，按任务自身的优先级进入通道
+     * @return 超过排队限额时立即拒绝，结果中带建议的重试时间
+     */
+    SubmitResult submitTask(std::unique_ptr<Task> task);
+
+    /**
+     * @brief 以指定优先级提交任务
+     * @param task 任务
+     * @param priority 通道提示，覆盖任务原有优先级
+     */
+    SubmitResult submitTask(std::unique_ptr<Task> task, TaskPriority priority);
+
+    /**
+     * @brief 批量提交任务，整批只做一次队列发布
+     * @param tasks 任务列表，未能入队的任务保留在其中
+     * @param rejection 输出，有任务被拒绝时为拒绝原因，可为空
+     * @return 成功提交的任务数量
      */
-    bool submitTask(std::unique_ptr<Task> task);
+    size_t submitTasks(std::vector<std::unique_ptr<Task>>& tasks, SubmitResult* rejection = nullptr);
 
     /**
-     * @brief 获取队列大小
+     * @brief 派生后续任务
+     * 在本组工作线程上调用时（如任务拆出的子计划）放入当前线程的LIFO槽，
+     * 由当前线程紧接着执行以保持缓存局部性，槽中原有任务可被同组空闲线程窃取；
+     * 在其他线程上调用或本地队列已满时进入共享队列。派生任务属于已准入的请求，
+     * 计入排队限额但不会被拒绝。
+     */
+    bool spawnTask(std::unique_ptr<Task> task);
+
+    /**
+     * @brief 获取队列大小（共享队列与各线程本地队列之和）
      */
     size_t getQueueSize() const;
 
@@ -98,16 +286,156 @@ public:
     size_t getTotalThreads() const;
 
     /**
-     * @brief 调整线程数量
+     * @brief 调整线程数量，不等待被移除的线程
+     * 扩容时新线程立即启动；缩容时被移除的线程执行完当前任务后自行退出，
+     * 其本地队列中的任务转回共享队列。
+     * @return 完成句柄，wait()等待被移除的线程全部退出
+     */
+    ResizeHandle resize(size_t newThreadCount);
+
+    /**
+     * @brief 设置线程借用协调器，nullptr表示不参与借用
+     */
+    void setBorrowBroker(ThreadBorrowBroker* broker);
+
+    /**
+     * @brief 设置本组线程的CPU放置，之后新增的线程同样绑定
+     * 与resize共用调用方的串行化（由ThreadPoolManager在其锁内调用）
+     * @return 所有线程是否绑定成功
+     */
+    bool setCpuPlacement(const CpuPlacement& placement);
+
+    /**
+     * @brief 获取本组线程的CPU放置
+     */
+    CpuPlacement getCpuPlacement() const;
+
+    /**
+     * @brief 获取租户ID
+     */
+    const std::string& getTenantId() const;
+
+    /**
+     * @brief 本组空闲线程为其他租户执行任务消耗的CPU时间（秒）
+     */
+    double getLentCpuSeconds() const;
+
+    /**
+     * @brief 其他租户的线程为本组执行任务消耗的CPU时间（秒）
+     */
+    double getBorrowedCpuSeconds() const;
+
+    /**
+     * @brief 本组消耗的CPU时间（纳秒）
+     * 本组线程（含已退出的线程）的CPU时间，扣除借给其他租户的部分，加上借用其他租户线程的部分；
+     * 由监控线程定期读取，每个线程一次clock_gettime
+     */
+    uint64_t getCpuTimeNs() const;
+
+    /**
+     * @brief 当前计入排队限额的字节数
+     */
+    size_t getQueuedBytes() const;
+
+    /**
+     * @brief 因超过排队限额被拒绝的任务数
+     */
+    size_t getRejectedTasks() const;
+
+    /**
+     * @brief 任务从提交到开始执行的等待时长分布
      */
-    bool resize(size_t newThreadCount);
+    LatencySummary getQueueWaitLatency() const;
+
+    /**
+     * @brief 任务execute()的执行时长分布
+     */
+    LatencySummary getRunLatency() const;
+
+    /**
+     * @brief 出队时已超过截止时间而被丢弃的任务数
+     */
+    size_t getExpiredTasks() const;
+
+    /**
+     * @brief 出队时已被取消而被丢弃的任务数
+     */
+    size_t getCancelledTasks() const;
+
+    /**
+     * @brief 执行一批任务，已过期或已取消的任务不执行，分别计数；
+     * 执行的任务按开始、结束时间记录排队等待与执行时长
+     * @param batch 任务列表
+     * @return 成功执行的任务数量
+     */
+    size_t executeBatch(std::vector<std::unique_ptr<Task>>& batch);
 
 private:
+    friend class WorkerThread;
+    friend class ThreadBorrowBroker;
+
+    /**
+     * @brief 本组线程全部在忙时请求其他租户借出空闲线程
+     */
+    void requestBorrowIfSaturated();
+
+    /**
+     * @brief 从同组其他线程的本地队列窃取一个任务
+     */
+    std::unique_ptr<Task> stealTask(WorkerThread& thief);
+
+    /**
+     * @brief 同组线程本地队列中是否有可窃取的任务
+     */
+    bool hasStealableTasks() const;
+
+    /**
+     * @brief 发布当前线程列表供窃取者无锁遍历，旧列表交给EpochReclaimer回收
+     */
+    void publishWorkers();
+
+    /**
+     * @brief 为一次启动/扩容的新线程创建cgroup批量加入，未启用cgroup时为空
+     */
+    std::shared_ptr<CgroupAttachBatch> makeAttachBatch(size_t workers) const;
+
+    /**
+     * @brief 回收已退出的被移除线程，对象交给EpochReclaimer延迟释放（窃取者可能仍持有旧列表）
+     * @param waitForExit 是否等待尚未退出的线程
+     */
+    void reapRetiredWorkers(bool waitForExit);
+
     std::string tenantId_;
     std::vector<std::unique_ptr<WorkerThread>> threads_;
-    LockFreeQueue taskQueue_;
+    std::vector<std::unique_ptr<WorkerThread>> retiring_;  ///< 已移除、等待退出后回收的线程
+    std::unique_ptr<TaskQueue> taskQueue_;
+    AdmissionController admission_;
+    EventCount wakeup_;  ///< 空闲工作线程在此休眠，提交任务时唤醒
     CgroupController* cgroup_;
+    size_t dequeueBatchSize_;
+    std::chrono::microseconds idleSpin_;
+    size_t localQueueCapacity_;
+    std::atomic<const std::vector<WorkerThread*>*> workers_{nullptr};  ///< 窃取用线程列表，经EpochReclaimer回收
+    mutable std::mutex placementMutex_;
+    CpuPlacement placement_;
     std::atomic<bool> running_;
+    std::atomic<size_t> threadCount_{0};   ///< 供无锁读取的线程数，resize时更新
+    std::atomic<size_t> busyWorkers_{0};   ///< 正在执行任务的本组线程数
+    std::atomic<size_t> expiredTasks_{0};
+    std::atomic<size_t> cancelledTasks_{0};
+    LatencyHistogram queueWaitHistogram_;
+    LatencyHistogram runHistogram_;
+
+    // 线程借用
+    std::atomic<ThreadBorrowBroker*> broker_{nullptr};
+    size_t borrowBurstPercent_;
+    std::atomic<size_t> borrowCeiling_{0};     ///< 最多同时借入的线程数
+    std::atomic<size_t> borrowedWorkers_{0};   ///< 正在为本组执行任务的外组线程数
+    std::atomic<size_t> parkedWorkers_{0};     ///< 正在休眠的本组线程数
+    std::atomic<uint64_t> lentCpuNs_{0};
+    std::atomic<uint64_t> borrowedCpuNs_{0};
+    std::atomic<uint64_t> exitedCpuNs_{0};     ///< 已退出或已移除线程累计的CPU时间
+    mutable std::mutex cpuMutex_;              ///< 线程时钟转入exitedCpuNs_时与getCpuTimeNs互斥，累计值不回落
 };
 
 } // namespace yao
\ No newline at end of file
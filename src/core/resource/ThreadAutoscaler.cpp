@@ -0,0 +1,181 @@
+#include "core/resource/ThreadAutoscaler.h"
+#include "common/config/ConfigManager.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_set>
+
+namespace yao {
+
+namespace {
+
+size_t readPositive(const ConfigManager& config, const std::string& key, size_t defaultValue) {
+    int value = config.getInt(key, static_cast<int>(defaultValue));
+    return value >= 0 ? static_cast<size_t>(value) : defaultValue;
+}
+
+} // namespace
+
+AutoscalePolicy AutoscalePolicy::fromConfig(const ConfigManager& config) {
+    AutoscalePolicy policy;
+    policy.enabled = config.getBool("thread_autoscale", policy.enabled);
+    policy.minThreads = std::max<size_t>(readPositive(config, "thread_autoscale_min_threads", policy.minThreads), 1);
+    policy.interval = std::chrono::milliseconds(
+        std::max<size_t>(readPositive(config, "thread_autoscale_interval_ms", policy.interval.count()), 1));
+    policy.cooldown = std::chrono::milliseconds(
+        readPositive(config, "thread_autoscale_cooldown_ms", policy.cooldown.count()));
+    policy.growBusyPercent = readPositive(config, "thread_autoscale_grow_busy_percent", policy.growBusyPercent);
+    policy.shrinkBusyPercent = readPositive(config, "thread_autoscale_shrink_busy_percent", policy.shrinkBusyPercent);
+    policy.stepPercent = readPositive(config, "thread_autoscale_step_percent", policy.stepPercent);
+    if (policy.shrinkBusyPercent >= policy.growBusyPercent) {
+        std::cerr << "thread_autoscale_shrink_busy_percent must be below grow percent, using defaults" << std::endl;
+        policy.growBusyPercent = AutoscalePolicy().growBusyPercent;
+        policy.shrinkBusyPercent = AutoscalePolicy().shrinkBusyPercent;
+    }
+    return policy;
+}
+
+ThreadAutoscaler::ThreadAutoscaler(const AutoscalePolicy& policy, SampleFn sampler, ScaleFn scaler)
+    : policy_(policy), sampler_(std::move(sampler)), scaler_(std::move(scaler)) {
+}
+
+ThreadAutoscaler::~ThreadAutoscaler() {
+    stop();
+}
+
+bool ThreadAutoscaler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return true;
+
+    running_ = true;
+    thread_ = std::thread(&ThreadAutoscaler::run, this);
+    return true;
+}
+
+void ThreadAutoscaler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ThreadAutoscaler::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (cv_.wait_for(lock, policy_.interval, [this]() { return !running_; })) {
+            break;
+        }
+        lock.unlock();
+        tick();
+        lock.lock();
+    }
+}
+
+size_t ThreadAutoscaler::evaluate(const AutoscalePolicy& policy, TenantState& state, const Sample& sample,
+                                  std::chrono::steady_clock::time_point now) {
+    size_t total = sample.totalThreads;
+    size_t busyPercent = total > 0 ? sample.busyThreads * 100 / total : 100;
+
+    TenantMetrics& metrics = state.metrics;
+    metrics.currentThreads = total;
+    metrics.minThreads = sample.minThreads;
+    metrics.maxThreads = sample.maxThreads;
+    metrics.lastQueueSize = sample.queueSize;
+    metrics.lastBusyRatio = total > 0 ? static_cast<double>(sample.busyThreads) / total : 0.0;
+    metrics.lastDecision = Decision::Hold;
+
+    // 滞回：只有连续落在同一侧阈值之外才累计，中间状态清零
+    if (sample.queueSize > 0 && busyPercent >= policy.growBusyPercent) {
+        ++state.growStreak;
+        state.shrinkStreak = 0;
+    } else if (sample.queueSize == 0 && busyPercent <= policy.shrinkBusyPercent) {
+        ++state.shrinkStreak;
+        state.growStreak = 0;
+    } else {
+        state.growStreak = 0;
+        state.shrinkStreak = 0;
+    }
+
+    bool coolingDown = state.lastChange != std::chrono::steady_clock::time_point{} &&
+                       now - state.lastChange < policy.cooldown;
+    if (coolingDown) {
+        return total;
+    }
+
+    size_t step = std::max<size_t>(total * policy.stepPercent / 100, 1);
+    if (state.growStreak >= policy.growSamples && total < sample.maxThreads) {
+        // 积压不多时不必一次扩满步长
+        size_t target = std::min({sample.maxThreads, total + step, total + sample.queueSize});
+        metrics.lastDecision = Decision::Grow;
+        return target;
+    }
+    if (state.shrinkStreak >= policy.shrinkSamples && total > sample.minThreads) {
+        metrics.lastDecision = Decision::Shrink;
+        return total - std::min(step, total - sample.minThreads);
+    }
+    return total;
+}
+
+void ThreadAutoscaler::tick() {
+    std::vector<Sample> samples = sampler_();
+    auto now = std::chrono::steady_clock::now();
+
+    std::vector<std::pair<Sample, size_t>> changes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_set<std::string> seen;
+        for (const Sample& sample : samples) {
+            seen.insert(sample.tenantId);
+            size_t target = evaluate(policy_, states_[sample.tenantId], sample, now);
+            if (target != sample.totalThreads) {
+                changes.emplace_back(sample, target);
+            }
+        }
+        // 已删除的租户不再保留状态
+        for (auto it = states_.begin(); it != states_.end();) {
+            it = seen.count(it->first) ? std::next(it) : states_.erase(it);
+        }
+    }
+
+    // 调整在锁外进行，回调可能获取线程池管理器的锁
+    for (const auto& [sample, target] : changes) {
+        bool applied = scaler_(sample.tenantId, target);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = states_.find(sample.tenantId);
+        if (it == states_.end()) continue;
+
+        TenantState& state = it->second;
+        state.growStreak = 0;
+        state.shrinkStreak = 0;
+        if (!applied) {
+            ++state.metrics.rejected;
+            continue;
+        }
+        state.lastChange = now;
+        state.metrics.currentThreads = target;
+        if (target > sample.totalThreads) {
+            ++state.metrics.scaleUps;
+        } else {
+            ++state.metrics.scaleDowns;
+        }
+        std::cout << "Autoscaler: tenant " << sample.tenantId << " threads " << sample.totalThreads
+                  << " -> " << target << " (queue " << sample.queueSize << ", busy "
+                  << sample.busyThreads << "/" << sample.totalThreads << ")" << std::endl;
+    }
+}
+
+std::unordered_map<std::string, ThreadAutoscaler::TenantMetrics> ThreadAutoscaler::getMetrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<std::string, TenantMetrics> metrics;
+    for (const auto& [tenantId, state] : states_) {
+        metrics.emplace(tenantId, state.metrics);
+    }
+    return metrics;
+}
+
+} // namespace yao
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace yao {
+
+class ConfigManager;
+
+/**
+ * @brief 线程数自动伸缩策略
+ */
+struct AutoscalePolicy {
+    bool enabled = false;                          ///< 是否开启自动伸缩（仅Dedicated模式）
+    size_t minThreads = 2;                         ///< 每个租户至少保留的线程数
+    std::chrono::milliseconds interval{500};       ///< 采样间隔
+    std::chrono::milliseconds cooldown{2000};      ///< 同一租户两次调整之间的最短间隔
+    size_t growBusyPercent = 90;                   ///< 忙碌比例不低于该值且有积压视为过载
+    size_t shrinkBusyPercent = 30;                 ///< 忙碌比例不高于该值且无积压视为空闲
+    size_t growSamples = 2;                        ///< 连续过载多少次采样后扩容
+    size_t shrinkSamples = 6;                      ///< 连续空闲多少次采样后缩容（比扩容更保守）
+    size_t stepPercent = 25;                       ///< 每次调整当前线程数的百分比，至少1个
+
+    /**
+     * @brief 从配置读取伸缩策略
+     * thread_autoscale: 是否开启
+     * thread_autoscale_min_threads: 每个租户最少线程数
+     * thread_autoscale_interval_ms: 采样间隔
+     * thread_autoscale_cooldown_ms: 调整冷却时间
+     * thread_autoscale_grow_busy_percent / thread_autoscale_shrink_busy_percent: 过载/空闲阈值
+     * thread_autoscale_step_percent: 每次调整幅度
+     */
+    static AutoscalePolicy fromConfig(const ConfigManager& config);
+};
+
+/**
+ * @brief 租户线程数自动伸缩控制器
+ * 后台线程按固定间隔采样每个租户线程组的队列长度与忙碌线程数，
+ * 在 [minThreads, 配额线程数] 之间调整线程数：
+ * 过载（有积压且几乎所有线程在忙）连续growSamples次后扩容，
+ * 空闲（无积压且忙碌比例低）连续shrinkSamples次后缩容；
+ * 两个阈值之间的状态清零计数（滞回），每个租户的调整受cooldown限速。
+ * 采样与调整通过回调完成，不依赖具体的线程池实现。
+ */
+class ThreadAutoscaler {
+public:
+    /**
+     * @brief 一次采样中单个租户的状态
+     */
+    struct Sample {
+        std::string tenantId;
+        size_t queueSize = 0;
+        size_t busyThreads = 0;
+        size_t totalThreads = 0;
+        size_t minThreads = 0;
+        size_t maxThreads = 0;   ///< 配额对应的线程数上限
+    };
+
+    enum class Decision {
+        Hold,
+        Grow,
+        Shrink
+    };
+
+    /**
+     * @brief 租户伸缩指标
+     */
+    struct TenantMetrics {
+        size_t currentThreads = 0;
+        size_t minThreads = 0;
+        size_t maxThreads = 0;
+        size_t lastQueueSize = 0;
+        double lastBusyRatio = 0;
+        Decision lastDecision = Decision::Hold;
+        size_t scaleUps = 0;
+        size_t scaleDowns = 0;
+        size_t rejected = 0;     ///< 调整回调返回失败的次数
+    };
+
+    /**
+     * @brief 单个租户的伸缩状态
+     */
+    struct TenantState {
+        size_t growStreak = 0;
+        size_t shrinkStreak = 0;
+        std::chrono::steady_clock::time_point lastChange{};
+        TenantMetrics metrics;
+    };
+
+    using SampleFn = std::function<std::vector<Sample>()>;
+    using ScaleFn = std::function<bool(const std::string& tenantId, size_t threadCount)>;
+
+    ThreadAutoscaler(const AutoscalePolicy& policy, SampleFn sampler, ScaleFn scaler);
+    ~ThreadAutoscaler();
+
+    ThreadAutoscaler(const ThreadAutoscaler&) = delete;
+    ThreadAutoscaler& operator=(const ThreadAutoscaler&) = delete;
+
+    /**
+     * @brief 启动后台采样线程
+     */
+    bool start();
+
+    /**
+     * @brief 停止后台采样线程
+     */
+    void stop();
+
+    /**
+     * @brief 立即执行一轮采样与调整
+     */
+    void tick();
+
+    /**
+     * @brief 根据采样决定目标线程数（不修改线程数）
+     * @param policy 伸缩策略
+     * @param state 租户伸缩状态，更新计数
+     * @param sample 本次采样
+     * @param now 当前时间
+     * @return 目标线程数，等于当前线程数表示不调整
+     */
+    static size_t evaluate(const AutoscalePolicy& policy, TenantState& state, const Sample& sample,
+                           std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief 获取所有租户的伸缩指标
+     */
+    std::unordered_map<std::string, TenantMetrics> getMetrics() const;
+
+private:
+    void run();
+
+    AutoscalePolicy policy_;
+    SampleFn sampler_;
+    ScaleFn scaler_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, TenantState> states_;
+    std::thread thread_;
+    bool running_ = false;
+};
+
+} // namespace yao
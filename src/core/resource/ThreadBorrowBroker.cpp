@@ -0,0 +1,87 @@
+#include "core/resource/ThreadBorrowBroker.h"
+#include "core/resource/ThreadCpuClock.h"
+#include <algorithm>
+#include <thread>
+
+namespace yao {
+
+void ThreadBorrowBroker::registerGroup(TenantThreadGroup& group) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (std::find(groups_.begin(), groups_.end(), &group) == groups_.end()) {
+        groups_.push_back(&group);
+    }
+    group.setBorrowBroker(this);
+}
+
+void ThreadBorrowBroker::unregisterGroup(TenantThreadGroup& group) {
+    detachGroup(group);
+    waitForBorrowers(group);
+}
+
+void ThreadBorrowBroker::detachGroup(TenantThreadGroup& group) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_.erase(std::remove(groups_.begin(), groups_.end(), &group), groups_.end());
+    group.setBorrowBroker(nullptr);
+}
+
+void ThreadBorrowBroker::waitForBorrowers(const TenantThreadGroup& group) {
+    // 已经占用借用名额的外组线程仍在访问该组队列
+    while (group.borrowedWorkers_.load() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TenantThreadGroup* ThreadBorrowBroker::claimBorrower(const TenantThreadGroup& lender) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = groups_.size();
+    for (size_t i = 0; i < count; ++i) {
+        TenantThreadGroup* candidate = groups_[(cursor_ + i) % count];
+        if (candidate == &lender) continue;
+
+        // 只借给自身线程全部在忙且仍有积压的租户，并受突发上限约束
+        if (candidate->taskQueue_->empty() || candidate->parkedWorkers_.load() > 0) continue;
+        if (candidate->borrowedWorkers_.load() >= candidate->borrowCeiling_.load()) continue;
+
+        candidate->borrowedWorkers_.fetch_add(1);
+        cursor_ = (cursor_ + i + 1) % count;
+        return candidate;
+    }
+    return nullptr;
+}
+
+bool ThreadBorrowBroker::runBorrowedBatch(TenantThreadGroup& lender, std::vector<std::unique_ptr<Task>>& batch) {
+    TenantThreadGroup* borrower = claimBorrower(lender);
+    if (!borrower) {
+        return false;
+    }
+
+    batch.clear();
+    bool executed = false;
+    if (borrower->taskQueue_->dequeueBulk(batch, borrower->dequeueBatchSize_) > 0) {
+        uint64_t start = threadCpuTimeNs();
+        borrower->executeBatch(batch);
+        uint64_t used = threadCpuTimeNs() - start;
+
+        lender.lentCpuNs_.fetch_add(used);
+        borrower->borrowedCpuNs_.fetch_add(used);
+        executed = true;
+    }
+    batch.clear();
+
+    borrower->borrowedWorkers_.fetch_sub(1);
+    return executed;
+}
+
+void ThreadBorrowBroker::requestHelp(TenantThreadGroup& borrower) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (TenantThreadGroup* group : groups_) {
+        if (group == &borrower) continue;
+        if (group->parkedWorkers_.load() > 0 && group->taskQueue_->empty()) {
+            // 被唤醒的线程发现本组无任务，会转而调用runBorrowedBatch
+            group->wakeup_.notify();
+            return;
+        }
+    }
+}
+
+} // namespace yao
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/resource/TenantThreadGroup.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 租户线程组之间的空闲线程借用协调器
+ * 某个线程组没有积压时，它的空闲线程可以从其他线程组的队列中取任务执行。
+ * 借出方只在自身队列为空时借出；借入方同时被借用的线程数不超过
+ * 自身线程数 * borrowBurstPercent / 100。执行借来任务消耗的线程CPU时间
+ * 记入借出方的lent与借入方的borrowed账户。
+ */
+class ThreadBorrowBroker {
+public:
+    ThreadBorrowBroker() = default;
+    ThreadBorrowBroker(const ThreadBorrowBroker&) = delete;
+    ThreadBorrowBroker& operator=(const ThreadBorrowBroker&) = delete;
+
+    /**
+     * @brief 登记参与借用的线程组
+     */
+    void registerGroup(TenantThreadGroup& group);
+
+    /**
+     * @brief 注销线程组，等待正在为其执行任务的外组线程结束后返回
+     */
+    void unregisterGroup(TenantThreadGroup& group);
+
+    /**
+     * @brief 注销线程组但不等待，之后不再有线程借给它或从它借出
+     * 调用方需在销毁线程组前调用waitForBorrowers
+     */
+    void detachGroup(TenantThreadGroup& group);
+
+    /**
+     * @brief 等待正在为该组执行任务的外组线程结束
+     */
+    static void waitForBorrowers(const TenantThreadGroup& group);
+
+    /**
+     * @brief 空闲线程为其他有积压的线程组执行一批任务
+     * @param lender 借出线程所属的线程组
+     * @param batch 复用的任务缓冲区
+     * @return 是否借到并执行了任务
+     */
+    bool runBorrowedBatch(TenantThreadGroup& lender, std::vector<std::unique_ptr<Task>>& batch);
+
+    /**
+     * @brief 线程组已无空闲线程时，唤醒另一个空闲线程组的休眠线程来借用
+     * @param borrower 请求借用的线程组
+     */
+    void requestHelp(TenantThreadGroup& borrower);
+
+private:
+    /**
+     * @brief 选择一个可借入的线程组并占用一个借用名额
+     * @return 没有合适的线程组时返回nullptr
+     */
+    TenantThreadGroup* claimBorrower(const TenantThreadGroup& lender);
+
+    std::mutex mutex_;
+    std::vector<TenantThreadGroup*> groups_;
+    size_t cursor_ = 0;   ///< 轮询起点，避免总是先借给同一个租户
+};
+
+} // namespace yao
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+namespace yao {
+
+/**
+ * @brief 当前线程已消耗的CPU时间（纳秒）
+ * 非Linux平台退化为单调时钟
+ */
+inline uint64_t threadCpuTimeNs() {
+#ifdef __linux__
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+#endif
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace yao
@@ -1,4 +1,6 @@
 #include "core/resource/ThreadPoolManager.h"
+#include "core/resource/EpochReclaimer.h"
+#include <map>
 #include <numeric>
 
 namespace yao {
@@ -8,7 +10,103 @@ ThreadPoolManager& ThreadPoolManager::getInstance() {
     return instance;
 }
 
-bool ThreadPoolManager::initialize(size_t totalThreads, bool enableCgroup) {
+ThreadPoolManager::ThreadPoolManager()
+    : snapshot_(new Snapshot()) {
+    // 保证EpochReclaimer先于本单例构造、晚于本单例析构
+    EpochReclaimer::getInstance();
+}
+
+ThreadPoolManager::~ThreadPoolManager() {
+    shutdown();
+    delete snapshot_.load();
+}
+
+void ThreadPoolManager::publishSnapshot(bool waitForReaders) {
+    auto* next = new Snapshot();
+    for (const auto& [tenantId, group] : tenantGroups_) {
+        next->groups.emplace(tenantId, group.get());
+    }
+    next->threadLimits = threadLimits_;
+    next->sharedScheduler = sharedScheduler_.get();
+    next->totalThreads = totalThreads_;
+
+    const Snapshot* previous = snapshot_.exchange(next, std::memory_order_acq_rel);
+    auto& reclaimer = EpochReclaimer::getInstance();
+    if (waitForReaders) {
+        // 旧快照中的对象即将销毁，必须等所有读者离开
+        reclaimer.synchronize();
+        delete previous;
+    } else {
+        reclaimer.retire(const_cast<Snapshot*>(previous));
+    }
+}
+
+size_t ThreadPoolManager::allocatedThreads(const std::string& excludeTenantId) const {
+    return std::accumulate(
+        threadLimits_.begin(), threadLimits_.end(), 0UL,
+        [&excludeTenantId](size_t sum, const auto& pair) {
+            if (pair.first != excludeTenantId) {
+                return sum + pair.second;
+            }
+            return sum;
+        });
+}
+
+std::vector<ThreadAutoscaler::Sample> ThreadPoolManager::sampleTenantGroups() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ThreadAutoscaler::Sample> samples;
+    samples.reserve(tenantGroups_.size());
+    for (const auto& [tenantId, group] : tenantGroups_) {
+        ThreadAutoscaler::Sample sample;
+        sample.tenantId = tenantId;
+        sample.queueSize = group->getQueueSize();
+        sample.busyThreads = group->getBusyThreads();
+        sample.totalThreads = group->getTotalThreads();
+        sample.maxThreads = threadLimits_.at(tenantId);
+        sample.minThreads = std::min(groupOptions_.autoscale.minThreads, sample.maxThreads);
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+bool ThreadPoolManager::autoscaleTenantThreads(const std::string& tenantId, size_t threadCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = tenantGroups_.find(tenantId);
+    if (it == tenantGroups_.end() || threadCount == 0 || threadCount > threadLimits_.at(tenantId)) {
+        return false;
+    }
+    if (!it->second->resize(threadCount)) {
+        return false;
+    }
+    rebalanceAffinity();
+    return true;
+}
+
+void ThreadPoolManager::rebalanceAffinity() {
+    if (!affinityPlanner_) return;
+
+    std::map<std::string, size_t> demands;
+    for (const auto& [tenantId, group] : tenantGroups_) {
+        demands[tenantId] = group->getTotalThreads();
+    }
+
+    const CpuTopology& topology = affinityPlanner_->getTopology();
+    for (const auto& [tenantId, cpus] : affinityPlanner_->plan(demands)) {
+        CpuPlacement placement;
+        placement.cpus = cpus;
+        for (int cpu : cpus) {
+            int node = topology.nodeOf(cpu);
+            if (std::find(placement.numaNodes.begin(), placement.numaNodes.end(), node) == placement.numaNodes.end()) {
+                placement.numaNodes.push_back(node);
+            }
+        }
+        std::sort(placement.numaNodes.begin(), placement.numaNodes.end());
+        tenantGroups_.at(tenantId)->setCpuPlacement(placement);
+    }
+}
+
+bool ThreadPoolManager::initialize(size_t totalThreads, bool enableCgroup, const ThreadGroupOptions& groupOptions) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (initialized_) {
@@ -17,33 +115,95 @@ bool ThreadPoolManager::initialize(size_t totalThreads, bool enableCgroup) {
 
     totalThreads_ = totalThreads;
     cgroupEnabled_ = enableCgroup;
+    groupOptions_ = groupOptions;
 
     if (cgroupEnabled_) {
-        cgroupController_ = std::make_unique<CgroupController>();
+        cgroupController_ = std::make_shared<CgroupController>();
         if (!cgroupController_->initialize()) {
             std::cerr << "Failed to initialize cgroup controller" << std::endl;
             return false;
         }
     }
 
+    if (groupOptions_.schedulingMode == SchedulingMode::Shared) {
+        // 共享线程同时执行多个租户的任务，无法按线程划入租户cgroup
+        sharedScheduler_ = std::make_unique<WeightedFairScheduler>(totalThreads_, groupOptions_);
+        sharedScheduler_->start();
+    } else {
+        if (groupOptions_.enableBorrowing) {
+            borrowBroker_ = std::make_unique<ThreadBorrowBroker>();
+        }
+        if (groupOptions_.threadAffinity) {
+            CpuTopology topology = CpuTopology::detect();
+            std::cout << "CPU topology: " << topology.getCpuCount() << " cpus, "
+                      << topology.getNodeCount() << " NUMA nodes, "
+                      << topology.getCacheDomainCount() << " cache domains" << std::endl;
+            affinityPlanner_ = std::make_unique<AffinityPlanner>(std::move(topology));
+        }
+        if (groupOptions_.autoscale.enabled) {
+            autoscaler_ = std::make_unique<ThreadAutoscaler>(
+                groupOptions_.autoscale,
+                [this]() { return sampleTenantGroups(); },
+                [this](const std::string& tenantId, size_t threadCount) {
+                    return autoscaleTenantThreads(tenantId, threadCount);
+                });
+            autoscaler_->start();
+        }
+    }
+
     initialized_ = true;
+    publishSnapshot(false);
     std::cout << "ThreadPoolManager initialized with " << totalThreads << " threads"
+              << (sharedScheduler_ ? " (shared weighted-fair pool)" : "")
+              << (borrowBroker_ ? " (thread borrowing enabled)" : "")
+              << (affinityPlanner_ ? " (thread affinity enabled)" : "")
+              << (autoscaler_ ? " (thread autoscaling enabled)" : "")
               << (cgroupEnabled_ ? " (cgroup enabled)" : "") << std::endl;
 
     return true;
 }
 
 void ThreadPoolManager::shutdown() {
+    // 自动伸缩线程的回调会获取mutex_，必须在锁外停止
+    std::unique_ptr<ThreadAutoscaler> autoscaler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        autoscaler = std::move(autoscaler_);
+    }
+    if (autoscaler) {
+        autoscaler->stop();
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (!initialized_) return;
 
-    // 停止所有租户线程组
-    for (auto& [tenantId, group] : tenantGroups_) {
+    // 先从快照中摘除所有租户，等读者离开后再停止线程
+    auto groups = std::move(tenantGroups_);
+    tenantGroups_.clear();
+    threadLimits_.clear();
+    auto scheduler = std::move(sharedScheduler_);
+    publishSnapshot(true);
+
+    // 先停止线程借用，再停止所有租户线程组
+    if (borrowBroker_) {
+        for (auto& [tenantId, group] : groups) {
+            borrowBroker_->unregisterGroup(*group);
+        }
+    }
+    for (auto& [tenantId, group] : groups) {
         group->stop();
     }
-    tenantGroups_.clear();
+    groups.clear();
+    borrowBroker_.reset();
+    affinityPlanner_.reset();
+
+    if (scheduler) {
+        scheduler->stop();
+        scheduler.reset();
+    }
 
+    // 资源管理器持有的弱引用随之失效，之后的释放和采样不再访问cgroup
     cgroupController_.reset();
     initialized_ = false;
 
@@ -55,17 +215,24 @@ bool ThreadPoolManager::createTenantThreadGroup(const std::string& tenantId, siz
 
     if (!initialized_) return false;
 
+    if (sharedScheduler_) {
+        if (!sharedScheduler_->addTenant(tenantId, threadCount)) {
+            return false; // 已存在
+        }
+        std::cout << "Registered tenant " << tenantId << " in shared pool with weight " << threadCount << std::endl;
+        return true;
+    }
+
     if (tenantGroups_.find(tenantId) != tenantGroups_.end()) {
         return false; // 已存在
     }
+    if (removingTenants_.count(tenantId) > 0) {
+        std::cerr << "Thread group for tenant " << tenantId << " is still being removed" << std::endl;
+        return false;
+    }
 
     // 检查总线程数限制
-    size_t currentAllocated = std::accumulate(
-        tenantGroups_.begin(), tenantGroups_.end(), 0UL,
-        [](size_t sum, const auto& pair) {
-            return sum + pair.second->getTotalThreads();
-        });
-
+    size_t currentAllocated = allocatedThreads();
     if (currentAllocated + threadCount > totalThreads_) {
         std::cerr << "Insufficient threads: requested " << threadCount
                   << ", available " << (totalThreads_ - currentAllocated) << std::endl;
@@ -75,7 +242,8 @@ bool ThreadPoolManager::createTenantThreadGroup(const std::string& tenantId, siz
     // 创建cgroup（如果启用）
     CgroupController* cgroup = nullptr;
     if (cgroupEnabled_) {
-        if (!cgroupController_->createTenantCgroup(tenantId)) {
+        // CpuResourceManager分配配额时可能已创建
+        if (!cgroupController_->hasTenantCgroup(tenantId) && !cgroupController_->createTenantCgroup(tenantId)) {
             std::cerr << "Failed to create cgroup for tenant " << tenantId << std::endl;
             return false;
         }
@@ -83,7 +251,7 @@ bool ThreadPoolManager::createTenantThreadGroup(const std::string& tenantId, siz
     }
 
     // 创建线程组
-    auto group = std::make_unique<TenantThreadGroup>(tenantId, threadCount, cgroup);
+    auto group = std::make_unique<TenantThreadGroup>(tenantId, threadCount, cgroup, groupOptions_);
     if (!group->start()) {
         std::cerr << "Failed to start thread group for tenant " << tenantId << std::endl;
         if (cgroupEnabled_) {
@@ -92,7 +260,13 @@ bool ThreadPoolManager::createTenantThreadGroup(const std::string& tenantId, siz
         return false;
     }
 
+    if (borrowBroker_) {
+        borrowBroker_->registerGroup(*group);
+    }
     tenantGroups_[tenantId] = std::move(group);
+    threadLimits_[tenantId] = threadCount;
+    publishSnapshot(false);
+    rebalanceAffinity();
 
     std::cout << "Created thread group for tenant " << tenantId
               << " with " << threadCount << " threads" << std::endl;
@@ -101,19 +275,48 @@ bool ThreadPoolManager::createTenantThreadGroup(const std::string& tenantId, siz
 }
 
 bool ThreadPoolManager::removeTenantThreadGroup(const std::string& tenantId) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<TenantThreadGroup> group;
+    std::shared_ptr<CgroupController> cgroup;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = tenantGroups_.find(tenantId);
-    if (it == tenantGroups_.end()) {
-        return false;
+        if (sharedScheduler_) {
+            return sharedScheduler_->removeTenant(tenantId);
+        }
+
+        auto it = tenantGroups_.find(tenantId);
+        if (it == tenantGroups_.end()) {
+            return false;
+        }
+
+        // 锁内只摘除线程组，等待读者和停止线程放到锁外
+        group = std::move(it->second);
+        tenantGroups_.erase(it);
+        threadLimits_.erase(tenantId);
+        publishSnapshot(false);
+        if (borrowBroker_) {
+            borrowBroker_->detachGroup(*group);
+        }
+        if (cgroupEnabled_) {
+            cgroup = cgroupController_;
+        }
+        removingTenants_.insert(tenantId);
+        rebalanceAffinity();
     }
 
-    it->second->stop();
-    tenantGroups_.erase(it);
+    // 执行中的慢任务只拖慢本次删除，不阻塞其他租户的创建、伸缩和自动伸缩
+    EpochReclaimer::getInstance().synchronize();
+    ThreadBorrowBroker::waitForBorrowers(*group);
+    group->stop();
+    group.reset();
 
     // 清理cgroup
-    if (cgroupEnabled_) {
-        cgroupController_->removeTenantCgroup(tenantId);
+    if (cgroup) {
+        cgroup->removeTenantCgroup(tenantId);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        removingTenants_.erase(tenantId);
     }
 
     std::cout << "Removed thread group for tenant " << tenantId << std::endl;
@@ -121,75 +324,192 @@ bool ThreadPoolManager::removeTenantThreadGroup(const std::string& tenantId) {
     return true;
 }
 
-bool ThreadPoolManager::resizeTenantThreads(const std::string& tenantId, size_t newThreadCount) {
+ResizeHandle ThreadPoolManager::resizeTenantThreads(const std::string& tenantId, size_t newThreadCount) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    if (sharedScheduler_) {
+        return sharedScheduler_->setWeight(tenantId, newThreadCount) ? ResizeHandle::completed() : ResizeHandle();
+    }
+
     auto it = tenantGroups_.find(tenantId);
     if (it == tenantGroups_.end()) {
-        return false;
+        return ResizeHandle();
     }
 
     // 检查总线程数限制
-    size_t currentAllocated = std::accumulate(
-        tenantGroups_.begin(), tenantGroups_.end(), 0UL,
-        [&tenantId](size_t sum, const auto& pair) {
-            if (pair.first != tenantId) {
-                return sum + pair.second->getTotalThreads();
-            }
-            return sum;
-        });
-
+    size_t currentAllocated = allocatedThreads(tenantId);
     if (currentAllocated + newThreadCount > totalThreads_) {
         std::cerr << "Insufficient threads for resize: requested " << newThreadCount
                   << ", available " << (totalThreads_ - currentAllocated) << std::endl;
-        return false;
+        return ResizeHandle();
+    }
+
+    // 线程数由线程组以原子变量对外提供，快照只需更新租户上限
+    ResizeHandle handle = it->second->resize(newThreadCount);
+    if (handle) {
+        threadLimits_[tenantId] = newThreadCount;
+        publishSnapshot(false);
+        rebalanceAffinity();
+    }
+    return handle;
+}
+
+SubmitResult ThreadPoolManager::submitTask(const std::string& tenantId, std::unique_ptr<Task> task) {
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
+
+    if (snapshot->sharedScheduler) {
+        return snapshot->sharedScheduler->submitTask(tenantId, std::move(task));
+    }
+
+    auto it = snapshot->groups.find(tenantId);
+    if (it == snapshot->groups.end()) {
+        return SubmitResult::noTenant();
     }
 
-    return it->second->resize(newThreadCount);
+    return it->second->submitTask(std::move(task));
+}
+
+SubmitResult ThreadPoolManager::submitTask(const std::string& tenantId, std::unique_ptr<Task> task, TaskPriority priority) {
+    if (!task) return SubmitResult::noTenant();
+    task->setPriority(priority);
+    return submitTask(tenantId, std::move(task));
 }
 
-bool ThreadPoolManager::submitTask(const std::string& tenantId, std::unique_ptr<Task> task) {
-    std::lock_guard<std::mutex> lock(mutex_);
+bool ThreadPoolManager::spawnTask(const std::string& tenantId, std::unique_ptr<Task> task) {
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
 
-    auto it = tenantGroups_.find(tenantId);
-    if (it == tenantGroups_.end()) {
+    if (snapshot->sharedScheduler) {
+        return snapshot->sharedScheduler->spawnTask(tenantId, std::move(task));
+    }
+
+    auto it = snapshot->groups.find(tenantId);
+    if (it == snapshot->groups.end()) {
         return false;
     }
 
-    return it->second->submitTask(std::move(task));
+    return it->second->spawnTask(std::move(task));
+}
+
+SubmitResult ThreadPoolManager::submitResumable(const std::string& tenantId, std::shared_ptr<ResumableTask> task) {
+    if (!task) {
+        return SubmitResult::noTenant();
+    }
+    // 恢复通常发生在工作线程上（同步回调）或I/O线程上，spawnTask覆盖这两种情况
+    return submitTask(tenantId, task->begin([this, tenantId](std::unique_ptr<Task> segment) {
+        return spawnTask(tenantId, std::move(segment));
+    }));
+}
+
+size_t ThreadPoolManager::submitTasks(const std::string& tenantId, std::vector<std::unique_ptr<Task>>& tasks,
+                                      SubmitResult* rejection) {
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
+
+    if (snapshot->sharedScheduler) {
+        return snapshot->sharedScheduler->submitTasks(tenantId, tasks, rejection);
+    }
+
+    auto it = snapshot->groups.find(tenantId);
+    if (it == snapshot->groups.end()) {
+        if (rejection && !tasks.empty()) {
+            *rejection = SubmitResult::noTenant();
+        }
+        return 0;
+    }
+
+    return it->second->submitTasks(tasks, rejection);
 }
 
 ThreadPoolManager::ThreadGroupInfo ThreadPoolManager::getTenantThreadInfo(const std::string& tenantId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
 
     ThreadGroupInfo info;
 
-    auto it = tenantGroups_.find(tenantId);
-    if (it != tenantGroups_.end()) {
+    if (snapshot->sharedScheduler) {
+        auto stats = snapshot->sharedScheduler->getTenantStats(tenantId);
+        if (stats.exists) {
+            info.totalThreads = snapshot->sharedScheduler->getWorkerCount();
+            info.busyThreads = stats.runningWorkers;
+            info.queueSize = stats.queueSize;
+            info.weight = stats.weight;
+            info.expiredTasks = stats.expiredTasks;
+            info.cancelledTasks = stats.cancelledTasks;
+            info.queuedBytes = stats.queuedBytes;
+            info.rejectedTasks = stats.rejectedTasks;
+            info.queueWait = stats.queueWait;
+            info.runTime = stats.runTime;
+            info.cpuSeconds = stats.cpuTimeNs / 1e9;
+        }
+        return info;
+    }
+
+    auto it = snapshot->groups.find(tenantId);
+    if (it != snapshot->groups.end()) {
         info.totalThreads = it->second->getTotalThreads();
         info.busyThreads = it->second->getBusyThreads();
         info.queueSize = it->second->getQueueSize();
+        info.lentCpuSeconds = it->second->getLentCpuSeconds();
+        info.borrowedCpuSeconds = it->second->getBorrowedCpuSeconds();
+        info.placement = it->second->getCpuPlacement();
+        info.maxThreads = snapshot->threadLimits.at(tenantId);
+        info.expiredTasks = it->second->getExpiredTasks();
+        info.cancelledTasks = it->second->getCancelledTasks();
+        info.queuedBytes = it->second->getQueuedBytes();
+        info.rejectedTasks = it->second->getRejectedTasks();
+        info.queueWait = it->second->getQueueWaitLatency();
+        info.runTime = it->second->getRunLatency();
+        info.cpuSeconds = it->second->getCpuTimeNs() / 1e9;
     }
 
     return info;
 }
 
-ThreadPoolManager::SystemThreadInfo ThreadPoolManager::getSystemThreadInfo() const {
+bool ThreadPoolManager::getTenantCpuTime(const std::string& tenantId, uint64_t& cpuNs) const {
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
+
+    if (snapshot->sharedScheduler) {
+        return snapshot->sharedScheduler->getTenantCpuTime(tenantId, cpuNs);
+    }
+    auto it = snapshot->groups.find(tenantId);
+    if (it == snapshot->groups.end()) {
+        return false;
+    }
+    cpuNs = it->second->getCpuTimeNs();
+    return true;
+}
+
+std::unordered_map<std::string, ThreadAutoscaler::TenantMetrics> ThreadPoolManager::getAutoscaleMetrics() const {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (!autoscaler_) {
+        return {};
+    }
+    return autoscaler_->getMetrics();
+}
 
-    SystemThreadInfo info;
-    info.totalThreads = totalThreads_;
+ThreadPoolManager::SystemThreadInfo ThreadPoolManager::getSystemThreadInfo() const {
+    EpochReclaimer::Guard guard;
+    const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
 
-    info.allocatedThreads = std::accumulate(
-        tenantGroups_.begin(), tenantGroups_.end(), 0UL,
-        [](size_t sum, const auto& pair) {
-            return sum + pair.second->getTotalThreads();
-        });
+    SystemThreadInfo info;
+    info.totalThreads = snapshot->totalThreads;
+
+    if (snapshot->sharedScheduler) {
+        // 共享池中的线程全部用于租户任务
+        info.allocatedThreads = snapshot->sharedScheduler->getWorkerCount();
+    } else {
+        for (const auto& [tenantId, group] : snapshot->groups) {
+            info.allocatedThreads += group->getTotalThreads();
+        }
+    }
 
     // 系统线程数（预留给系统任务）
-    info.systemThreads = totalThreads_ - info.allocatedThreads;
+    info.systemThreads = info.totalThreads - std::min(info.totalThreads, info.allocatedThreads);
 
     return info;
 }
 
-} // namespace yao
\ No newline at end of file
+} // namespace yao
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "core/resource/TenantThreadGroup.h"
+#include "core/resource/WeightedFairScheduler.h"
+#include "core/resource/ThreadBorrowBroker.h"
+#include "core/resource/AffinityPlanner.h"
 #include "core/resource/CgroupController.h"
+#include "core/resource/ResumableTask.h"
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <mutex>
 #include <algorithm>
@@ -12,7 +18,21 @@ namespace yao {
 
 /**
  * @brief 线程池管理器
- * 管理全局线程池和租户线程组分配
+ * 管理全局线程池和租户线程组分配。
+ * Dedicated模式下每个租户独占threadCount个线程；Shared模式下totalThreads个
+ * 工作线程由所有租户共享，threadCount作为租户的调度权重。
+ *
+ * 提交任务与查询信息走无锁路径：租户表以不可变快照（Snapshot）发布，
+ * 创建/删除/调整时在mutex_内复制出新快照并原子替换，旧快照交给
+ * EpochReclaimer回收；读者只在EpochReclaimer::Guard内读取快照。
+ *
+ * 开启thread_affinity时，每次创建/删除/调整租户后由AffinityPlanner按
+ * /sys/devices/system 中的NUMA节点与末级缓存拓扑重新规划，把各租户线程
+ * 绑定到紧凑的CPU集合。
+ *
+ * 开启thread_autoscale时，createTenantThreadGroup/resizeTenantThreads给出的
+ * 线程数作为租户上限（按上限占用totalThreads），ThreadAutoscaler在
+ * [minThreads, 上限] 之间按队列积压与忙碌比例调整实际线程数。
  */
 class ThreadPoolManager {
 public:
@@ -22,9 +42,11 @@ public:
      * @brief 初始化线程池
      * @param totalThreads 总线程数（默认120）
      * @param enableCgroup 是否启用cgroup
+     * @param groupOptions 租户线程组配置（调度方式、队列引擎等）
      * @return 是否成功
      */
-    bool initialize(size_t totalThreads = 120, bool enableCgroup = false);
+    bool initialize(size_t totalThreads = 120, bool enableCgroup = false,
+                    const ThreadGroupOptions& groupOptions = ThreadGroupOptions());
 
     /**
      * @brief 关闭线程池
@@ -34,33 +56,73 @@ public:
     /**
      * @brief 创建租户线程组
      * @param tenantId 租户ID
-     * @param threadCount 分配的线程数
+     * @param threadCount 分配的线程数（Shared模式下为调度权重）
      * @return 是否成功
      */
     bool createTenantThreadGroup(const std::string& tenantId, size_t threadCount);
 
     /**
-     * @brief 删除租户线程组
+     * @brief 删除租户线程组，等待其正在执行的任务结束后返回
+     * 等待期间不持有mutex_，该租户在返回前不能重新创建
      * @param tenantId 租户ID
      * @return 是否成功
      */
     bool removeTenantThreadGroup(const std::string& tenantId);
 
     /**
-     * @brief 调整租户线程数
+     * @brief 调整租户线程数，不等待被移除的线程退出
+     * 被移除的线程在执行完当前任务后自行退出，期间不占用mutex_
      * @param tenantId 租户ID
-     * @param newThreadCount 新的线程数
-     * @return 是否成功
+     * @param newThreadCount 新的线程数（Shared模式下为调度权重）
+     * @return 完成句柄，租户不存在或线程不足时为false
      */
-    bool resizeTenantThreads(const std::string& tenantId, size_t newThreadCount);
+    ResizeHandle resizeTenantThreads(const std::string& tenantId, size_t newThreadCount);
 
     /**
      * @brief 提交任务到租户队列
      * @param tenantId 租户ID
      * @param task 任务
+     * @return 租户不存在或超过排队限额时拒绝，限流拒绝带建议的重试时间
+     */
+    SubmitResult submitTask(const std::string& tenantId, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 以指定优先级通道提交任务到租户队列
+     * @param tenantId 租户ID
+     * @param task 任务
+     * @param priority 通道提示，覆盖任务原有优先级（未开启优先级通道时不影响顺序）
+     * @return 提交结果
+     */
+    SubmitResult submitTask(const std::string& tenantId, std::unique_ptr<Task> task, TaskPriority priority);
+
+    /**
+     * @brief 从租户任务内派生后续任务
+     * Dedicated模式下在本租户工作线程上调用时放入当前线程的本地队列，
+     * 其他情况进入租户队列；派生任务属于已准入的请求，不受排队限额拒绝
+     * @param tenantId 租户ID
+     * @param task 任务
      * @return 是否成功
      */
-    bool submitTask(const std::string& tenantId, std::unique_ptr<Task> task);
+    bool spawnTask(const std::string& tenantId, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 提交可挂起任务，之后每次恢复的段同样进入该租户的队列
+     * 第一段经过准入控制，恢复的段按派生任务处理
+     * @param tenantId 租户ID
+     * @param task 任务
+     * @return 第一段的提交结果
+     */
+    SubmitResult submitResumable(const std::string& tenantId, std::shared_ptr<ResumableTask> task);
+
+    /**
+     * @brief 批量提交任务到租户队列
+     * @param tenantId 租户ID
+     * @param tasks 任务列表，未能入队的任务保留在其中
+     * @param rejection 输出，有任务被拒绝时为拒绝原因，可为空
+     * @return 成功提交的任务数量
+     */
+    size_t submitTasks(const std::string& tenantId, std::vector<std::unique_ptr<Task>>& tasks,
+                       SubmitResult* rejection = nullptr);
 
     /**
      * @brief 获取租户线程组信息
@@ -68,12 +130,39 @@ public:
      * @return 线程组信息
      */
     struct ThreadGroupInfo {
-        size_t totalThreads = 0;
-        size_t busyThreads = 0;
+        size_t totalThreads = 0;   ///< Shared模式下为共享工作线程总数
+        size_t busyThreads = 0;    ///< Shared模式下为正在执行该租户任务的线程数
         size_t queueSize = 0;
+        size_t weight = 0;         ///< 调度权重，仅Shared模式有效
+        double lentCpuSeconds = 0;      ///< 本租户空闲线程借给其他租户的CPU时间
+        double borrowedCpuSeconds = 0;  ///< 本租户借用其他租户线程的CPU时间
+        CpuPlacement placement;         ///< 线程绑定的CPU及NUMA节点，未开启亲和性时为空
+        size_t maxThreads = 0;          ///< 配额对应的线程数上限，自动伸缩不超过该值
+        size_t expiredTasks = 0;        ///< 出队时已超过截止时间而丢弃的任务数
+        size_t cancelledTasks = 0;      ///< 出队时已被取消而丢弃的任务数
+        size_t queuedBytes = 0;         ///< 计入排队限额的字节数
+        size_t rejectedTasks = 0;       ///< 超过排队限额被拒绝的任务数
+        LatencySummary queueWait;       ///< 任务从提交到开始执行的等待时长（p50/p99/p999）
+        LatencySummary runTime;         ///< 任务execute()的执行时长（p50/p99/p999）
+        double cpuSeconds = 0;          ///< 执行该租户任务消耗的CPU时间
     };
     ThreadGroupInfo getTenantThreadInfo(const std::string& tenantId) const;
 
+    /**
+     * @brief 获取执行该租户任务消耗的累计CPU时间
+     * Dedicated模式下读取线程组各线程的CPU时钟，Shared模式下取调度器按批计入的CPU时间
+     * @param tenantId 租户ID
+     * @param cpuNs 输出，纳秒
+     * @return 租户是否存在
+     */
+    bool getTenantCpuTime(const std::string& tenantId, uint64_t& cpuNs) const;
+
+    /**
+     * @brief 获取cgroup控制器，未启用cgroup时为空
+     * 资源管理器只保存弱引用：shutdown()释放控制器（并删除租户cgroup）后它们退化为只记账
+     */
+    std::shared_ptr<CgroupController> getCgroupController() const { return cgroupController_; }
+
     /**
      * @brief 获取系统线程信息
      */
@@ -84,19 +173,68 @@ public:
     };
     SystemThreadInfo getSystemThreadInfo() const;
 
+    /**
+     * @brief 获取自动伸缩指标，未开启自动伸缩时为空
+     */
+    std::unordered_map<std::string, ThreadAutoscaler::TenantMetrics> getAutoscaleMetrics() const;
+
 private:
-    ThreadPoolManager() = default;
-    ~ThreadPoolManager() { shutdown(); }
+    /**
+     * @brief 租户表的不可变快照，发布后不再修改
+     */
+    struct Snapshot {
+        std::unordered_map<std::string, TenantThreadGroup*> groups;
+        std::unordered_map<std::string, size_t> threadLimits;
+        WeightedFairScheduler* sharedScheduler = nullptr;
+        size_t totalThreads = 0;
+    };
+
+    ThreadPoolManager();
+    ~ThreadPoolManager();
 
     ThreadPoolManager(const ThreadPoolManager&) = delete;
     ThreadPoolManager& operator=(const ThreadPoolManager&) = delete;
 
-    mutable std::mutex mutex_;
+    /**
+     * @brief 根据当前状态生成并发布新快照，旧快照延迟回收（需持有mutex_）
+     * @param waitForReaders 是否等待持有旧快照的读者全部退出后再返回
+     */
+    void publishSnapshot(bool waitForReaders);
+
+    /**
+     * @brief 自动伸缩采样回调：各租户线程组的当前状态
+     */
+    std::vector<ThreadAutoscaler::Sample> sampleTenantGroups() const;
+
+    /**
+     * @brief 自动伸缩调整回调：在租户上限内调整线程数
+     */
+    bool autoscaleTenantThreads(const std::string& tenantId, size_t threadCount);
+
+    /**
+     * @brief 已分配给租户线程组的线程总数，按租户上限计（需持有mutex_）
+     */
+    size_t allocatedThreads(const std::string& excludeTenantId = std::string()) const;
+
+    /**
+     * @brief 按当前租户线程数重新规划并应用CPU亲和性（需持有mutex_）
+     */
+    void rebalanceAffinity();
+
+    mutable std::mutex mutex_;   ///< 串行化写操作，读路径不加锁
+    std::atomic<const Snapshot*> snapshot_;
     size_t totalThreads_ = 0;
     bool initialized_ = false;
     bool cgroupEnabled_ = false;
-    std::unique_ptr<CgroupController> cgroupController_;
+    ThreadGroupOptions groupOptions_;
+    std::shared_ptr<CgroupController> cgroupController_;
     std::unordered_map<std::string, std::unique_ptr<TenantThreadGroup>> tenantGroups_;
+    std::unordered_map<std::string, size_t> threadLimits_;   ///< 租户线程数上限（配额对应的线程数）
+    std::unordered_set<std::string> removingTenants_;         ///< 已摘除、正在锁外停止线程的租户
+    std::unique_ptr<WeightedFairScheduler> sharedScheduler_;  ///< 仅Shared模式使用
+    std::unique_ptr<ThreadBorrowBroker> borrowBroker_;        ///< 仅Dedicated模式且开启借用时使用
+    std::unique_ptr<AffinityPlanner> affinityPlanner_;        ///< 仅Dedicated模式且开启亲和性时使用
+    std::unique_ptr<ThreadAutoscaler> autoscaler_;            ///< 仅Dedicated模式且开启自动伸缩时使用
 };
 
 } // namespace yao
\ No newline at end of file
@@ -0,0 +1,323 @@
+#include "core/resource/WeightedFairScheduler.h"
+#include "core/resource/TaskBatch.h"
+#include "core/resource/ThreadCpuClock.h"
+#include <algorithm>
+
+namespace yao {
+
+WeightedFairScheduler::WeightedFairScheduler(size_t workerCount, const ThreadGroupOptions& options)
+    : options_(options), workerCount_(std::max<size_t>(workerCount, 1)) {
+    options_.dequeueBatchSize = std::max<size_t>(options_.dequeueBatchSize, 1);
+}
+
+WeightedFairScheduler::~WeightedFairScheduler() {
+    stop();
+}
+
+bool WeightedFairScheduler::start() {
+    if (running_.exchange(true)) return true;
+
+    workers_.reserve(workerCount_);
+    for (size_t i = 0; i < workerCount_; ++i) {
+        workers_.emplace_back(&WeightedFairScheduler::workerLoop, this);
+    }
+    return true;
+}
+
+void WeightedFairScheduler::stop() {
+    if (!running_.exchange(false)) return;
+
+    wakeup_.notifyAll();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+uint64_t WeightedFairScheduler::strideFor(size_t weight) {
+    return kStrideBase / std::max<size_t>(weight, 1);
+}
+
+bool WeightedFairScheduler::addTenant(const std::string& tenantId, size_t weight) {
+    auto entry = std::make_shared<TenantEntry>();
+    entry->tenantId = tenantId;
+    entry->queue = options_.makeTaskQueue();
+    entry->admission = std::make_unique<AdmissionController>(options_.admissionLimits());
+    entry->weight = std::max<size_t>(weight, 1);
+    entry->stride = strideFor(entry->weight);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entry->pass = virtualTime_;
+    return tenants_.emplace(tenantId, std::move(entry)).second;
+}
+
+bool WeightedFairScheduler::removeTenant(const std::string& tenantId) {
+    EntryPtr entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tenants_.find(tenantId);
+        if (it == tenants_.end()) {
+            return false;
+        }
+        entry = std::move(it->second);
+        tenants_.erase(it);
+
+        entry->removed = true;
+        if (entry->scheduled.load()) {
+            runQueue_.erase({entry->pass, entry.get()});
+            entry->scheduled.store(false);
+            activeTenants_.fetch_sub(1);
+        }
+    }
+    // 正在执行该租户任务的工作线程持有自己的引用，队列在其结束后释放
+    return true;
+}
+
+bool WeightedFairScheduler::setWeight(const std::string& tenantId, size_t weight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenantId);
+    if (it == tenants_.end()) {
+        return false;
+    }
+
+    TenantEntry& entry = *it->second;
+    entry.weight = std::max<size_t>(weight, 1);
+    entry.stride = strideFor(entry.weight);
+    return true;
+}
+
+SubmitResult WeightedFairScheduler::submitTask(const std::string& tenantId, std::unique_ptr<Task> task) {
+    EntryPtr entry = findTenant(tenantId);
+    if (!entry) {
+        return SubmitResult::noTenant();
+    }
+    if (task) {
+        task->markEnqueued(std::chrono::steady_clock::now());
+    }
+    SubmitResult result = entry->admission->submit(*entry->queue, std::move(task));
+    if (!result) {
+        return result;
+    }
+    activate(*entry);
+    wakeup_.notify();
+    return result;
+}
+
+bool WeightedFairScheduler::spawnTask(const std::string& tenantId, std::unique_ptr<Task> task) {
+    EntryPtr entry = findTenant(tenantId);
+    if (entry && task) {
+        task->markEnqueued(std::chrono::steady_clock::now());
+    }
+    if (!entry || !entry->admission->submitCharged(*entry->queue, std::move(task))) {
+        return false;
+    }
+    activate(*entry);
+    wakeup_.notify();
+    return true;
+}
+
+size_t WeightedFairScheduler::submitTasks(const std::string& tenantId, std::vector<std::unique_ptr<Task>>& tasks,
+                                          SubmitResult* rejection) {
+    EntryPtr entry = findTenant(tenantId);
+    if (!entry) {
+        if (rejection && !tasks.empty()) {
+            *rejection = SubmitResult::noTenant();
+        }
+        return 0;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& task : tasks) {
+        if (task) task->markEnqueued(now);
+    }
+    size_t submitted = entry->admission->submitBulk(*entry->queue, tasks, rejection);
+    if (submitted > 0) {
+        activate(*entry);
+        if (submitted == 1) {
+            wakeup_.notify();
+        } else {
+            wakeup_.notifyAll();
+        }
+    }
+    return submitted;
+}
+
+WeightedFairScheduler::TenantStats WeightedFairScheduler::getTenantStats(const std::string& tenantId) const {
+    TenantStats stats;
+    EntryPtr entry = findTenant(tenantId);
+    if (!entry) {
+        return stats;
+    }
+
+    stats.exists = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.weight = entry->weight;
+    }
+    stats.queueSize = entry->queue->size();
+    stats.runningWorkers = entry->runningWorkers.load();
+    stats.executedTasks = entry->executedTasks.load();
+    stats.expiredTasks = entry->expiredTasks.load();
+    stats.cancelledTasks = entry->cancelledTasks.load();
+    stats.queuedBytes = entry->admission->getQueuedBytes();
+    stats.rejectedTasks = entry->admission->getRejectedTasks();
+    stats.queueWait = entry->queueWaitHistogram.summarize();
+    stats.runTime = entry->runHistogram.summarize();
+    stats.cpuTimeNs = entry->cpuNs.load();
+    return stats;
+}
+
+bool WeightedFairScheduler::getTenantCpuTime(const std::string& tenantId, uint64_t& cpuNs) const {
+    EntryPtr entry = findTenant(tenantId);
+    if (!entry) {
+        return false;
+    }
+    cpuNs = entry->cpuNs.load();
+    return true;
+}
+
+size_t WeightedFairScheduler::getWorkerCount() const {
+    return workerCount_;
+}
+
+size_t WeightedFairScheduler::getBusyWorkers() const {
+    return busyWorkers_.load();
+}
+
+size_t WeightedFairScheduler::getTenantCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tenants_.size();
+}
+
+WeightedFairScheduler::EntryPtr WeightedFairScheduler::findTenant(const std::string& tenantId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenantId);
+    return it != tenants_.end() ? it->second : nullptr;
+}
+
+void WeightedFairScheduler::activate(TenantEntry& entry) {
+    // 与deactivateIfIdle配对：入队后再读scheduled，对方清除scheduled后再读队列，
+    // 两边至少有一方能看到对方的写入，不会出现有任务却不在运行队列中的情况
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (entry.scheduled.load()) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entry.removed || entry.scheduled.load()) return;
+
+    // 空闲期间不积累份额，从当前虚拟时间开始参与调度
+    entry.pass = std::max(entry.pass, virtualTime_);
+    runQueue_.emplace(entry.pass, &entry);
+    entry.scheduled.store(true);
+    activeTenants_.fetch_add(1);
+}
+
+void WeightedFairScheduler::deactivateIfIdle(TenantEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entry.removed || !entry.scheduled.load()) return;
+
+    entry.scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!entry.queue->empty()) {
+        entry.scheduled.store(true);  // 期间有新任务到来，继续留在运行队列
+        return;
+    }
+    runQueue_.erase({entry.pass, &entry});
+    activeTenants_.fetch_sub(1);
+}
+
+WeightedFairScheduler::EntryPtr WeightedFairScheduler::pickTenant() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (runQueue_.empty()) {
+        return nullptr;
+    }
+
+    auto it = runQueue_.begin();
+    TenantEntry* entry = it->second;
+    runQueue_.erase(it);
+
+    // 先计入时间片再执行，其他工作线程可以同时选择下一个租户
+    virtualTime_ = entry->pass;
+    entry->pass += entry->stride;
+    runQueue_.emplace(entry->pass, entry);
+    return entry->shared_from_this();
+}
+
+void WeightedFairScheduler::chargeCpu(TenantEntry& entry, uint64_t cpuNs) {
+    uint64_t cost = static_cast<uint64_t>(static_cast<double>(entry.stride) * cpuNs / kQuantumNs);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entry.removed) return;
+
+    bool queued = entry.scheduled.load();
+    if (queued) {
+        runQueue_.erase({entry.pass, &entry});
+    }
+    // pickTenant已预计一个时间片，这里按实际消耗的CPU时间多退少补
+    if (cost >= entry.stride) {
+        entry.pass += cost - entry.stride;
+    } else {
+        entry.pass -= std::min(entry.pass, entry.stride - cost);
+    }
+    if (queued) {
+        runQueue_.emplace(entry.pass, &entry);
+    }
+}
+
+void WeightedFairScheduler::waitForWork() {
+    if (options_.idleSpin.count() > 0) {
+        auto deadline = std::chrono::steady_clock::now() + options_.idleSpin;
+        for (unsigned spins = 0; running_; ++spins) {
+            if (activeTenants_.load() > 0) return;
+            cpuRelax();
+            if ((spins & 63) == 63 && std::chrono::steady_clock::now() >= deadline) break;
+        }
+    }
+
+    EventCount::Key key = wakeup_.prepareWait();
+    if (!running_ || activeTenants_.load() > 0) {
+        wakeup_.cancelWait();
+        return;
+    }
+    wakeup_.wait(key);
+}
+
+void WeightedFairScheduler::workerLoop() {
+    std::vector<std::unique_ptr<Task>> batch;
+    batch.reserve(options_.dequeueBatchSize);
+
+    while (running_) {
+        EntryPtr entry = pickTenant();
+        if (!entry) {
+            waitForWork();
+            continue;
+        }
+
+        batch.clear();
+        if (entry->queue->dequeueBulk(batch, options_.dequeueBatchSize) == 0) {
+            deactivateIfIdle(*entry);
+            continue;
+        }
+
+        busyWorkers_.fetch_add(1);
+        entry->runningWorkers.fetch_add(1);
+        // 工作线程由所有租户共享，按批计入执行该租户任务的CPU时间；执行数逐个计入
+        uint64_t cpuStart = threadCpuTimeNs();
+        executeTaskBatch(batch, *entry->admission,
+                         TaskBatchMetrics{entry->expiredTasks, entry->cancelledTasks, entry->queueWaitHistogram,
+                                          entry->runHistogram, &entry->executedTasks},
+                         entry->tenantId);
+        uint64_t cpuNs = threadCpuTimeNs() - cpuStart;
+        entry->cpuNs.fetch_add(cpuNs);
+        entry->runningWorkers.fetch_sub(1);
+        busyWorkers_.fetch_sub(1);
+        chargeCpu(*entry, cpuNs);
+
+        if (entry->queue->empty()) {
+            deactivateIfIdle(*entry);
+        }
+    }
+}
+
+} // namespace yao
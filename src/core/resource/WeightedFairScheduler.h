@@ -0,0 +1,197 @@
+#pragma once
+
+#include "core/resource/TenantThreadGroup.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yao {
+
+/**
+ * @brief 共享工作线程池的加权公平调度器
+ * 所有租户共用一组工作线程，每个租户只有自己的任务队列。
+ * 工作线程按步幅调度（stride scheduling）选择下一个租户：每个租户有一个
+ * pass值，每次被选中时预先增加kStrideBase / weight（一个时间片），取走的一批
+ * 任务（最多dequeueBatchSize个）执行完后按实际消耗的CPU时间折算时间片数修正
+ * pass。始终选择pass最小的租户，因此各租户获得的CPU时间与权重成正比，与单个
+ * 任务的长短无关。没有任务的租户不在运行队列中，空闲份额自动分给其他租户。
+ */
+class WeightedFairScheduler {
+public:
+    /**
+     * @brief 租户调度统计
+     */
+    struct TenantStats {
+        bool exists = false;
+        size_t weight = 0;
+        size_t queueSize = 0;
+        size_t runningWorkers = 0;   ///< 正在执行该租户任务的工作线程数
+        size_t executedTasks = 0;
+        size_t expiredTasks = 0;     ///< 出队时已超时而丢弃的任务数
+        size_t cancelledTasks = 0;   ///< 出队时已取消而丢弃的任务数
+        size_t queuedBytes = 0;      ///< 计入排队限额的字节数
+        size_t rejectedTasks = 0;    ///< 超过排队限额被拒绝的任务数
+        LatencySummary queueWait;    ///< 从提交到开始执行的等待时长
+        LatencySummary runTime;      ///< execute()执行时长
+        uint64_t cpuTimeNs = 0;      ///< 执行该租户任务消耗的CPU时间（纳秒）
+    };
+
+    WeightedFairScheduler(size_t workerCount, const ThreadGroupOptions& options = ThreadGroupOptions());
+    ~WeightedFairScheduler();
+
+    WeightedFairScheduler(const WeightedFairScheduler&) = delete;
+    WeightedFairScheduler& operator=(const WeightedFairScheduler&) = delete;
+
+    /**
+     * @brief 启动工作线程
+     */
+    bool start();
+
+    /**
+     * @brief 停止工作线程，队列中未执行的任务保留
+     */
+    void stop();
+
+    /**
+     * @brief 注册租户
+     * @param tenantId 租户ID
+     * @param weight 调度权重（通常取CPU配额），最小为1
+     * @return 租户已存在时返回false
+     */
+    bool addTenant(const std::string& tenantId, size_t weight);
+
+    /**
+     * @brief 注销租户，丢弃其未执行的任务
+     */
+    bool removeTenant(const std::string& tenantId);
+
+    /**
+     * @brief 调整租户权重
+     */
+    bool setWeight(const std::string& tenantId, size_t weight);
+
+    /**
+     * @brief 提交任务到租户队列
+     * @return 租户不存在或超过排队限额时拒绝
+     */
+    SubmitResult submitTask(const std::string& tenantId, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 提交已准入请求派生的后续任务，计入排队限额但不会被拒绝
+     */
+    bool spawnTask(const std::string& tenantId, std::unique_ptr<Task> task);
+
+    /**
+     * @brief 批量提交任务到租户队列
+     * @param tasks 任务列表，未能入队的任务保留在其中
+     * @param rejection 输出，有任务被拒绝时为拒绝原因，可为空
+     * @return 成功提交的任务数量
+     */
+    size_t submitTasks(const std::string& tenantId, std::vector<std::unique_ptr<Task>>& tasks,
+                       SubmitResult* rejection = nullptr);
+
+    /**
+     * @brief 获取租户调度统计
+     */
+    TenantStats getTenantStats(const std::string& tenantId) const;
+
+    /**
+     * @brief 获取执行该租户任务消耗的CPU时间，不汇总延迟分布
+     * @param tenantId 租户ID
+     * @param cpuNs 输出，纳秒
+     * @return 租户是否存在
+     */
+    bool getTenantCpuTime(const std::string& tenantId, uint64_t& cpuNs) const;
+
+    /**
+     * @brief 获取工作线程数
+     */
+    size_t getWorkerCount() const;
+
+    /**
+     * @brief 获取正在执行任务的工作线程数
+     */
+    size_t getBusyWorkers() const;
+
+    /**
+     * @brief 获取注册的租户数
+     */
+    size_t getTenantCount() const;
+
+private:
+    /// 权重为1的租户每个时间片的pass增量
+    static constexpr uint64_t kStrideBase = 1u << 20;
+    /// 一个时间片对应的CPU时间
+    static constexpr uint64_t kQuantumNs = 1000000;
+
+    struct TenantEntry : std::enable_shared_from_this<TenantEntry> {
+        std::string tenantId;
+        std::unique_ptr<TaskQueue> queue;
+        std::unique_ptr<AdmissionController> admission;
+        size_t weight = 1;
+        uint64_t stride = kStrideBase;
+        uint64_t pass = 0;                     ///< 受mutex_保护
+        bool removed = false;                  ///< 受mutex_保护
+        std::atomic<bool> scheduled{false};    ///< 是否在运行队列中，只在mutex_内修改
+        std::atomic<size_t> runningWorkers{0};
+        std::atomic<size_t> executedTasks{0};
+        std::atomic<size_t> expiredTasks{0};
+        std::atomic<size_t> cancelledTasks{0};
+        LatencyHistogram queueWaitHistogram;
+        LatencyHistogram runHistogram;
+        std::atomic<uint64_t> cpuNs{0};        ///< 共享线程执行本租户任务的CPU时间
+    };
+    using EntryPtr = std::shared_ptr<TenantEntry>;
+
+    void workerLoop();
+
+    /**
+     * @brief 取出pass最小的租户并预先计入一个时间片
+     * @return 运行队列为空时返回nullptr
+     */
+    EntryPtr pickTenant();
+
+    /**
+     * @brief 按一批任务实际消耗的CPU时间修正租户的pass
+     * @param cpuNs 本批在工作线程上消耗的CPU时间
+     */
+    void chargeCpu(TenantEntry& entry, uint64_t cpuNs);
+
+    /**
+     * @brief 提交任务后把租户放入运行队列
+     */
+    void activate(TenantEntry& entry);
+
+    /**
+     * @brief 租户队列已空时将其移出运行队列
+     */
+    void deactivateIfIdle(TenantEntry& entry);
+
+    void waitForWork();
+
+    EntryPtr findTenant(const std::string& tenantId) const;
+
+    static uint64_t strideFor(size_t weight);
+
+    ThreadGroupOptions options_;
+    size_t workerCount_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, EntryPtr> tenants_;
+    std::set<std::pair<uint64_t, TenantEntry*>> runQueue_;
+    uint64_t virtualTime_ = 0;               ///< 最近一次被选中租户的pass，新激活租户从这里起步
+    std::atomic<size_t> activeTenants_{0};   ///< 运行队列长度，供工作线程无锁判断是否有活
+
+    EventCount wakeup_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> busyWorkers_{0};
+};
+
+} // namespace yao
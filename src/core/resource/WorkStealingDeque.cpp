@@ -0,0 +1,93 @@
+#include "core/resource/WorkStealingDeque.h"
+#include <algorithm>
+
+namespace yao {
+
+namespace {
+
+int64_t roundUpToPowerOfTwo(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return static_cast<int64_t>(size);
+}
+
+} // namespace
+
+WorkStealingDeque::WorkStealingDeque(size_t capacity)
+    : mask_(roundUpToPowerOfTwo(capacity) - 1)
+    , slots_(new std::atomic<Task*>[static_cast<size_t>(mask_ + 1)]) {
+    for (int64_t i = 0; i <= mask_; ++i) {
+        slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+    while (pop()) {
+    }
+}
+
+bool WorkStealingDeque::push(std::unique_ptr<Task>& task) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+        return false;
+    }
+
+    slots_[bottom & mask_].store(task.release(), std::memory_order_relaxed);
+    // 先写槽位再发布bottom，窃取者看到新的bottom时一定能读到任务
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+}
+
+std::unique_ptr<Task> WorkStealingDeque::pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    // 先占住底部槽位再读top，与steal中先读top再读bottom配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Task* task = slots_[bottom & mask_].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // 只剩最后一个任务，与窃取者竞争
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return std::unique_ptr<Task>(task);
+}
+
+std::unique_ptr<Task> WorkStealingDeque::steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    Task* task = slots_[top & mask_].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return std::unique_ptr<Task>(task);
+}
+
+size_t WorkStealingDeque::size() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return static_cast<size_t>(std::max<int64_t>(bottom - top, 0));
+}
+
+bool WorkStealingDeque::empty() const {
+    return size() == 0;
+}
+
+} // namespace yao
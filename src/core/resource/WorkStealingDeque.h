@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/resource/TaskQueue.h"
+#include "common/utils/CacheLine.h"
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace yao {
+
+/**
+ * @brief 工作线程本地的定长工作窃取双端队列（Chase-Lev）
+ * 只有所属工作线程调用push/pop，在底部按后进先出存取，保持缓存局部性；
+ * 同组其他空闲线程调用steal从顶部按先进先出窃取。
+ * 队列不扩容，满时push返回false，由调用方转投线程组的共享队列。
+ */
+class WorkStealingDeque {
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 队列容量，向上取整为2的幂
+     */
+    explicit WorkStealingDeque(size_t capacity = 256);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief 压入底部（仅所属线程调用）
+     * @param task 任务，队列满时保留在task中
+     * @return 是否成功
+     */
+    bool push(std::unique_ptr<Task>& task);
+
+    /**
+     * @brief 从底部弹出最近压入的任务（仅所属线程调用）
+     * @return 任务指针，队列为空时返回nullptr
+     */
+    std::unique_ptr<Task> pop();
+
+    /**
+     * @brief 从顶部窃取最早压入的任务（任意线程调用）
+     * @return 任务指针，队列为空或与其他线程竞争失败时返回nullptr
+     */
+    std::unique_ptr<Task> steal();
+
+    /**
+     * @brief 获取队列大小（近似值）
+     */
+    size_t size() const;
+
+    /**
+     * @brief 检查队列是否为空（近似值）
+     */
+    bool empty() const;
+
+    /**
+     * @brief 获取队列容量
+     */
+    size_t capacity() const { return static_cast<size_t>(mask_ + 1); }
+
+private:
+    const int64_t mask_;
+    std::unique_ptr<std::atomic<Task*>[]> slots_;
+    alignas(kCacheLineSize) std::atomic<int64_t> top_{0};     ///< 窃取端
+    alignas(kCacheLineSize) std::atomic<int64_t> bottom_{0};  ///< 所属线程端
+};
+
+} // namespace yao
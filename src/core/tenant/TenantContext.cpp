@@ -5,6 +5,7 @@ namespace yao {
 TenantContext::TenantContext(std::string tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota)
     : m_tenantId(std::move(tenantId))
     , m_cpuQuota(cpuQuota)
+    , m_cpuMillicores(cpuQuota * 1000)
     , m_memoryQuota(memoryQuota)
     , m_diskQuota(diskQuota) {
 }
@@ -17,6 +18,10 @@ int TenantContext::getCpuQuota() const {
     return m_cpuQuota;
 }
 
+int TenantContext::getCpuQuotaMillicores() const {
+    return m_cpuMillicores;
+}
+
 size_t TenantContext::getMemoryQuota() const {
     return m_memoryQuota;
 }
@@ -27,6 +32,12 @@ size_t TenantContext::getDiskQuota() const {
 
 void TenantContext::setCpuQuota(int quota) {
     m_cpuQuota = quota;
+    m_cpuMillicores = quota * 1000;
+}
+
+void TenantContext::setCpuQuotaMillicores(int millicores) {
+    m_cpuMillicores = millicores;
+    m_cpuQuota = millicores > 0 ? (millicores + 999) / 1000 : millicores;
 }
 
 void TenantContext::setMemoryQuota(size_t quota) {
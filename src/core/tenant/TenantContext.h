@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 
@@ -28,10 +29,16 @@ public:
 
     /**
      * @brief 获取CPU配额
-     * @return CPU配额
+     * @return CPU配额（核心数，不足一核的部分向上取整）
      */
     int getCpuQuota() const;
 
+    /**
+     * @brief 获取CPU配额
+     * @return CPU配额（千分之一核，1000表示一个核心）
+     */
+    int getCpuQuotaMillicores() const;
+
     /**
      * @brief 获取内存配额
      * @return 内存配额
@@ -46,10 +53,16 @@ public:
 
     /**
      * @brief 设置CPU配额
-     * @param quota CPU配额
+     * @param quota CPU配额（核心数）
      */
     void setCpuQuota(int quota);
 
+    /**
+     * @brief 以千分之一核为单位设置CPU配额
+     * @param millicores CPU配额，如1500表示1.5个核心
+     */
+    void setCpuQuotaMillicores(int millicores);
+
     /**
      * @brief 设置内存配额
      * @param quota 内存配额
@@ -64,7 +77,8 @@ public:
 
 private:
     std::string m_tenantId;      ///< 租户ID
-    int m_cpuQuota;              ///< CPU配额
+    std::atomic<int> m_cpuQuota;       ///< CPU配额（核心数），CpuMonitor采样时无锁读取
+    std::atomic<int> m_cpuMillicores;  ///< CPU配额（千分之一核）
     size_t m_memoryQuota;        ///< 内存配额
     size_t m_diskQuota;          ///< 磁盘配额
 };
@@ -4,21 +4,39 @@
 #include "core/resource/DiskResourceManager.h"
 #include "core/resource/ThreadPoolManager.h"
 #include "core/resource/CpuMonitor.h"
+#include "core/resource/PressureMonitor.h"
 #include <stdexcept>
 
 namespace yao {
 
+namespace {
+
+/**
+ * @brief 租户线程组大小：每核心10个线程，不足一核的部分按比例向上取整
+ */
+size_t threadCountFor(int cpuMillicores) {
+    return cpuMillicores > 0 ? static_cast<size_t>(cpuMillicores + 99) / 100 : 0;
+}
+
+} // namespace
+
 TenantManager& TenantManager::getInstance() {
     static TenantManager instance;
     return instance;
 }
 
 bool TenantManager::createTenant(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota) {
+    return createTenantMillicores(tenantId, cpuQuota * 1000, memoryQuota, diskQuota);
+}
+
+bool TenantManager::createTenantMillicores(const std::string& tenantId, int cpuMillicores,
+                                           size_t memoryQuota, size_t diskQuota) {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (m_tenants.find(tenantId) != m_tenants.end()) {
         return false;  // 租户已存在
     }
-    auto tenant = std::make_shared<TenantContext>(tenantId, cpuQuota, memoryQuota, diskQuota);
+    auto tenant = std::make_shared<TenantContext>(tenantId, 0, memoryQuota, diskQuota);
+    tenant->setCpuQuotaMillicores(cpuMillicores);
     m_tenants[tenantId] = tenant;
 
     // 分配CPU资源
@@ -43,10 +61,10 @@ bool TenantManager::createTenant(const std::string& tenantId, int cpuQuota, size
     }
 
     // 注册监控
-    CpuMonitor::getInstance().registerTenant(tenantId);
+    CpuMonitor::getInstance().registerTenant(tenant);
 
-    // 创建租户线程组（假设每核心10个线程）
-    size_t threadCount = static_cast<size_t>(cpuQuota) * 10;
+    // 创建租户线程组
+    size_t threadCount = threadCountFor(cpuMillicores);
     if (!ThreadPoolManager::getInstance().createTenantThreadGroup(tenantId, threadCount)) {
         CpuResourceManager::getInstance().releaseCpuResource(tenantId);
         MemoryResourceManager::getInstance().releaseMemoryResource(tenantId);
@@ -80,26 +98,32 @@ bool TenantManager::removeTenant(const std::string& tenantId) {
     MemoryResourceManager::getInstance().releaseMemoryResource(tenantId);
     DiskResourceManager::getInstance().releaseDiskResource(tenantId);
     CpuMonitor::getInstance().unregisterTenant(tenantId);
+    // SqlServer在首次分配时注册PSI采样，删除时关闭其cgroup压力文件
+    PressureMonitor::getInstance().unregisterTenant(tenantId);
     ThreadPoolManager::getInstance().removeTenantThreadGroup(tenantId);
 
     return m_tenants.erase(tenantId) > 0;
 }
 
-bool TenantManager::updateTenantQuota(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota) {
+ResizeHandle TenantManager::updateTenantQuota(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota) {
+    return updateTenantQuotaMillicores(tenantId, cpuQuota * 1000, memoryQuota, diskQuota);
+}
+
+ResizeHandle TenantManager::updateTenantQuotaMillicores(const std::string& tenantId, int cpuMillicores,
+                                                        size_t memoryQuota, size_t diskQuota) {
     std::lock_guard<std::mutex> lock(m_mutex);
     auto it = m_tenants.find(tenantId);
     if (it == m_tenants.end()) {
-        return false;
+        return ResizeHandle();
     }
-    it->second->setCpuQuota(cpuQuota);
+    it->second->setCpuQuotaMillicores(cpuMillicores);
     it->second->setMemoryQuota(memoryQuota);
     it->second->setDiskQuota(diskQuota);
+    CpuResourceManager::getInstance().updateCpuQuota(it->second);
 
-    // 调整线程组大小
-    size_t threadCount = static_cast<size_t>(cpuQuota) * 10;
-    ThreadPoolManager::getInstance().resizeTenantThreads(tenantId, threadCount);
-
-    return true;
+    // 调整线程组大小，被移除的线程在后台退出
+    size_t threadCount = threadCountFor(cpuMillicores);
+    return ThreadPoolManager::getInstance().resizeTenantThreads(tenantId, threadCount);
 }
 
 } // namespace yao
\ No newline at end of file
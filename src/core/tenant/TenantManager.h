@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/tenant/TenantContext.h"
+#include "core/resource/ResizeHandle.h"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,16 @@ public:
      */
     bool createTenant(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota);
 
+    /**
+     * @brief 以千分之一核为单位的CPU配额创建租户
+     * @param tenantId 租户ID
+     * @param cpuMillicores CPU配额，如1500表示1.5个核心
+     * @param memoryQuota 内存配额
+     * @param diskQuota 磁盘配额
+     * @return 是否创建成功
+     */
+    bool createTenantMillicores(const std::string& tenantId, int cpuMillicores, size_t memoryQuota, size_t diskQuota);
+
     /**
      * @brief 获取租户上下文
      * @param tenantId 租户ID
@@ -44,14 +55,25 @@ public:
     bool removeTenant(const std::string& tenantId);
 
     /**
-     * @brief 更新租户配额
+     * @brief 更新租户配额，立即返回，线程数调整在后台完成
      * @param tenantId 租户ID
      * @param cpuQuota CPU配额
      * @param memoryQuota 内存配额
      * @param diskQuota 磁盘配额
-     * @return 是否更新成功
+     * @return 线程数调整的完成句柄，租户不存在或线程数调整被拒绝时为false
+     */
+    ResizeHandle updateTenantQuota(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota);
+
+    /**
+     * @brief 以千分之一核为单位更新租户配额，同时更新cgroup的CPU带宽
+     * @param tenantId 租户ID
+     * @param cpuMillicores CPU配额，如1500表示1.5个核心
+     * @param memoryQuota 内存配额
+     * @param diskQuota 磁盘配额
+     * @return 线程数调整的完成句柄，租户不存在或线程数调整被拒绝时为false
      */
-    bool updateTenantQuota(const std::string& tenantId, int cpuQuota, size_t memoryQuota, size_t diskQuota);
+    ResizeHandle updateTenantQuotaMillicores(const std::string& tenantId, int cpuMillicores,
+                                             size_t memoryQuota, size_t diskQuota);
 
 private:
     TenantManager() = default;
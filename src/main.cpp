@@ -1,3 +1,4 @@
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <thread>
@@ -26,6 +27,7 @@
 // Forward declarations
 int runUnitTests();
 int runBenchmarkTests();
+yao::RequestResult sendSqlRequest(yao::SqlServer& server, const yao::RequestContext& context, int maxRetries = 3);
 
 int main(int argc, char* argv[]) {
     using namespace yao;
@@ -80,7 +82,7 @@ int main(int argc, char* argv[]) {
     // 初始化线程池管理器
     auto& threadManager = ThreadPoolManager::getInstance();
     size_t totalThreads = config.getInt("total_threads", 120);
-    if (!threadManager.initialize(totalThreads, enableCgroup)) {
+    if (!threadManager.initialize(totalThreads, enableCgroup, ThreadGroupOptions::fromConfig(config))) {
         std::cout << "Failed to initialize ThreadPoolManager" << std::endl;
         return 1;
     }
@@ -116,7 +118,7 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Processing requests for tenant1..." << std::endl;
         for (int i = 0; i < 5; ++i) {
-            sqlServer->handleRequest(context1);
+            sendSqlRequest(*sqlServer, context1);
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
@@ -129,7 +131,7 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Processing requests for tenant2..." << std::endl;
         for (int i = 0; i < 3; ++i) {
-            sqlServer->handleRequest(context2);
+            sendSqlRequest(*sqlServer, context2);
             std::this_thread::sleep_for(std::chrono::milliseconds(150));
         }
     }
@@ -237,7 +239,8 @@ int runBenchmarkTests() {
     diskManager.initialize(config.getInt("total_disk_gb", 100));
 
     auto& threadManager = ThreadPoolManager::getInstance();
-    threadManager.initialize(config.getInt("total_threads", 120), config.getBool("enable_cgroup", false));
+    threadManager.initialize(config.getInt("total_threads", 120), config.getBool("enable_cgroup", false),
+                             ThreadGroupOptions::fromConfig(config));
 
     auto& cpuMonitor = CpuMonitor::getInstance();
     cpuMonitor.startMonitoring(config.getInt("monitoring_interval_ms", 2000));
@@ -254,13 +257,16 @@ int runBenchmarkTests() {
     const int numRequests = 1000;
     auto startTime = std::chrono::high_resolution_clock::now();
 
+    std::atomic<int> busyRequests{0};
     std::vector<std::thread> threads;
     for (int i = 0; i < 10; ++i) {  // 10个并发线程
         threads.emplace_back([&]() {
             for (int j = 0; j < numRequests / 10; ++j) {
                 auto stats = std::make_unique<BasicResourceStats>();
                 RequestContext context(tenant1, std::move(stats));
-                sqlServer->handleRequest(context);
+                if (sendSqlRequest(*sqlServer, context).status == RequestResult::Status::ServerBusy) {
+                    busyRequests.fetch_add(1);
+                }
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));  // 模拟延迟
             }
         });
@@ -275,6 +281,7 @@ int runBenchmarkTests() {
 
     std::cout << "Benchmark completed in " << duration.count() << " ms" << std::endl;
     std::cout << "Requests per second: " << (numRequests * 1000.0 / duration.count()) << std::endl;
+    std::cout << "Busy after retries: " << busyRequests.load() << std::endl;
 
     // 显示统计
     auto sysInfo = threadManager.getSystemThreadInfo();
@@ -290,4 +297,17 @@ int runBenchmarkTests() {
 
     std::cout << "Benchmark tests completed." << std::endl;
     return 0;
-}
\ No newline at end of file
+}
+
+yao::RequestResult sendSqlRequest(yao::SqlServer& server, const yao::RequestContext& context, int maxRetries) {
+    using namespace yao;
+
+    // 服务器繁忙时按返回的retryAfter退避后重试
+    RequestResult result = server.handleRequest(context);
+    for (int attempt = 0; attempt < maxRetries && result.status == RequestResult::Status::ServerBusy; ++attempt) {
+        std::cout << "Server busy, retrying after " << result.retryAfter.count() << "ms" << std::endl;
+        std::this_thread::sleep_for(result.retryAfter);
+        result = server.handleRequest(context);
+    }
+    return result;
+}
@@ -1,8 +1,11 @@
 #include "server/data/DataServer.h"
 #include "core/resource/DiskResourceManager.h"
 #include "core/resource/DiskQuotaChecker.h"
+#include "core/resource/ThreadPoolManager.h"
+#include "common/config/ConfigManager.h"
 #include "common/utils/RequestContext.h"
 #include "core/tenant/TenantContext.h"
+#include <algorithm>
 #include <iostream>
 
 namespace yao {
@@ -56,6 +59,25 @@ bool YaoDataServer::initialize() {
         return false;
     }
 
+    // 块设备IO隔离：与SqlServer共用ThreadPoolManager的cgroup控制器
+    auto& config = ConfigManager::getInstance();
+    auto cgroup = ThreadPoolManager::getInstance().getCgroupController();
+    if (config.getBool("enable_cgroup", false) && cgroup) {
+        std::string device = config.getString("disk_io_device", "");
+        if (device.empty()) {
+            device = CgroupController::blockDeviceOf(config.getString("disk_data_dir", "."));
+        }
+        // 带宽按MB/s配置
+        CgroupIoLimit limit;
+        limit.readBps = static_cast<uint64_t>(std::max(config.getInt("disk_tenant_read_mbps", 0), 0)) << 20;
+        limit.writeBps = static_cast<uint64_t>(std::max(config.getInt("disk_tenant_write_mbps", 0), 0)) << 20;
+        limit.readIops = std::max(config.getInt("disk_tenant_read_iops", 0), 0);
+        limit.writeIops = std::max(config.getInt("disk_tenant_write_iops", 0), 0);
+        if (!diskManager.initializeCgroup(cgroup, device, limit)) {
+            std::cerr << "Disk IO isolation disabled" << std::endl;
+        }
+    }
+
     std::cout << "YaoDataServer initialized" << std::endl;
     return true;
 }
@@ -2,13 +2,35 @@
 #include "core/tenant/TenantManager.h"
 #include "core/resource/TenantAuthenticator.h"
 #include "core/resource/CpuQuotaChecker.h"
+#include "core/resource/CpuResourceManager.h"
+#include "core/resource/MemoryResourceManager.h"
+#include "core/resource/PressureMonitor.h"
 #include "common/utils/RequestContext.h"
 #include "core/resource/LockFreeQueue.h"
 #include "core/resource/BasicResourceStats.h"
+#include <algorithm>
 #include <iostream>
 
 namespace yao {
 
+namespace {
+
+/**
+ * @brief SQL执行完成后更新请求的资源统计，SqlTask与ResumableSqlTask共用
+ */
+void recordSqlStats(const std::shared_ptr<RequestContext>& context) {
+    if (context && context->getStats()) {
+        // 尝试转换为BasicResourceStats进行更新
+        auto* basicStats = dynamic_cast<BasicResourceStats*>(context->getStats().get());
+        if (basicStats) {
+            // 模拟CPU使用
+            basicStats->updateCpuUsage(0.05);  // 5% CPU使用
+        }
+    }
+}
+
+} // namespace
+
 SqlTask::SqlTask(std::string sql, std::shared_ptr<RequestContext> context)
     : sql_(std::move(sql)), context_(std::move(context)), executed_(false) {
 }
@@ -22,23 +44,68 @@ void SqlTask::execute() {
     std::cout << "Executing SQL: " << sql_ << std::endl;
 
     // TODO: 实际的SQL解析和执行逻辑
-    // 这里应该调用SQL引擎执行查询
+    // 这里应该调用SQL引擎执行查询，执行器在算子之间检查shouldStop()，
+    // 客户端已放弃或超时后尽快返回，把线程让给仍能成功的请求
+    if (shouldStop()) {
+        std::cerr << "SQL cancelled or timed out: " << sql_ << std::endl;
+        return;
+    }
 
     // 更新资源统计
-    if (context_ && context_->getStats()) {
-        // 尝试转换为BasicResourceStats进行更新
-        auto* basicStats = dynamic_cast<BasicResourceStats*>(context_->getStats().get());
-        if (basicStats) {
-            // 模拟CPU使用
-            basicStats->updateCpuUsage(0.05);  // 5% CPU使用
-        }
-    }
+    recordSqlStats(context_);
 }
 
 bool SqlTask::isValid() const {
     return !sql_.empty() && context_ != nullptr;
 }
 
+size_t SqlTask::getQueuedBytes() const {
+    return sizeof(SqlTask) + sql_.capacity();
+}
+
+ResumableSqlTask::ResumableSqlTask(std::string sql, std::shared_ptr<RequestContext> context, StorageReader reader)
+    : sql_(std::move(sql)), context_(std::move(context)), reader_(std::move(reader)) {
+}
+
+ResumableTask::Step ResumableSqlTask::step() {
+    for (;;) {
+        if (shouldStop()) {
+            std::cerr << "SQL cancelled or timed out: " << sql_ << std::endl;
+            return Step::Done;
+        }
+
+        switch (stage_) {
+            case Stage::Parse:
+                // 解析与执行同SqlTask::execute，只是在读取存储时挂起
+                std::cout << "Executing SQL: " << sql_ << std::endl;
+                stage_ = Stage::Fetch;
+                break;
+
+            case Stage::Fetch:
+                stage_ = Stage::Finish;
+                if (reader_) {
+                    // 回调可能在reader_返回前就在本线程触发，ResumableTask会直接继续执行
+                    Resumer resumer = makeResumer();
+                    reader_(sql_, [resumer]() { resumer.resume(); });
+                    return Step::Suspend;
+                }
+                break;
+
+            case Stage::Finish:
+                recordSqlStats(context_);
+                stage_ = Stage::Completed;
+                return Step::Done;
+
+            case Stage::Completed:
+                return Step::Done;
+        }
+    }
+}
+
+void ResumableSqlTask::onAbandoned() {
+    std::cerr << "SQL abandoned before completion: " << sql_ << std::endl;
+}
+
 ConnectionManager::ConnectionManager() 
     : authenticator_(std::make_unique<TenantAuthenticator>())
     , quotaChecker_(std::make_unique<CpuQuotaChecker>()) {
@@ -68,6 +135,14 @@ std::shared_ptr<RequestContext> ConnectionManager::handleConnection(const std::s
         return nullptr;
     }
 
+    // 主机或租户cgroup出现停顿时，超过软限制的租户暂不建立新连接
+    double usageRatio = std::max(CpuResourceManager::getInstance().getTenantCpuUsage(tenantId),
+                                 MemoryResourceManager::getInstance().getTenantMemoryUsage(tenantId));
+    if (PressureMonitor::getInstance().shouldShed(tenantId, usageRatio)) {
+        std::cerr << "Connection shed under resource pressure for tenant: " << tenantId << std::endl;
+        return nullptr;
+    }
+
     // 创建请求上下文
     auto stats = std::make_unique<BasicResourceStats>();
     return std::make_shared<RequestContext>(tenant, std::move(stats));
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "core/resource/LockFreeQueue.h"
+#include "core/resource/ResumableTask.h"
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -24,6 +26,7 @@ public:
 
     void execute() override;
     bool isValid() const override;
+    size_t getQueuedBytes() const override;
 
 private:
     std::string sql_;
@@ -31,6 +34,41 @@ private:
     bool executed_;
 };
 
+/**
+ * @brief 可挂起的SQL任务
+ * 把SQL执行拆成解析、读取存储、汇总结果三段。读取存储时发起异步请求后挂起，
+ * 不占用工作线程；请求完成后由回调恢复，剩余段回到本租户线程组继续执行。
+ */
+class ResumableSqlTask : public ResumableTask {
+public:
+    /// 异步读取存储：发起请求后立即返回，完成时（可在任意线程）调用done
+    using StorageReader = std::function<void(const std::string& sql, std::function<void()> done)>;
+
+    /**
+     * @param sql SQL语句
+     * @param context 请求上下文
+     * @param reader 异步读取接口，为空时在工作线程上同步完成
+     */
+    ResumableSqlTask(std::string sql, std::shared_ptr<RequestContext> context, StorageReader reader = nullptr);
+
+    /**
+     * @brief 是否已完整执行
+     */
+    bool isCompleted() const { return stage_ == Stage::Completed; }
+
+protected:
+    Step step() override;
+    void onAbandoned() override;
+
+private:
+    enum class Stage { Parse, Fetch, Finish, Completed };
+
+    std::string sql_;
+    std::shared_ptr<RequestContext> context_;
+    StorageReader reader_;
+    Stage stage_ = Stage::Parse;   ///< 各段串行执行，由状态切换保证可见性
+};
+
 /**
  * @brief 连接管理器
  */
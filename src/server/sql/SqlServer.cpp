@@ -4,11 +4,13 @@
 #include "core/resource/CpuResourceManager.h"
 #include "core/resource/MemoryResourceManager.h"
 #include "core/resource/MemoryQuotaChecker.h"
+#include "core/resource/PressureMonitor.h"
 #include "common/config/ConfigManager.h"
 #include "common/utils/RequestContext.h"
 #include "core/tenant/TenantContext.h"
 #include "core/resource/ResourceStats.h"
 #include "core/resource/BasicResourceStats.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -22,16 +24,16 @@ YaoSqlServer::~YaoSqlServer() {
     stop();
 }
 
-bool YaoSqlServer::handleRequest(const RequestContext& context) {
+RequestResult YaoSqlServer::handleRequest(const RequestContext& context) {
     if (!running_) {
         std::cerr << "SqlServer is not running" << std::endl;
-        return false;
+        return RequestResult::failed();
     }
 
     auto tenant = context.getTenant();
     if (!tenant) {
         std::cerr << "No tenant context in request" << std::endl;
-        return false;
+        return RequestResult::failed();
     }
 
     const std::string& tenantId = tenant->getTenantId();
@@ -43,14 +45,15 @@ bool YaoSqlServer::handleRequest(const RequestContext& context) {
         // 首次请求，分配CPU资源
         if (!cpuManager.allocateCpuResource(tenant)) {
             std::cerr << "Failed to allocate CPU resource for tenant: " << tenantId << std::endl;
-            return false;
+            return RequestResult::failed();
         }
+        PressureMonitor::getInstance().registerTenant(tenantId);
     }
 
     // 检查CPU配额
     if (cpuUsage > 0.8) {  // 80%阈值
         std::cerr << "CPU usage too high for tenant: " << tenantId << " (" << cpuUsage << ")" << std::endl;
-        return false;
+        return RequestResult::failed();
     }
 
     // 检查内存资源分配
@@ -60,7 +63,7 @@ bool YaoSqlServer::handleRequest(const RequestContext& context) {
         // 首次请求，分配内存资源
         if (!memoryManager.allocateMemoryResource(tenant)) {
             std::cerr << "Failed to allocate memory resource for tenant: " << tenantId << std::endl;
-            return false;
+            return RequestResult::failed();
         }
     }
 
@@ -69,23 +72,50 @@ bool YaoSqlServer::handleRequest(const RequestContext& context) {
     double requestedMemoryMB = 10.0;  // 示例：请求10MB内存
     if (!memoryChecker.checkQuota(tenant, requestedMemoryMB)) {
         std::cerr << "Memory quota check failed for tenant: " << tenantId << std::endl;
-        return false;
+        return RequestResult::failed();
+    }
+
+    // 主机或租户cgroup出现停顿时，超过软限制的租户退避重试，把资源让给其他租户
+    auto& pressureMonitor = PressureMonitor::getInstance();
+    if (pressureMonitor.shouldShed(tenantId, std::max(cpuUsage, memoryManager.getTenantMemoryUsage(tenantId)))) {
+        std::cerr << "Shedding tenant under resource pressure: " << tenantId << std::endl;
+        return RequestResult::busy(pressureMonitor.getRetryAfter());
     }
 
     // 创建SQL任务（这里简化，实际应该解析SQL）
     std::string sql = "SELECT * FROM test_table";  // 示例SQL
     auto stats = std::make_unique<BasicResourceStats>();
-    auto sqlTask = std::make_unique<SqlTask>(sql, std::make_shared<RequestContext>(context.getTenant(), std::move(stats)));
+    auto taskContext = std::make_shared<RequestContext>(context.getTenant(), std::move(stats));
+    auto deadline = taskTimeout_.count() > 0 ? std::chrono::steady_clock::now() + taskTimeout_
+                                             : std::chrono::steady_clock::time_point::max();
 
     // 提交到租户线程池
+    // 客户端放弃请求后取消令牌，排队中的任务出队时直接丢弃
     auto& threadManager = ThreadPoolManager::getInstance();
-    if (!threadManager.submitTask(tenantId, std::move(sqlTask))) {
+    SubmitResult submitted;
+    if (resumableExecution_) {
+        auto sqlTask = std::make_shared<ResumableSqlTask>(sql, taskContext, storageReader_);
+        sqlTask->setCancellationToken(context.getCancellationToken());
+        sqlTask->setDeadline(deadline);
+        submitted = threadManager.submitResumable(tenantId, std::move(sqlTask));
+    } else {
+        auto sqlTask = std::make_unique<SqlTask>(sql, taskContext);
+        sqlTask->setCancellationToken(context.getCancellationToken());
+        sqlTask->setDeadline(deadline);
+        submitted = threadManager.submitTask(tenantId, std::move(sqlTask));
+    }
+    if (submitted.isBusy()) {
+        // 租户积压超限，立即返回繁忙错误，由客户端按retryAfter退避重试
+        std::cerr << "Server busy for tenant: " << tenantId << " (" << submitStatusName(submitted.status)
+                  << "), retry after " << submitted.retryAfter.count() << "ms" << std::endl;
+        return RequestResult::busy(submitted.retryAfter);
+    }
+    if (!submitted) {
         std::cerr << "Failed to submit task for tenant: " << tenantId << std::endl;
-        return false;
+        return RequestResult::failed();
     }
 
-    // 更新CPU使用统计（模拟）
-    cpuManager.updateCpuUsage(tenantId, cpuUsage + 0.01);  // 增加1%使用率
+    // CPU使用率由CpuMonitor按线程组实际占用的CPU时间更新
 
     // 更新内存使用统计（模拟）
     double currentMemoryUsage = memoryManager.getTenantMemoryUsage(tenantId);
@@ -94,7 +124,11 @@ bool YaoSqlServer::handleRequest(const RequestContext& context) {
     }
 
     std::cout << "Request handled for tenant: " << tenantId << std::endl;
-    return true;
+    return RequestResult::success();
+}
+
+void YaoSqlServer::setStorageReader(ResumableSqlTask::StorageReader reader) {
+    storageReader_ = std::move(reader);
 }
 
 bool YaoSqlServer::initialize() {
@@ -107,14 +141,18 @@ bool YaoSqlServer::initialize() {
     // 初始化线程池管理器
     auto& threadManager = ThreadPoolManager::getInstance();
     size_t totalThreads = config.getInt("total_threads", 120);
-    if (!threadManager.initialize(totalThreads, enableCgroup)) {
+    taskTimeout_ = std::chrono::milliseconds(std::max(config.getInt("sql_task_timeout_ms", 30000), 0));
+    resumableExecution_ = config.getString("sql_execution_mode", "sync") == "resumable";
+    if (!threadManager.initialize(totalThreads, enableCgroup, ThreadGroupOptions::fromConfig(config))) {
         std::cerr << "Failed to initialize ThreadPoolManager" << std::endl;
         return false;
     }
 
     // 初始化CPU资源管理器
     auto& cpuManager = CpuResourceManager::getInstance();
-    if (!cpuManager.initializeCgroup(enableCgroup)) {
+    cpuManager.configureBandwidth(std::max(config.getInt("cpu_cfs_period_us", 100000), 0),
+                                  std::max(config.getInt("cpu_burst_percent", 0), 0));
+    if (!cpuManager.initializeCgroup(enableCgroup, threadManager.getCgroupController())) {
         std::cerr << "Failed to initialize CpuResourceManager" << std::endl;
         return false;
     }
@@ -126,6 +164,19 @@ bool YaoSqlServer::initialize() {
         std::cerr << "Failed to initialize MemoryResourceManager" << std::endl;
         return false;
     }
+    if (enableCgroup) {
+        memoryManager.initializeCgroup(threadManager.getCgroupController(),
+                                       std::max(config.getInt("memory_cgroup_high_percent", 90), 0));
+    }
+
+    // 初始化PSI压力监控，内核不支持PSI时只依赖配额检查
+    auto& pressureMonitor = PressureMonitor::getInstance();
+    if (config.getBool("psi_enabled", true) &&
+        pressureMonitor.initialize("/proc/pressure", threadManager.getCgroupController())) {
+        pressureMonitor.configure(config.getInt("psi_stall_percent", 20) / 100.0,
+                                  config.getInt("psi_soft_limit_percent", 70) / 100.0);
+        pressureMonitor.startMonitoring(std::max(config.getInt("psi_interval_ms", 1000), 10));
+    }
 
     std::cout << "YaoSqlServer initialized successfully" << std::endl;
     return true;
@@ -153,6 +204,7 @@ void YaoSqlServer::stop() {
     std::cout << "Stopping YaoSqlServer..." << std::endl;
 
     running_ = false;
+    PressureMonitor::getInstance().stopMonitoring();
 
     // 停止线程池管理器
     auto& threadManager = ThreadPoolManager::getInstance();
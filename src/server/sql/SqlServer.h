@@ -1,8 +1,10 @@
 #pragma once
 
+#include "server/sql/ConnectionManager.h"
 #include <memory>
 #include <string>
 #include <atomic>
+#include <chrono>
 
 namespace yao {
 
@@ -12,6 +14,26 @@ class ConnectionManager;
 class ThreadPoolManager;
 class Task;
 
+/**
+ * @brief SQL请求处理结果
+ */
+struct RequestResult {
+    enum class Status {
+        Ok,          ///< 已受理
+        Failed,      ///< 认证、配额等检查失败
+        ServerBusy   ///< 租户积压超限，客户端应在retryAfter后重试
+    };
+
+    Status status = Status::Failed;
+    std::chrono::milliseconds retryAfter{0};   ///< 仅ServerBusy时有效
+
+    static RequestResult success() { return RequestResult{Status::Ok, std::chrono::milliseconds(0)}; }
+    static RequestResult failed() { return RequestResult{Status::Failed, std::chrono::milliseconds(0)}; }
+    static RequestResult busy(std::chrono::milliseconds retryAfter) { return RequestResult{Status::ServerBusy, retryAfter}; }
+
+    bool ok() const { return status == Status::Ok; }
+};
+
 /**
  * @brief SQL服务器接口
  * 定义SQL服务器的基本操作
@@ -23,9 +45,9 @@ public:
     /**
      * @brief 处理请求
      * @param context 请求上下文
-     * @return 是否处理成功
+     * @return 处理结果，租户积压超限时为ServerBusy并给出建议的重试间隔
      */
-    virtual bool handleRequest(const RequestContext& context) = 0;
+    virtual RequestResult handleRequest(const RequestContext& context) = 0;
 
     /**
      * @brief 初始化服务器
@@ -54,11 +76,18 @@ public:
     YaoSqlServer();
     ~YaoSqlServer() override;
 
-    bool handleRequest(const RequestContext& context) override;
+    RequestResult handleRequest(const RequestContext& context) override;
+
     bool initialize() override;
     bool start() override;
     void stop() override;
 
+    /**
+     * @brief 设置resumable执行模式下读取存储的异步接口（如DataServer客户端）
+     * 需在start前设置；未设置时存储读取在工作线程上同步完成
+     */
+    void setStorageReader(ResumableSqlTask::StorageReader reader);
+
 private:
     /**
      * @brief 执行SQL查询
@@ -70,6 +99,9 @@ private:
 
     std::unique_ptr<ConnectionManager> connectionManager_;
     std::atomic<bool> running_;
+    std::chrono::milliseconds taskTimeout_{0};  ///< SQL任务排队与执行的超时时间，0表示不限
+    bool resumableExecution_ = false;            ///< 是否以可挂起任务执行SQL（sql_execution_mode=resumable）
+    ResumableSqlTask::StorageReader storageReader_;
 };
 
 } // namespace yao
\ No newline at end of file
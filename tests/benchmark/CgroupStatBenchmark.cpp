@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "core/resource/CgroupController.h"
+
+using namespace yao;
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief 原实现的读取方式：每次打开ifstream、读出字符串再用stringstream解析
+ */
+uint64_t streamStatValue(const std::string& path, const std::string& key) {
+    std::ifstream file(path);
+    if (!file.is_open()) return 0;
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::stringstream ss(content);
+    std::string line;
+    while (std::getline(ss, line)) {
+        std::stringstream fields(line);
+        std::string name;
+        uint64_t value = 0;
+        if (fields >> name >> value && name == key) {
+            return value;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 在临时目录中伪造tenants个租户的v2层级
+ */
+fs::path buildHierarchy(std::unique_ptr<CgroupController>& controller, size_t tenants) {
+    fs::path root = fs::temp_directory_path() / ("cgroup_stat_benchmark_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    controller = std::make_unique<CgroupController>((root / "yaobase").string(), CgroupVersion::V2);
+    controller->initialize();
+    for (size_t i = 0; i < tenants; ++i) {
+        std::string tenantId = "tenant_" + std::to_string(i);
+        controller->createTenantCgroup(tenantId);
+        std::ofstream(root / "yaobase" / tenantId / "cpu.stat")
+            << "usage_usec " << (i * 1000 + 17) << "\nuser_usec 1000\nsystem_usec 500\n"
+            << "nr_periods 120\nnr_throttled 3\nthrottled_usec 4500\n"
+            << "nr_bursts 0\nburst_usec 0\n";
+    }
+    return root;
+}
+
+/**
+ * @brief 把打开文件数软限制提到硬限制，缓存描述符需要每个租户一个
+ */
+void raiseFileLimit() {
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief cgroup统计采集基准测试：逐租户ifstream解析 vs 缓存描述符批量采集
+ * 用法: CgroupStatBenchmark [租户数] [轮数]
+ */
+int main(int argc, char* argv[]) {
+    size_t tenants = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+    raiseFileLimit();
+
+    std::unique_ptr<CgroupController> controller;
+    fs::path root = buildHierarchy(controller, tenants);
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < tenants; ++i) {
+        paths.push_back((root / "yaobase" / ("tenant_" + std::to_string(i)) / "cpu.stat").string());
+    }
+
+    uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& path : paths) {
+            sink += streamStatValue(path, "usage_usec") + streamStatValue(path, "throttled_usec");
+        }
+    }
+    double stream = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    // 第一轮打开并缓存描述符，不计入
+    std::vector<CgroupCpuSample> samples;
+    controller->collectAll(samples);
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        controller->collectAll(samples);
+        for (const auto& sample : samples) {
+            sink += sample.usageNs + sample.throttledNs;
+        }
+    }
+    double collected = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+    std::cout << "Cgroup stat benchmark: " << tenants << " tenants, " << rounds << " sweeps"
+              << " (collected " << samples.size() << ", checksum " << sink % 1000 << ")" << std::endl;
+    std::cout << std::left << std::setw(24) << "method"
+              << std::setw(16) << "sweep (ms)"
+              << "per tenant (us)" << std::endl;
+    std::cout << std::left << std::setw(24) << "ifstream + stringstream"
+              << std::setw(16) << std::fixed << std::setprecision(2) << stream
+              << stream * 1000 / tenants << std::endl;
+    std::cout << std::left << std::setw(24) << "cached fd + pread"
+              << std::setw(16) << collected
+              << collected * 1000 / tenants << std::endl;
+    std::cout << "speedup: " << std::setprecision(2) << stream / collected << "x" << std::endl;
+
+    controller.reset();
+    fs::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/resource/TenantThreadGroup.h"
+
+using namespace yao;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 记录从提交到开始执行的延迟
+ */
+class LatencyTask : public Task {
+public:
+    LatencyTask(Clock::time_point submitted, double& latencyUs, std::atomic<bool>& done)
+        : submitted_(submitted), latencyUs_(latencyUs), done_(done) {}
+
+    void execute() override {
+        latencyUs_ = std::chrono::duration<double, std::micro>(Clock::now() - submitted_).count();
+        done_.store(true, std::memory_order_release);
+    }
+    bool isValid() const override { return true; }
+
+private:
+    Clock::time_point submitted_;
+    double& latencyUs_;
+    std::atomic<bool>& done_;
+};
+
+double percentile(std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+/**
+ * @brief 逐个提交任务并等待其执行完成，两次提交之间空闲idleGap
+ * idleGap大于自旋时长时，测到的是工作线程从休眠中被唤醒的延迟
+ */
+void runOnce(const char* label, std::chrono::microseconds spin, std::chrono::microseconds idleGap,
+             size_t threads, size_t samples) {
+    ThreadGroupOptions options;
+    options.queueEngine = TaskQueueEngine::RingBuffer;
+    options.idleSpin = spin;
+    TenantThreadGroup group("latency_bench", threads, nullptr, options);
+    group.start();
+
+    std::vector<double> latencies(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        std::atomic<bool> done{false};
+        group.submitTask(std::make_unique<LatencyTask>(Clock::now(), latencies[i], done));
+        while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        if (idleGap.count() > 0) {
+            std::this_thread::sleep_for(idleGap);
+        }
+    }
+    group.stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << std::left << std::setw(28) << label
+              << std::setw(10) << spin.count()
+              << std::setw(10) << idleGap.count()
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << percentile(latencies, 0.50)
+              << std::setw(10) << percentile(latencies, 0.99)
+              << latencies.back() << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 任务提交到开始执行的分发延迟基准测试
+ * 用法: DispatchLatencyBenchmark [样本数] [工作线程数]
+ */
+int main(int argc, char* argv[]) {
+    size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+
+    std::cout << "Dispatch latency benchmark: " << samples << " samples, " << threads << " workers" << std::endl;
+    std::cout << std::left << std::setw(28) << "mode"
+              << std::setw(10) << "spin(us)"
+              << std::setw(10) << "gap(us)"
+              << std::setw(10) << "p50(us)"
+              << std::setw(10) << "p99(us)"
+              << "max(us)" << std::endl;
+
+    using std::chrono::microseconds;
+    runOnce("back-to-back, spin", microseconds(50), microseconds(0), threads, samples);
+    runOnce("back-to-back, park only", microseconds(0), microseconds(0), threads, samples);
+    runOnce("idle gap, spin then park", microseconds(50), microseconds(200), threads, samples);
+    runOnce("idle gap, park only", microseconds(0), microseconds(200), threads, samples);
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/resource/EpochReclaimer.h"
+#include "core/resource/LockFreeQueue.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+struct Payload {
+    char data[32];
+};
+
+/**
+ * @brief 在threads个线程上各执行iterations次body，返回单线程视角下每次操作的墙钟纳秒数
+ */
+template <typename Body>
+double measure(int threads, size_t iterations, Body body) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < iterations; ++i) {
+                body();
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / iterations;
+}
+
+} // namespace
+
+/**
+ * @brief 纪元回收开销基准测试
+ * 对比裸new/delete与new/retire，以及守卫本身和LockFreeQueue一次入队出队的开销
+ * 用法: EpochReclaimerBenchmark [每线程操作数]
+ */
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    auto& reclaimer = EpochReclaimer::getInstance();
+
+    std::cout << "EpochReclaimer benchmark: " << iterations << " ops per thread (ns/op, wall clock)" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads"
+              << std::setw(14) << "guard"
+              << std::setw(14) << "new+delete"
+              << std::setw(14) << "new+retire"
+              << std::setw(14) << "queue push+pop" << std::endl;
+
+    for (int threads : {1, 2, 4, 8, 16}) {
+        double guard = measure(threads, iterations, []() {
+            EpochReclaimer::Guard g;
+        });
+        double plain = measure(threads, iterations, []() {
+            delete new Payload();
+        });
+        double retire = measure(threads, iterations, [&reclaimer]() {
+            EpochReclaimer::Guard g;
+            reclaimer.retire(new Payload());
+        });
+        reclaimer.synchronize();
+
+        LockFreeQueue queue;
+        double queueOps = measure(threads, iterations, [&queue]() {
+            queue.enqueue(std::make_unique<NoopTask>());
+            queue.dequeue();
+        });
+        reclaimer.synchronize();
+
+        std::cout << std::left << std::setw(10) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(14) << guard
+                  << std::setw(14) << plain
+                  << std::setw(14) << retire
+                  << std::setw(14) << queueOps << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/resource/LatencyHistogram.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief threads个线程各记录iterations次，返回单个线程每次记录的平均纳秒数
+ * withClock为true时每次记录前读取一次steady_clock，模拟执行路径上的完整开销
+ */
+double runOnce(int threads, size_t iterations, bool withClock) {
+    LatencyHistogram histogram;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            auto previous = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                if (withClock) {
+                    auto now = std::chrono::steady_clock::now();
+                    histogram.record(now - previous);
+                    previous = now;
+                } else {
+                    histogram.record(static_cast<uint64_t>((i * 2654435761u + t) & 0xFFFFFF));
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    // 各线程并行记录，单次开销按每个线程的记录次数折算
+    return elapsed / iterations;
+}
+
+} // namespace
+
+/**
+ * @brief 延迟直方图记录开销基准测试
+ * 用法: LatencyHistogramBenchmark [每个线程记录次数]
+ */
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    std::cout << "Latency histogram benchmark: " << iterations << " records per thread" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads"
+              << std::setw(20) << "record (ns/op)"
+              << "record+clock (ns/op)" << std::endl;
+
+    for (int threads : {1, 4, 16}) {
+        double record = runOnce(threads, iterations, false);
+        double withClock = runOnce(threads, iterations, true);
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(20) << std::fixed << std::setprecision(1) << record
+                  << withClock << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "core/resource/ThreadPoolManager.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 以threads个线程并发提交，lookup负责按租户ID找到并提交，返回每秒提交数
+ * 另有一个线程持续查询租户信息，模拟监控读取
+ */
+template <typename Lookup>
+double runOnce(int threads, size_t submitsPerThread, const std::vector<std::string>& tenants, Lookup lookup) {
+    std::atomic<bool> go{false};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> submitters;
+
+    for (int t = 0; t < threads; ++t) {
+        submitters.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < submitsPerThread; ++i) {
+                const std::string& tenantId = tenants[(t + i) % tenants.size()];
+                lookup(tenantId, std::make_unique<NoopTask>());
+            }
+        });
+    }
+    std::thread monitor([&]() {
+        auto& manager = ThreadPoolManager::getInstance();
+        while (!done.load(std::memory_order_acquire)) {
+            for (const auto& tenantId : tenants) {
+                manager.getTenantThreadInfo(tenantId);
+            }
+            manager.getSystemThreadInfo();
+            std::this_thread::yield();
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : submitters) {
+        t.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true, std::memory_order_release);
+    monitor.join();
+    return threads * submitsPerThread / elapsed;
+}
+
+} // namespace
+
+/**
+ * @brief ThreadPoolManager::submitTask 并发提交基准测试
+ * 对比无锁快照查找与"全局互斥锁 + 哈希表"查找（改造前的实现方式）
+ * 用法: SubmitContentionBenchmark [每线程提交数] [租户数]
+ */
+int main(int argc, char* argv[]) {
+    size_t submitsPerThread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    size_t tenantCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+
+    ThreadGroupOptions options;
+    options.queueEngine = TaskQueueEngine::Linked;
+    auto& manager = ThreadPoolManager::getInstance();
+    manager.initialize(tenantCount * 2, false, options);
+
+    std::vector<std::string> tenants;
+    for (size_t i = 0; i < tenantCount; ++i) {
+        tenants.push_back("bench_tenant_" + std::to_string(i));
+        manager.createTenantThreadGroup(tenants.back(), 2);
+    }
+
+    // 改造前的查找方式：每次提交都持有全局互斥锁
+    std::mutex globalMutex;
+    std::unordered_map<std::string, int> lockedMap;
+    for (const auto& tenantId : tenants) {
+        lockedMap.emplace(tenantId, 0);
+    }
+    auto lockedSubmit = [&](const std::string& tenantId, std::unique_ptr<Task> task) {
+        std::lock_guard<std::mutex> lock(globalMutex);
+        if (lockedMap.find(tenantId) != lockedMap.end()) {
+            manager.submitTask(tenantId, std::move(task));
+        }
+    };
+    auto snapshotSubmit = [&](const std::string& tenantId, std::unique_ptr<Task> task) {
+        manager.submitTask(tenantId, std::move(task));
+    };
+
+    std::cout << "Submit contention benchmark: " << submitsPerThread << " submits per thread, "
+              << tenantCount << " tenants" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads"
+              << std::setw(20) << "mutex (submit/s)"
+              << std::setw(20) << "snapshot (submit/s)"
+              << "speedup" << std::endl;
+
+    for (int threads : {1, 8, 32, 64}) {
+        double locked = runOnce(threads, submitsPerThread, tenants, lockedSubmit);
+        double snapshot = runOnce(threads, submitsPerThread, tenants, snapshotSubmit);
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(20) << std::fixed << std::setprecision(0) << locked
+                  << std::setw(20) << snapshot
+                  << std::setprecision(2) << (snapshot / locked) << "x" << std::endl;
+    }
+
+    manager.shutdown();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/resource/InlineTask.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 模拟一次请求携带的状态：租户ID、请求序号和若干统计字段
+ */
+struct RequestState {
+    uint64_t requestId;
+    uint32_t tenantIndex;
+    double cpuEstimate;
+    char tag[24];
+};
+
+/**
+ * @brief producers个生产者创建任务入队，同样数量的消费者出队执行并释放，返回每秒任务数
+ */
+template <typename MakeTask>
+double runOnce(TaskQueueEngine engine, int producers, size_t perProducer, MakeTask makeTask) {
+    auto queue = createTaskQueue(engine, 1 << 16);
+    const size_t expected = perProducer * producers;
+    std::atomic<bool> go{false};
+    std::atomic<size_t> consumed{0};
+    std::atomic<uint64_t> sink{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < perProducer; ++i) {
+                RequestState state{i, static_cast<uint32_t>(p), 0.05, "select"};
+                auto task = makeTask(state, sink);
+                while (!queue->enqueue(std::move(task))) {
+                    std::this_thread::yield();
+                    task = makeTask(state, sink);
+                }
+            }
+        });
+    }
+    for (int c = 0; c < producers; ++c) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (consumed.load(std::memory_order_relaxed) < expected) {
+                if (auto task = queue->dequeue()) {
+                    task->execute();
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    return expected / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * @brief 任务分配开销基准测试：std::function堆任务 vs 内联任务
+ * 用法: TaskAllocationBenchmark [每个生产者任务数]
+ */
+int main(int argc, char* argv[]) {
+    size_t perProducer = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    auto makeFunctionTask = [](const RequestState& state, std::atomic<uint64_t>& sink) -> std::unique_ptr<Task> {
+        return std::make_unique<FunctionTask>([state, &sink]() { sink.fetch_add(state.requestId, std::memory_order_relaxed); });
+    };
+    auto makeInline = [](const RequestState& state, std::atomic<uint64_t>& sink) -> std::unique_ptr<Task> {
+        return makeInlineTask([state, &sink]() { sink.fetch_add(state.requestId, std::memory_order_relaxed); });
+    };
+
+    std::cout << "Task allocation benchmark: " << perProducer << " tasks per producer" << std::endl;
+    std::cout << std::left << std::setw(10) << "engine"
+              << std::setw(10) << "threads"
+              << std::setw(20) << "function (ops/s)"
+              << std::setw(20) << "inline (ops/s)"
+              << "speedup" << std::endl;
+
+    for (TaskQueueEngine engine : {TaskQueueEngine::Linked, TaskQueueEngine::RingBuffer}) {
+        for (int threads : {1, 4, 16}) {
+            double function = runOnce(engine, threads, perProducer, makeFunctionTask);
+            double inlined = runOnce(engine, threads, perProducer, makeInline);
+            std::cout << std::left << std::setw(10) << (engine == TaskQueueEngine::Linked ? "linked" : "ring")
+                      << std::setw(10) << threads
+                      << std::setw(20) << std::fixed << std::setprecision(0) << function
+                      << std::setw(20) << inlined
+                      << std::setprecision(2) << (inlined / function) << "x" << std::endl;
+        }
+    }
+    return 0;
+}
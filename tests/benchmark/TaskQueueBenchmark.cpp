@@ -0,0 +1,92 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/resource/TaskQueue.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 以threads个生产者和threads个消费者运行，返回每秒完成的任务数
+ */
+double runOnce(TaskQueueEngine engine, int threads, size_t totalTasks, size_t capacity) {
+    auto queue = createTaskQueue(engine, capacity);
+    const size_t perProducer = totalTasks / threads;
+    const size_t expected = perProducer * threads;
+
+    std::atomic<bool> go{false};
+    std::atomic<size_t> consumed{0};
+    std::vector<std::thread> workers;
+
+    for (int p = 0; p < threads; ++p) {
+        workers.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < perProducer; ++i) {
+                while (!queue->enqueue(std::make_unique<NoopTask>())) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < threads; ++c) {
+        workers.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            while (consumed.load(std::memory_order_relaxed) < expected) {
+                auto task = queue->dequeue();
+                if (task) {
+                    task->execute();
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : workers) {
+        t.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return expected / elapsed;
+}
+
+} // namespace
+
+/**
+ * @brief 队列引擎对比基准测试
+ * 用法: TaskQueueBenchmark [每轮任务数] [环形队列容量]
+ */
+int main(int argc, char* argv[]) {
+    size_t totalTasks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+
+    std::cout << "TaskQueue benchmark: " << totalTasks << " tasks per run, ring capacity " << capacity << std::endl;
+    // threads = 生产者数 = 消费者数
+    std::cout << std::left << std::setw(10) << "threads"
+              << std::setw(18) << "linked (ops/s)"
+              << std::setw(18) << "ring (ops/s)"
+              << "speedup" << std::endl;
+
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        double linked = runOnce(TaskQueueEngine::Linked, threads, totalTasks, capacity);
+        double ring = runOnce(TaskQueueEngine::RingBuffer, threads, totalTasks, capacity);
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(18) << std::fixed << std::setprecision(0) << linked
+                  << std::setw(18) << ring
+                  << std::setprecision(2) << (ring / linked) << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "core/resource/TaskQueue.h"
+
+namespace yao {
+namespace test {
+
+/**
+ * @brief 空任务，只用于衡量队列与调度本身的开销
+ */
+class NoopTask : public Task {
+public:
+    void execute() override {}
+    bool isValid() const override { return true; }
+};
+
+/**
+ * @brief 执行给定函数的任务（std::function包装，每个任务一次堆分配）
+ */
+class FunctionTask : public Task {
+public:
+    explicit FunctionTask(std::function<void()> fn) : fn_(std::move(fn)) {}
+
+    void execute() override { fn_(); }
+    bool isValid() const override { return static_cast<bool>(fn_); }
+
+private:
+    std::function<void()> fn_;
+};
+
+/**
+ * @brief 执行时累加计数的任务，可选忙等一段时间模拟CPU占用，可带序号用于校验顺序
+ */
+class CountingTask : public Task {
+public:
+    explicit CountingTask(std::atomic<int>& counter, std::chrono::microseconds work = std::chrono::microseconds(0))
+        : counter_(&counter), work_(work) {}
+
+    /**
+     * @param id 序号，由getId()取回
+     * @param counter 计数器，为空时不计数
+     */
+    CountingTask(int id, std::atomic<int>* counter) : id_(id), counter_(counter) {}
+
+    void execute() override {
+        if (work_.count() > 0) {
+            auto until = std::chrono::steady_clock::now() + work_;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+        }
+        if (counter_) counter_->fetch_add(1);
+    }
+    bool isValid() const override { return true; }
+
+    int getId() const { return id_; }
+
+private:
+    int id_ = 0;
+    std::atomic<int>* counter_;
+    std::chrono::microseconds work_{0};
+};
+
+/**
+ * @brief 等待条件成立，超时返回false
+ */
+template <typename Predicate>
+bool waitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace test
+} // namespace yao
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "core/resource/AdmissionController.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief 测试用任务，排队字节数可指定
+ */
+class SizedTask : public Task {
+public:
+    explicit SizedTask(size_t bytes = 100) : bytes_(bytes) {}
+
+    void execute() override {}
+    bool isValid() const override { return true; }
+    size_t getQueuedBytes() const override { return bytes_; }
+
+private:
+    size_t bytes_;
+};
+
+AdmissionController::Limits makeLimits(size_t tasks, size_t bytes) {
+    AdmissionController::Limits limits;
+    limits.maxQueuedTasks = tasks;
+    limits.maxQueuedBytes = bytes;
+    return limits;
+}
+
+} // namespace
+
+/**
+ * @brief 测试排队任务数达到上限后拒绝，出队后恢复准入
+ */
+TEST(AdmissionControllerTest, RejectsWhenTaskLimitReached) {
+    AdmissionController admission(makeLimits(2, 0));
+    auto queue = createTaskQueue(TaskQueueEngine::Linked, 16);
+
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>()));
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>()));
+    SubmitResult rejected = admission.submit(*queue, std::make_unique<SizedTask>());
+    EXPECT_FALSE(rejected);
+    EXPECT_TRUE(rejected.isBusy());
+    EXPECT_EQ(rejected.status, SubmitStatus::QueueFull);
+    EXPECT_GT(rejected.retryAfter.count(), 0);
+    EXPECT_EQ(admission.getQueuedTasks(), 2u);
+    EXPECT_EQ(admission.getRejectedTasks(), 1u);
+    EXPECT_EQ(queue->size(), 2u);
+
+    auto task = queue->dequeue();
+    admission.release(*task);
+    admission.release(*task);  // 重复扣除被忽略
+    EXPECT_EQ(admission.getQueuedTasks(), 1u);
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>()));
+}
+
+/**
+ * @brief 测试排队字节数达到上限后拒绝
+ */
+TEST(AdmissionControllerTest, RejectsWhenByteLimitReached) {
+    AdmissionController admission(makeLimits(0, 1000));
+    auto queue = createTaskQueue(TaskQueueEngine::Linked, 16);
+
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>(600)));
+    EXPECT_EQ(admission.getQueuedBytes(), 600u);
+    SubmitResult rejected = admission.submit(*queue, std::make_unique<SizedTask>(600));
+    EXPECT_EQ(rejected.status, SubmitStatus::BytesExceeded);
+    EXPECT_EQ(admission.getQueuedBytes(), 600u);
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>(400)));
+    EXPECT_EQ(admission.getQueuedBytes(), 1000u);
+}
+
+/**
+ * @brief 测试有界队列已满按拒绝处理并撤销计入
+ */
+TEST(AdmissionControllerTest, FullRingIsRejection) {
+    AdmissionController admission;
+    auto queue = createTaskQueue(TaskQueueEngine::RingBuffer, 2);
+    size_t capacity = 0;
+    while (admission.submit(*queue, std::make_unique<SizedTask>())) {
+        ++capacity;
+        ASSERT_LT(capacity, 1024u);
+    }
+    EXPECT_EQ(admission.getQueuedTasks(), capacity);
+    EXPECT_EQ(admission.getRejectedTasks(), 1u);
+}
+
+/**
+ * @brief 测试批量提交在第一个被拒绝的任务处停止，其余任务保留
+ */
+TEST(AdmissionControllerTest, BulkStopsAtFirstRejection) {
+    AdmissionController admission(makeLimits(3, 0));
+    auto queue = createTaskQueue(TaskQueueEngine::Linked, 16);
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back(std::make_unique<SizedTask>());
+    }
+    SubmitResult rejection = SubmitResult::accepted();
+    EXPECT_EQ(admission.submitBulk(*queue, tasks, &rejection), 3u);
+    EXPECT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(rejection.status, SubmitStatus::QueueFull);
+    EXPECT_EQ(admission.getRejectedTasks(), 2u);
+    EXPECT_EQ(queue->size(), 3u);
+}
+
+/**
+ * @brief 测试派生任务计入限额但不被拒绝
+ */
+TEST(AdmissionControllerTest, ChargedSubmitBypassesLimits) {
+    AdmissionController admission(makeLimits(1, 0));
+    auto queue = createTaskQueue(TaskQueueEngine::Linked, 16);
+
+    EXPECT_TRUE(admission.submit(*queue, std::make_unique<SizedTask>()));
+    EXPECT_TRUE(admission.submitCharged(*queue, std::make_unique<SizedTask>()));
+    EXPECT_EQ(admission.getQueuedTasks(), 2u);
+    EXPECT_EQ(admission.getRejectedTasks(), 0u);
+
+    while (auto task = queue->dequeue()) {
+        admission.release(*task);
+    }
+    EXPECT_EQ(admission.getQueuedTasks(), 0u);
+    EXPECT_EQ(admission.getQueuedBytes(), 0u);
+}
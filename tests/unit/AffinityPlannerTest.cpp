@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include "core/resource/AffinityPlanner.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief 构造 nodes 个节点、每节点 domainsPerNode 个缓存域、每域 cpusPerDomain 个CPU的拓扑
+ */
+CpuTopology makeTopology(int nodes, int domainsPerNode, int cpusPerDomain) {
+    std::vector<CpuTopology::Cpu> cpus;
+    int id = 0;
+    for (int node = 0; node < nodes; ++node) {
+        for (int domain = 0; domain < domainsPerNode; ++domain) {
+            int first = id;
+            for (int i = 0; i < cpusPerDomain; ++i) {
+                cpus.push_back({id++, node, first});
+            }
+        }
+    }
+    return CpuTopology::fromCpus(cpus);
+}
+
+std::set<int> domainsOf(const CpuTopology& topology, const std::vector<int>& cpus) {
+    std::set<int> domains;
+    for (const auto& cpu : topology.getCpus()) {
+        if (std::find(cpus.begin(), cpus.end(), cpu.id) != cpus.end()) {
+            domains.insert(cpu.cacheDomain);
+        }
+    }
+    return domains;
+}
+
+} // namespace
+
+/**
+ * @brief 测试能放进单个缓存域的租户不跨域，且租户之间不重叠
+ */
+TEST(AffinityPlannerTest, SmallTenantsStayInOneCacheDomain) {
+    AffinityPlanner planner(makeTopology(2, 2, 4));
+    auto placement = planner.plan({{"a", 4}, {"b", 3}, {"c", 2}});
+
+    ASSERT_EQ(placement.size(), 3u);
+    EXPECT_EQ(placement["a"].size(), 4u);
+    EXPECT_EQ(placement["b"].size(), 3u);
+    EXPECT_EQ(placement["c"].size(), 2u);
+
+    std::set<int> used;
+    for (const auto& [tenantId, cpus] : placement) {
+        EXPECT_EQ(domainsOf(planner.getTopology(), cpus).size(), 1u) << tenantId;
+        for (int cpu : cpus) {
+            EXPECT_TRUE(used.insert(cpu).second) << "cpu " << cpu << " shared by " << tenantId;
+        }
+    }
+}
+
+/**
+ * @brief 测试超过缓存域但不超过节点的租户留在单个NUMA节点内
+ */
+TEST(AffinityPlannerTest, LargeTenantStaysInOneNode) {
+    AffinityPlanner planner(makeTopology(2, 2, 4));
+    auto placement = planner.plan({{"big", 8}, {"small", 2}});
+
+    std::set<int> nodes;
+    for (int cpu : placement["big"]) {
+        nodes.insert(planner.getTopology().nodeOf(cpu));
+    }
+    EXPECT_EQ(placement["big"].size(), 8u);
+    EXPECT_EQ(nodes.size(), 1u);
+    // 小租户放到另一个节点的空闲缓存域
+    EXPECT_NE(planner.getTopology().nodeOf(placement["small"].front()), *nodes.begin());
+}
+
+/**
+ * @brief 测试线程数超过CPU数时按比例缩小占用范围并覆盖全部CPU
+ */
+TEST(AffinityPlannerTest, OversubscriptionScalesWidth) {
+    AffinityPlanner planner(makeTopology(1, 2, 4));
+    auto placement = planner.plan({{"a", 40}, {"b", 20}, {"c", 20}});
+
+    EXPECT_EQ(placement["a"].size(), 4u);
+    EXPECT_EQ(placement["b"].size(), 2u);
+    EXPECT_EQ(placement["c"].size(), 2u);
+
+    std::set<int> used;
+    for (const auto& [tenantId, cpus] : placement) {
+        used.insert(cpus.begin(), cpus.end());
+    }
+    EXPECT_EQ(used.size(), 8u);
+}
+
+/**
+ * @brief 测试删除租户后重新规划释放其CPU，结果可重复
+ */
+TEST(AffinityPlannerTest, ReplanAfterRemoval) {
+    AffinityPlanner planner(makeTopology(1, 2, 2));
+    auto before = planner.plan({{"a", 2}, {"b", 2}});
+    EXPECT_NE(before["a"], before["b"]);
+
+    auto after = planner.plan({{"b", 2}});
+    ASSERT_EQ(after.size(), 1u);
+    EXPECT_EQ(after["b"].size(), 2u);
+    EXPECT_EQ(planner.plan({{"b", 2}}), after);
+    EXPECT_TRUE(planner.plan({}).empty());
+}
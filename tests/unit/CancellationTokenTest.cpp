@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "core/resource/CancellationToken.h"
+#include "core/resource/TaskQueue.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief 测试用长任务，协作式检查取消，记录执行的步数
+ */
+class PollingTask : public Task {
+public:
+    void execute() override {
+        for (steps_ = 0; steps_ < 1000000 && !shouldStop(); ++steps_) {
+        }
+    }
+    bool isValid() const override { return true; }
+
+    int getSteps() const { return steps_; }
+
+private:
+    int steps_ = 0;
+};
+
+} // namespace
+
+/**
+ * @brief 测试默认令牌不可取消，复制出的令牌共享取消标志
+ */
+TEST(CancellationTokenTest, CopiesShareState) {
+    CancellationToken none;
+    EXPECT_FALSE(none.isCancellable());
+    none.cancel();
+    EXPECT_FALSE(none.isCancelled());
+
+    CancellationToken token = CancellationToken::create();
+    CancellationToken copy = token;
+    EXPECT_TRUE(copy.isCancellable());
+    EXPECT_FALSE(copy.isCancelled());
+
+    token.cancel();
+    EXPECT_TRUE(copy.isCancelled());
+    EXPECT_FALSE(CancellationToken::create().isCancelled());
+}
+
+/**
+ * @brief 测试任务截止时间与取消状态的判断
+ */
+TEST(CancellationTokenTest, ClassifyDequeuedTask) {
+    PollingTask task;
+    EXPECT_FALSE(task.hasDeadline());
+    EXPECT_EQ(classifyDequeuedTask(task), TaskDisposition::Run);
+
+    auto now = std::chrono::steady_clock::now();
+    task.setDeadline(now + std::chrono::seconds(10));
+    EXPECT_TRUE(task.hasDeadline());
+    EXPECT_FALSE(task.isExpired(now));
+    EXPECT_TRUE(task.isExpired(now + std::chrono::seconds(10)));
+    EXPECT_EQ(classifyDequeuedTask(task), TaskDisposition::Run);
+
+    task.setDeadline(now - std::chrono::milliseconds(1));
+    EXPECT_EQ(classifyDequeuedTask(task), TaskDisposition::Expired);
+
+    // 取消优先于超时
+    CancellationToken token = CancellationToken::create();
+    task.setCancellationToken(token);
+    token.cancel();
+    EXPECT_TRUE(task.isCancelled());
+    EXPECT_EQ(classifyDequeuedTask(task), TaskDisposition::Cancelled);
+}
+
+/**
+ * @brief 测试执行中的任务通过shouldStop协作式结束
+ */
+TEST(CancellationTokenTest, RunningTaskStopsCooperatively) {
+    PollingTask cancelled;
+    CancellationToken token = CancellationToken::create();
+    cancelled.setCancellationToken(token);
+    token.cancel();
+    cancelled.execute();
+    EXPECT_EQ(cancelled.getSteps(), 0);
+
+    PollingTask expired;
+    expired.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    expired.execute();
+    EXPECT_EQ(expired.getSteps(), 0);
+
+    PollingTask unbounded;
+    unbounded.execute();
+    EXPECT_EQ(unbounded.getSteps(), 1000000);
+}
@@ -0,0 +1,515 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "core/resource/CgroupController.h"
+#include "core/resource/CpuResourceManager.h"
+#include "core/resource/DiskResourceManager.h"
+#include "core/resource/MemoryResourceManager.h"
+#include "core/resource/PressureMonitor.h"
+#include "core/resource/TenantThreadGroup.h"
+#include "core/tenant/TenantContext.h"
+
+using namespace yao;
+namespace fs = std::filesystem;
+
+/**
+ * @brief CgroupController 单元测试类，在临时目录中伪造cgroup层级
+ */
+class CgroupControllerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::temp_directory_path() / ("cgroup_controller_test_" + std::to_string(::getpid()));
+        fs::remove_all(root_);
+        fs::create_directories(root_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(root_);
+    }
+
+    void writeFile(const fs::path& path, const std::string& content) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << content << "\n";
+    }
+
+    /**
+     * @brief 创建空的接口文件（真实cgroupfs中由内核随目录创建）
+     */
+    void touchFile(const fs::path& path) {
+        fs::create_directories(path.parent_path());
+        std::ofstream{path};
+    }
+
+    std::vector<std::string> readLines(const fs::path& path) {
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::string readFile(const fs::path& path) {
+        std::ifstream file(path);
+        std::string content;
+        std::getline(file, content);
+        return content;
+    }
+
+    fs::path root_;
+};
+
+/**
+ * @brief 测试按挂载根目录探测层级版本
+ */
+TEST_F(CgroupControllerTest, DetectVersion) {
+    EXPECT_EQ(detectCgroupVersion(root_.string()), CgroupVersion::None);
+
+    fs::create_directories(root_ / "cpu");
+    EXPECT_EQ(detectCgroupVersion(root_.string()), CgroupVersion::V1);
+
+    // 统一层级不含cpu控制器（混合模式）时仍使用v1
+    writeFile(root_ / "cgroup.controllers", "memory pids");
+    EXPECT_EQ(detectCgroupVersion(root_.string()), CgroupVersion::V1);
+
+    writeFile(root_ / "cgroup.controllers", "cpuset cpu io memory pids");
+    EXPECT_EQ(detectCgroupVersion(root_.string()), CgroupVersion::V2);
+}
+
+/**
+ * @brief 测试cpu.shares到cpu.weight的换算
+ */
+TEST_F(CgroupControllerTest, SharesToWeight) {
+    EXPECT_EQ(CgroupController::sharesToWeight(1024), 100u);
+    EXPECT_EQ(CgroupController::sharesToWeight(2048), 200u);
+    EXPECT_EQ(CgroupController::sharesToWeight(2), 1u);
+    EXPECT_EQ(CgroupController::sharesToWeight(262144), 10000u);
+    EXPECT_LT(CgroupController::sharesToWeight(512), CgroupController::sharesToWeight(2048));
+}
+
+/**
+ * @brief 测试v2层级：线程化子树、cpu.weight、cpu.max、cgroup.threads与cpu.stat
+ */
+TEST_F(CgroupControllerTest, V2Backend) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    EXPECT_EQ(readFile(base / "cgroup.subtree_control"), "+cpu");
+    EXPECT_EQ(readFile(base / "cgroup.procs"), std::to_string(::getpid()));
+
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a", 2048));
+    fs::path tenant = base / "tenant_a";
+    EXPECT_EQ(readFile(tenant / "cgroup.type"), "threaded");
+    EXPECT_EQ(readFile(tenant / "cpu.weight"), std::to_string(CgroupController::sharesToWeight(2048)));
+    EXPECT_FALSE(fs::exists(tenant / "cpu.shares"));
+
+    ASSERT_TRUE(controller.setCpuMax("tenant_a", 200000, 100000));
+    EXPECT_EQ(readFile(tenant / "cpu.max"), "200000 100000");
+    ASSERT_TRUE(controller.setCpuMax("tenant_a", -1));
+    EXPECT_EQ(readFile(tenant / "cpu.max"), "max 100000");
+
+    touchFile(tenant / "cgroup.threads");
+    ASSERT_TRUE(controller.addThread("tenant_a", currentThreadTid()));
+    EXPECT_EQ(readFile(tenant / "cgroup.threads"), std::to_string(currentThreadTid()));
+    EXPECT_FALSE(fs::exists(tenant / "tasks"));
+
+    writeFile(tenant / "cpu.stat",
+              "usage_usec 1500\nuser_usec 1000\nsystem_usec 500\nnr_periods 10\nnr_throttled 2\nthrottled_usec 250");
+    EXPECT_EQ(controller.getCpuUsage("tenant_a"), 1500000u);
+    EXPECT_EQ(controller.getThrottledTime("tenant_a"), 250000u);
+
+    ASSERT_TRUE(controller.removeTenantCgroup("tenant_a"));
+    EXPECT_FALSE(fs::exists(tenant));
+}
+
+/**
+ * @brief 测试v1层级：cpu.shares、CFS带宽、tasks与cpuacct统计
+ */
+TEST_F(CgroupControllerTest, V1Backend) {
+    fs::path base = root_ / "cpu" / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V1);
+    ASSERT_TRUE(controller.initialize());
+    EXPECT_FALSE(fs::exists(base / "cgroup.procs"));
+
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_b", 512));
+    fs::path tenant = base / "tenant_b";
+    EXPECT_EQ(readFile(tenant / "cpu.shares"), "512");
+
+    ASSERT_TRUE(controller.setCpuMax("tenant_b", 50000, 100000));
+    EXPECT_EQ(readFile(tenant / "cpu.cfs_quota_us"), "50000");
+    EXPECT_EQ(readFile(tenant / "cpu.cfs_period_us"), "100000");
+
+    touchFile(tenant / "tasks");
+    ASSERT_TRUE(controller.addThread("tenant_b", currentThreadTid()));
+    EXPECT_EQ(readFile(tenant / "tasks"), std::to_string(currentThreadTid()));
+
+    writeFile(tenant / "cpuacct.usage", "123456789");
+    writeFile(tenant / "cpu.stat", "nr_periods 10\nnr_throttled 3\nthrottled_time 4200");
+    EXPECT_EQ(controller.getCpuUsage("tenant_b"), 123456789u);
+    EXPECT_EQ(controller.getThrottledTime("tenant_b"), 4200u);
+    EXPECT_EQ(controller.getThrottledTime("missing"), 0u);
+}
+
+/**
+ * @brief 测试批量加入：重复的TID只写入一次
+ */
+TEST_F(CgroupControllerTest, AddThreadsInOnePass) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a"));
+
+    // 接口文件不存在时不自行创建
+    EXPECT_FALSE(controller.addThreads("tenant_a", {101}));
+    EXPECT_FALSE(fs::exists(base / "tenant_a" / "cgroup.threads"));
+
+    touchFile(base / "tenant_a" / "cgroup.threads");
+    EXPECT_TRUE(controller.addThreads("tenant_a", {101, 102, 103}));
+    EXPECT_TRUE(controller.addThreads("tenant_a", {102, 104}));
+    EXPECT_EQ(readLines(base / "tenant_a" / "cgroup.threads"),
+              (std::vector<std::string>{"101", "102", "103", "104"}));
+    EXPECT_FALSE(controller.addThreads("missing", {101}));
+}
+
+/**
+ * @brief 测试线程组的工作线程以自身内核TID加入租户cgroup，扩容的线程同样加入
+ */
+TEST_F(CgroupControllerTest, WorkersAttachOwnTids) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a"));
+    touchFile(base / "tenant_a" / "cgroup.threads");
+
+    TenantThreadGroup group("tenant_a", 3, &controller);
+    ASSERT_TRUE(group.start());
+    ASSERT_TRUE(group.resize(5));
+
+    fs::path threads = base / "tenant_a" / "cgroup.threads";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (readLines(threads).size() < 5 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::vector<std::string> lines = readLines(threads);
+    ASSERT_EQ(lines.size(), 5u);
+
+    std::string self = std::to_string(currentThreadTid());
+    for (const auto& line : lines) {
+        EXPECT_NE(line, self);
+        EXPECT_GT(std::stol(line), 0);
+    }
+    std::sort(lines.begin(), lines.end());
+    EXPECT_EQ(std::unique(lines.begin(), lines.end()), lines.end());
+    group.stop();
+}
+
+/**
+ * @brief 测试缓存的描述符每次从头读取到最新内容，删除重建后重新打开
+ */
+TEST_F(CgroupControllerTest, CachedStatFilesSeeUpdates) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a"));
+
+    fs::path stat = base / "tenant_a" / "cpu.stat";
+    writeFile(stat, "usage_usec 10\nnr_periods 4\nnr_throttled 1\nthrottled_usec 3");
+    CgroupCpuSample sample;
+    ASSERT_TRUE(controller.readCpuSample("tenant_a", sample));
+    EXPECT_EQ(sample.usageNs, 10000u);
+    EXPECT_EQ(sample.periods, 4u);
+    EXPECT_EQ(sample.throttledPeriods, 1u);
+    EXPECT_EQ(sample.throttledNs, 3000u);
+
+    writeFile(stat, "usage_usec 123456789012\nnr_periods 9\nnr_throttled 2\nthrottled_usec 7");
+    EXPECT_EQ(controller.getCpuUsage("tenant_a"), 123456789012000u);
+    EXPECT_EQ(controller.getThrottledTime("tenant_a"), 7000u);
+
+    ASSERT_TRUE(controller.removeTenantCgroup("tenant_a"));
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a"));
+    writeFile(stat, "usage_usec 5");
+    EXPECT_EQ(controller.getCpuUsage("tenant_a"), 5000u);
+}
+
+/**
+ * @brief 测试批量采集：跳过统计不可读的租户，复用已有的输出元素
+ */
+TEST_F(CgroupControllerTest, CollectAllTenants) {
+    fs::path base = root_ / "cpu" / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V1);
+    ASSERT_TRUE(controller.initialize());
+    for (const char* tenant : {"tenant_a", "tenant_b", "tenant_c"}) {
+        ASSERT_TRUE(controller.createTenantCgroup(tenant));
+    }
+    writeFile(base / "tenant_a" / "cpuacct.usage", "100");
+    writeFile(base / "tenant_a" / "cpu.stat", "nr_periods 5\nnr_throttled 2\nthrottled_time 40");
+    writeFile(base / "tenant_b" / "cpuacct.usage", "200");
+
+    std::vector<CgroupCpuSample> samples(8);
+    EXPECT_EQ(controller.collectAll(samples), 2u);
+    ASSERT_EQ(samples.size(), 2u);
+    std::sort(samples.begin(), samples.end(),
+              [](const CgroupCpuSample& a, const CgroupCpuSample& b) { return a.tenantId < b.tenantId; });
+    EXPECT_EQ(samples[0].tenantId, "tenant_a");
+    EXPECT_EQ(samples[0].usageNs, 100u);
+    EXPECT_EQ(samples[0].throttledNs, 40u);
+    EXPECT_EQ(samples[0].throttledPeriods, 2u);
+    EXPECT_EQ(samples[1].tenantId, "tenant_b");
+    EXPECT_EQ(samples[1].usageNs, 200u);
+    EXPECT_EQ(samples[1].throttledNs, 0u);
+
+    writeFile(base / "tenant_c" / "cpuacct.usage", "300");
+    EXPECT_EQ(controller.collectAll().size(), 3u);
+}
+
+/**
+ * @brief 测试没有可用CPU控制器时初始化失败
+ */
+TEST_F(CgroupControllerTest, NoControllerFailsInitialize) {
+    CgroupController controller("", CgroupVersion::None);
+    EXPECT_FALSE(controller.initialize());
+}
+
+/**
+ * @brief 测试v2内存cgroup：独立的域子树、memory.high/memory.max、进程加入与事件计数
+ */
+TEST_F(CgroupControllerTest, MemoryLimitsV2) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_a"));
+    EXPECT_FALSE(controller.hasMemoryCgroup("tenant_a"));
+    EXPECT_FALSE(controller.attachProcess("tenant_a", ::getpid()));
+
+    ASSERT_TRUE(controller.setMemoryLimit("tenant_a", 900, 1000));
+    fs::path memory = root_ / "yaobase-procs" / "tenant_a";
+    EXPECT_EQ(controller.processCgroupPath("memory", "tenant_a"), memory.string());
+    EXPECT_TRUE(controller.hasMemoryCgroup("tenant_a"));
+    EXPECT_EQ(readFile(root_ / "yaobase-procs" / "cgroup.subtree_control"), "+memory");
+    EXPECT_EQ(readFile(memory / "memory.high"), "900");
+    EXPECT_EQ(readFile(memory / "memory.max"), "1000");
+    EXPECT_FALSE(controller.hasMemoryMembers("tenant_a"));
+
+    ASSERT_TRUE(controller.attachProcess("tenant_a", ::getpid()));
+    EXPECT_EQ(readFile(memory / "cgroup.procs"), std::to_string(::getpid()));
+    EXPECT_TRUE(controller.hasMemoryMembers("tenant_a"));
+
+    writeFile(memory / "memory.current", "4096");
+    writeFile(memory / "memory.events", "low 0\nhigh 7\nmax 2\noom 1\noom_kill 1\noom_group_kill 0");
+    CgroupMemoryEvents events;
+    ASSERT_TRUE(controller.readMemoryEvents("tenant_a", events));
+    EXPECT_EQ(events.high, 7u);
+    EXPECT_EQ(events.max, 2u);
+    EXPECT_EQ(events.oom, 1u);
+    EXPECT_EQ(events.oomKill, 1u);
+    EXPECT_EQ(controller.getMemoryUsage("tenant_a"), 4096u);
+
+    ASSERT_TRUE(controller.setMemoryLimit("tenant_a", 0, 0));
+    EXPECT_EQ(readFile(memory / "memory.high"), "max");
+    EXPECT_EQ(readFile(memory / "memory.max"), "max");
+
+    ASSERT_TRUE(controller.removeTenantCgroup("tenant_a"));
+    EXPECT_FALSE(fs::exists(memory));
+    EXPECT_FALSE(controller.hasMemoryCgroup("tenant_a"));
+}
+
+/**
+ * @brief 测试v1内存cgroup：使用memory子系统自己的层级，未挂载时失败
+ */
+TEST_F(CgroupControllerTest, MemoryLimitsV1) {
+    fs::path base = root_ / "cpu" / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V1);
+    ASSERT_TRUE(controller.initialize());
+    EXPECT_FALSE(controller.setMemoryLimit("tenant_b", 900, 1000));
+
+    fs::create_directories(root_ / "memory");
+    ASSERT_TRUE(controller.setMemoryLimit("tenant_b", 900, 1000));
+    fs::path memory = root_ / "memory" / "yaobase" / "tenant_b";
+    EXPECT_EQ(readFile(memory / "memory.soft_limit_in_bytes"), "900");
+    EXPECT_EQ(readFile(memory / "memory.limit_in_bytes"), "1000");
+
+    writeFile(memory / "memory.usage_in_bytes", "2048");
+    writeFile(memory / "memory.failcnt", "5");
+    writeFile(memory / "memory.oom_control", "oom_kill_disable 0\nunder_oom 0\noom_kill 2");
+    CgroupMemoryEvents events;
+    ASSERT_TRUE(controller.readMemoryEvents("tenant_b", events));
+    EXPECT_EQ(events.max, 5u);
+    EXPECT_EQ(events.oom, 0u);
+    EXPECT_EQ(events.oomKill, 2u);
+    EXPECT_EQ(controller.getMemoryUsage("tenant_b"), 2048u);
+
+    ASSERT_TRUE(controller.setMemoryLimit("tenant_b", 0, 0));
+    EXPECT_EQ(readFile(memory / "memory.limit_in_bytes"), "-1");
+}
+
+/**
+ * @brief 测试v2 IO隔离：io.max、io.weight与io.stat，与内存共用租户的域cgroup
+ */
+TEST_F(CgroupControllerTest, IoLimitsV2) {
+    fs::path base = root_ / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller.initialize());
+    EXPECT_FALSE(controller.setIoLimit("tenant_a", "", CgroupIoLimit()));
+
+    // io是域控制器，工作线程无法加入；没有进程时上限不会生效，报告失败且不写入
+    CgroupIoLimit limit;
+    limit.readBps = 1048576;
+    limit.writeIops = 200;
+    EXPECT_FALSE(controller.canEnforceIo("tenant_a"));
+    EXPECT_FALSE(controller.setIoLimit("tenant_a", "8:0", limit));
+    EXPECT_FALSE(controller.setIoWeight("tenant_a", 250));
+    EXPECT_FALSE(controller.hasIoCgroup("tenant_a"));
+
+    fs::path tenant = root_ / "yaobase-procs" / "tenant_a";
+    ASSERT_TRUE(controller.setMemoryLimit("tenant_a", 0, 0));
+    ASSERT_TRUE(controller.attachProcess("tenant_a", ::getpid()));
+    EXPECT_EQ(readLines(tenant / "cgroup.procs"), std::vector<std::string>{std::to_string(::getpid())});
+    EXPECT_TRUE(controller.canEnforceIo("tenant_a"));
+
+    ASSERT_TRUE(controller.setIoLimit("tenant_a", "8:0", limit));
+    ASSERT_TRUE(controller.setIoWeight("tenant_a", 250));
+    EXPECT_TRUE(controller.hasIoCgroup("tenant_a"));
+    EXPECT_EQ(controller.processCgroupPath("io", "tenant_a"), tenant.string());
+    EXPECT_EQ(readFile(tenant / "io.max"), "8:0 rbps=1048576 wbps=max riops=max wiops=200");
+    EXPECT_EQ(readFile(tenant / "io.weight"), "default 250");
+    EXPECT_TRUE(controller.hasIoMembers("tenant_a"));
+
+    writeFile(tenant / "io.stat",
+              "259:0 rbytes=100 wbytes=200 rios=3 wios=4 dbytes=0 dios=0\n8:0 rbytes=5 wbytes=6 rios=7 wios=8");
+    std::vector<CgroupIoStat> stats;
+    ASSERT_TRUE(controller.readIoStats("tenant_a", stats));
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].device, "259:0");
+    EXPECT_EQ(stats[0].readBytes, 100u);
+    EXPECT_EQ(stats[0].writeBytes, 200u);
+    EXPECT_EQ(stats[0].readIos, 3u);
+    EXPECT_EQ(stats[0].writeIos, 4u);
+    EXPECT_EQ(stats[1].device, "8:0");
+    EXPECT_EQ(stats[1].writeIos, 8u);
+
+    ASSERT_TRUE(controller.setIoLimit("tenant_a", "8:0", CgroupIoLimit()));
+    EXPECT_EQ(readFile(tenant / "io.max"), "8:0 rbps=max wbps=max riops=max wiops=max");
+}
+
+/**
+ * @brief 测试v1 IO隔离：blkio.throttle.*与blkio.weight，统计来自io_service_bytes/io_serviced
+ */
+TEST_F(CgroupControllerTest, IoLimitsV1) {
+    fs::path base = root_ / "cpu" / "yaobase";
+    CgroupController controller(base.string(), CgroupVersion::V1);
+    ASSERT_TRUE(controller.initialize());
+    fs::path tenant = root_ / "blkio" / "yaobase" / "tenant_b";
+    touchFile(tenant / "tasks");
+
+    // 已加入CPU cgroup的工作线程在创建blkio cgroup时按线程加入
+    ASSERT_TRUE(controller.createTenantCgroup("tenant_b"));
+    touchFile(base / "tenant_b" / "tasks");
+    ASSERT_TRUE(controller.addThreads("tenant_b", {201, 202}));
+    EXPECT_FALSE(controller.hasIoMembers("tenant_b"));
+
+    CgroupIoLimit limit;
+    limit.writeBps = 4096;
+    ASSERT_TRUE(controller.setIoLimit("tenant_b", "8:16", limit));
+    ASSERT_TRUE(controller.setIoWeight("tenant_b", 100));
+    EXPECT_EQ(readLines(tenant / "tasks"), (std::vector<std::string>{"201", "202"}));
+    EXPECT_TRUE(controller.hasIoMembers("tenant_b"));
+
+    // 之后加入的线程同时写入cpu与blkio
+    ASSERT_TRUE(controller.addThreads("tenant_b", {203}));
+    EXPECT_EQ(readLines(tenant / "tasks"), (std::vector<std::string>{"201", "202", "203"}));
+    EXPECT_EQ(readLines(base / "tenant_b" / "tasks"), (std::vector<std::string>{"201", "202", "203"}));
+
+    EXPECT_EQ(readFile(tenant / "blkio.throttle.read_bps_device"), "8:16 0");
+    EXPECT_EQ(readFile(tenant / "blkio.throttle.write_bps_device"), "8:16 4096");
+    EXPECT_EQ(readFile(tenant / "blkio.weight"), "500");
+
+    writeFile(tenant / "blkio.throttle.io_service_bytes",
+              "8:16 Read 4096\n8:16 Write 8192\n8:16 Sync 0\n8:16 Async 12288\n8:16 Total 12288\nTotal 12288");
+    writeFile(tenant / "blkio.throttle.io_serviced", "8:16 Read 1\n8:16 Write 2\n8:16 Total 3\nTotal 3");
+    std::vector<CgroupIoStat> stats;
+    ASSERT_TRUE(controller.readIoStats("tenant_b", stats));
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].device, "8:16");
+    EXPECT_EQ(stats[0].readBytes, 4096u);
+    EXPECT_EQ(stats[0].writeBytes, 8192u);
+    EXPECT_EQ(stats[0].readIos, 1u);
+    EXPECT_EQ(stats[0].writeIos, 2u);
+
+    // 移除的线程移回blkio层级根，不再受租户IO上限约束
+    touchFile(root_ / "blkio" / "tasks");
+    ASSERT_TRUE(controller.removeThread("tenant_b", 203));
+    EXPECT_EQ(readLines(root_ / "blkio" / "tasks"), std::vector<std::string>{"203"});
+
+    ASSERT_TRUE(controller.removeTenantCgroup("tenant_b"));
+    EXPECT_FALSE(fs::exists(tenant));
+}
+
+/**
+ * @brief 测试解析路径所在的块设备号
+ */
+TEST_F(CgroupControllerTest, BlockDeviceOfPath) {
+    std::string device = CgroupController::blockDeviceOf(root_.string());
+    ASSERT_FALSE(device.empty());
+    EXPECT_NE(device.find(':'), std::string::npos);
+    EXPECT_TRUE(CgroupController::blockDeviceOf((root_ / "missing").string()).empty());
+}
+
+/**
+ * @brief 测试控制器释放后（与ThreadPoolManager::shutdown()相同）资源管理器退化为只记账：
+ * 释放资源与采样不再访问已销毁的控制器
+ */
+TEST_F(CgroupControllerTest, ManagersOutliveController) {
+    auto controller = std::make_shared<CgroupController>((root_ / "yaobase").string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller->initialize());
+    writeFile(root_ / "pressure" / "cpu", "some avg10=0.00 avg60=0.00 avg300=0.00 total=0");
+
+    auto& cpuManager = CpuResourceManager::getInstance();
+    auto& memManager = MemoryResourceManager::getInstance();
+    auto& diskManager = DiskResourceManager::getInstance();
+    auto& pressure = PressureMonitor::getInstance();
+    ASSERT_TRUE(cpuManager.initializeCgroup(true, controller));
+    memManager.initialize(8192);
+    ASSERT_TRUE(memManager.initializeCgroup(controller));
+    diskManager.initialize(100);
+    ASSERT_TRUE(diskManager.initializeCgroup(controller, "8:0", CgroupIoLimit()));
+    ASSERT_TRUE(pressure.initialize((root_ / "pressure").string(), controller));
+    pressure.registerTenant("lifetime_tenant");
+
+    auto tenant = std::make_shared<TenantContext>("lifetime_tenant", 1, 256ULL << 20, 1ULL << 30);
+    ASSERT_TRUE(cpuManager.allocateCpuResource(tenant));
+    ASSERT_TRUE(memManager.allocateMemoryResource(tenant));
+    ASSERT_TRUE(diskManager.allocateDiskResource(tenant));
+    EXPECT_TRUE(fs::exists(root_ / "yaobase" / "lifetime_tenant"));
+    EXPECT_TRUE(fs::exists(root_ / "yaobase-procs" / "lifetime_tenant"));
+
+    // 唯一的强引用释放后控制器立即销毁并删除租户cgroup
+    controller.reset();
+    EXPECT_FALSE(fs::exists(root_ / "yaobase" / "lifetime_tenant"));
+    EXPECT_FALSE(fs::exists(root_ / "yaobase-procs" / "lifetime_tenant"));
+
+    cpuManager.refreshThrottleStats();
+    EXPECT_DOUBLE_EQ(cpuManager.getThrottleStats("lifetime_tenant").throttledRatio, 0.0);
+    EXPECT_EQ(memManager.refreshCgroupStats("lifetime_tenant").usageBytes, 0u);
+    EXPECT_TRUE(diskManager.getTenantIoStats("lifetime_tenant").empty());
+    EXPECT_FALSE(diskManager.setTenantIoLimit("lifetime_tenant", CgroupIoLimit()));
+    pressure.sample();
+    EXPECT_DOUBLE_EQ(pressure.getTenantPressure("lifetime_tenant").worst(), 0.0);
+
+    EXPECT_TRUE(cpuManager.releaseCpuResource("lifetime_tenant"));
+    memManager.releaseMemoryResource("lifetime_tenant");
+    diskManager.releaseDiskResource("lifetime_tenant");
+    EXPECT_LT(memManager.getTenantMemoryUsage("lifetime_tenant"), 0.0);
+    EXPECT_LT(diskManager.getTenantDiskUsage("lifetime_tenant"), 0.0);
+
+    pressure.unregisterTenant("lifetime_tenant");
+    pressure.initialize((root_ / "missing").string());
+    cpuManager.initializeCgroup(false);
+    memManager.initializeCgroup(nullptr);
+    diskManager.initializeCgroup(nullptr, "", CgroupIoLimit());
+}
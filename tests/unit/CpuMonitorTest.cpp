@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "core/resource/CpuMonitor.h"
+#include "core/resource/CpuResourceManager.h"
+#include "core/resource/ThreadPoolManager.h"
+#include "core/tenant/TenantContext.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 在当前线程上忙等，直到消耗cpuMs毫秒的线程CPU时间
+ */
+void burnCpu(int cpuMs) {
+    timespec start{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    timespec now = start;
+    while ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < cpuMs) {
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief CpuMonitor 单元测试类，直接构造租户上下文，不依赖TenantManager
+ */
+class CpuMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ThreadGroupOptions options;
+        options.queueEngine = TaskQueueEngine::RingBuffer;
+        ASSERT_TRUE(ThreadPoolManager::getInstance().initialize(16, false, options));
+        tenant_ = std::make_shared<TenantContext>("cpu_monitor_tenant", 1, 512ULL << 20, 1ULL << 30);
+    }
+
+    void TearDown() override {
+        CpuMonitor::getInstance().unregisterTenant(tenant_->getTenantId());
+        CpuResourceManager::getInstance().releaseCpuResource(tenant_->getTenantId());
+        ThreadPoolManager::getInstance().shutdown();
+    }
+
+    std::shared_ptr<TenantContext> tenant_;
+};
+
+/**
+ * @brief 测试按工作线程的CPU时间计算使用率，并写入CpuResourceManager
+ */
+TEST_F(CpuMonitorTest, MeasuresWorkerCpuTime) {
+    auto& threadManager = ThreadPoolManager::getInstance();
+    auto& cpuManager = CpuResourceManager::getInstance();
+    auto& monitor = CpuMonitor::getInstance();
+    const std::string& tenantId = tenant_->getTenantId();
+
+    ASSERT_TRUE(threadManager.createTenantThreadGroup(tenantId, 1));
+    ASSERT_TRUE(cpuManager.allocateCpuResource(tenant_));
+    monitor.registerTenant(tenant_);
+
+    uint64_t before = 0;
+    ASSERT_TRUE(threadManager.getTenantCpuTime(tenantId, before));
+    monitor.sample();
+    EXPECT_LT(monitor.getTenantUsage(tenantId), 0.0);  // 只采样一次时没有增量
+
+    std::atomic<bool> done{false};
+    ASSERT_TRUE(threadManager.submitTask(tenantId, std::make_unique<FunctionTask>([&]() {
+        burnCpu(200);
+        done.store(true);
+    })));
+    while (!done.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    monitor.sample();
+
+    uint64_t after = 0;
+    ASSERT_TRUE(threadManager.getTenantCpuTime(tenantId, after));
+    EXPECT_GE(after - before, 200ULL * 1000000);
+
+    double usage = monitor.getTenantUsage(tenantId);
+    EXPECT_GT(usage, 0.2);
+    EXPECT_LT(usage, 1.5);
+    EXPECT_DOUBLE_EQ(cpuManager.getTenantCpuUsage(tenantId), usage);
+    EXPECT_GE(threadManager.getTenantThreadInfo(tenantId).cpuSeconds, 0.2);
+}
+
+/**
+ * @brief 测试未分配CPU资源的租户只记录使用率，不写入CpuResourceManager
+ */
+TEST_F(CpuMonitorTest, SkipsUnallocatedTenants) {
+    auto& threadManager = ThreadPoolManager::getInstance();
+    auto& monitor = CpuMonitor::getInstance();
+    const std::string& tenantId = tenant_->getTenantId();
+
+    EXPECT_LT(monitor.getTenantUsage("missing_tenant"), 0.0);
+
+    monitor.registerTenant(tenant_);
+    monitor.sample();  // 线程组尚未创建
+    ASSERT_TRUE(threadManager.createTenantThreadGroup(tenantId, 1));
+    monitor.sample();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    monitor.sample();
+
+    EXPECT_GE(monitor.getTenantUsage(tenantId), 0.0);
+    EXPECT_LT(CpuResourceManager::getInstance().getTenantCpuUsage(tenantId), 0.0);
+
+    monitor.unregisterTenant(tenantId);
+    EXPECT_LT(monitor.getTenantUsage(tenantId), 0.0);
+}
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+#include "core/resource/CgroupController.h"
 #include "core/resource/CpuResourceManager.h"
 #include "core/tenant/TenantManager.h"
 
+namespace fs = std::filesystem;
+
 using namespace yao;
 
 /**
@@ -108,6 +114,20 @@ TEST_F(CpuResourceManagerTest, MultipleUsageUpdates) {
     EXPECT_DOUBLE_EQ(cpuManager.getTenantCpuUsage("cpu_test_tenant"), 0.2);
 }
 
+/**
+ * @brief 测试只更新已分配租户的使用率，不为未分配的租户建立记录
+ */
+TEST_F(CpuResourceManagerTest, UpdateAllocatedUsageOnly) {
+    auto& cpuManager = CpuResourceManager::getInstance();
+
+    EXPECT_FALSE(cpuManager.updateAllocatedCpuUsage("nonexistent_tenant", 0.5));
+    EXPECT_EQ(cpuManager.getTenantCpuUsage("nonexistent_tenant"), -1.0);
+
+    cpuManager.updateCpuUsage("cpu_test_tenant", 0.1);
+    EXPECT_TRUE(cpuManager.updateAllocatedCpuUsage("cpu_test_tenant", 0.4));
+    EXPECT_DOUBLE_EQ(cpuManager.getTenantCpuUsage("cpu_test_tenant"), 0.4);
+}
+
 /**
  * @brief 测试边界值使用率
  */
@@ -122,3 +142,87 @@ TEST_F(CpuResourceManagerTest, BoundaryUsageValues) {
     cpuManager.updateCpuUsage("cpu_test_tenant", 1.0);
     EXPECT_DOUBLE_EQ(cpuManager.getTenantCpuUsage("cpu_test_tenant"), 1.0);
 }
+
+/**
+ * @brief 测试千分之一核配额换算为CFS带宽
+ */
+TEST(CpuBandwidthTest, ComputeFromMillicores) {
+    CpuBandwidth two = CpuResourceManager::computeBandwidth(2000, 100000, 0);
+    EXPECT_EQ(two.quotaUs, 200000);
+    EXPECT_EQ(two.periodUs, 100000u);
+    EXPECT_EQ(two.burstUs, 0u);
+
+    CpuBandwidth half = CpuResourceManager::computeBandwidth(500, 100000, 50);
+    EXPECT_EQ(half.quotaUs, 50000);
+    EXPECT_EQ(half.burstUs, 25000u);
+
+    // 配额不小于内核允许的1ms
+    EXPECT_EQ(CpuResourceManager::computeBandwidth(1, 100000, 0).quotaUs, 1000);
+    EXPECT_LT(CpuResourceManager::computeBandwidth(0, 100000, 0).quotaUs, 0);
+}
+
+/**
+ * @brief 测试TenantContext以千分之一核保存配额，核心数向上取整
+ */
+TEST(CpuBandwidthTest, TenantMillicores) {
+    TenantContext tenant("millicore_tenant", 2, 0, 0);
+    EXPECT_EQ(tenant.getCpuQuotaMillicores(), 2000);
+    tenant.setCpuQuotaMillicores(1500);
+    EXPECT_EQ(tenant.getCpuQuotaMillicores(), 1500);
+    EXPECT_EQ(tenant.getCpuQuota(), 2);
+    tenant.setCpuQuota(3);
+    EXPECT_EQ(tenant.getCpuQuotaMillicores(), 3000);
+}
+
+/**
+ * @brief 测试启用cgroup后分配资源写入份额与带宽上限，并读回限流统计
+ */
+TEST(CpuBandwidthTest, AllocateWritesCpuMaxAndReadsThrottling) {
+    fs::path root = fs::temp_directory_path() / ("cpu_bandwidth_test_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    auto controller = std::make_shared<CgroupController>((root / "yaobase").string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller->initialize());
+
+    auto& cpuManager = CpuResourceManager::getInstance();
+    cpuManager.configureBandwidth(100000, 20);
+    ASSERT_TRUE(cpuManager.initializeCgroup(true, controller));
+
+    auto tenant = std::make_shared<TenantContext>("bandwidth_tenant", 0, 0, 0);
+    tenant->setCpuQuotaMillicores(1500);
+    ASSERT_TRUE(cpuManager.allocateCpuResource(tenant));
+
+    fs::path dir = root / "yaobase" / "bandwidth_tenant";
+    auto readLine = [](const fs::path& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    };
+    EXPECT_EQ(readLine(dir / "cpu.max"), "150000 100000");
+    EXPECT_EQ(readLine(dir / "cpu.max.burst"), "30000");
+    EXPECT_EQ(readLine(dir / "cpu.weight"), std::to_string(CgroupController::sharesToWeight(1536)));
+
+    std::ofstream(dir / "cpu.stat") << "usage_usec 100\nnr_periods 10\nnr_throttled 2\nthrottled_usec 50\n";
+    cpuManager.refreshThrottleStats();
+    std::ofstream(dir / "cpu.stat") << "usage_usec 900\nnr_periods 20\nnr_throttled 11\nthrottled_usec 400\n";
+    cpuManager.refreshThrottleStats();
+    CpuThrottleStats stats = cpuManager.getThrottleStats("bandwidth_tenant");
+    EXPECT_EQ(stats.periods, 20u);
+    EXPECT_EQ(stats.throttledPeriods, 11u);
+    EXPECT_EQ(stats.throttledNs, 400000u);
+    EXPECT_DOUBLE_EQ(stats.throttledRatio, 0.9);
+
+    // 配额变更按千分之一核重新写入带宽
+    tenant->setCpuQuotaMillicores(250);
+    ASSERT_TRUE(cpuManager.updateCpuQuota(tenant));
+    EXPECT_EQ(readLine(dir / "cpu.max"), "25000 100000");
+
+    ASSERT_TRUE(cpuManager.releaseCpuResource("bandwidth_tenant"));
+    EXPECT_FALSE(cpuManager.updateCpuQuota(tenant));
+    EXPECT_EQ(readLine(dir / "cpu.max"), "max 100000");
+    EXPECT_DOUBLE_EQ(cpuManager.getThrottleStats("bandwidth_tenant").throttledRatio, 0.0);
+
+    cpuManager.initializeCgroup(false);
+    cpuManager.configureBandwidth(100000, 0);
+    fs::remove_all(root);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "core/resource/CpuTopology.h"
+
+using namespace yao;
+namespace fs = std::filesystem;
+
+/**
+ * @brief CpuTopology 单元测试类，在临时目录中伪造sysfs目录树
+ */
+class CpuTopologyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::temp_directory_path() / ("cpu_topology_test_" + std::to_string(::getpid()));
+        fs::remove_all(root_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(root_);
+    }
+
+    void writeFile(const fs::path& path, const std::string& content) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << content << "\n";
+    }
+
+    /**
+     * @brief 写入一个CPU的缓存信息：L2私有，L3由shared共享
+     */
+    void writeCpu(int cpu, const std::string& l3Shared) {
+        fs::path cache = root_ / "cpu" / ("cpu" + std::to_string(cpu)) / "cache";
+        writeFile(cache / "index0" / "type", "Data");
+        writeFile(cache / "index0" / "level", "1");
+        writeFile(cache / "index0" / "shared_cpu_list", std::to_string(cpu));
+        writeFile(cache / "index2" / "type", "Unified");
+        writeFile(cache / "index2" / "level", "2");
+        writeFile(cache / "index2" / "shared_cpu_list", std::to_string(cpu));
+        writeFile(cache / "index3" / "type", "Unified");
+        writeFile(cache / "index3" / "level", "3");
+        writeFile(cache / "index3" / "shared_cpu_list", l3Shared);
+    }
+
+    fs::path root_;
+};
+
+/**
+ * @brief 测试cpulist解析
+ */
+TEST_F(CpuTopologyTest, ParseCpuList) {
+    EXPECT_EQ(CpuTopology::parseCpuList("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuTopology::parseCpuList("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(CpuTopology::parseCpuList("").empty());
+    EXPECT_TRUE(CpuTopology::parseCpuList("3-1").empty());
+    EXPECT_TRUE(CpuTopology::parseCpuList("a-b").empty());
+}
+
+/**
+ * @brief 测试从sysfs读取两节点、每节点两个L3缓存域的拓扑
+ */
+TEST_F(CpuTopologyTest, DetectNodesAndCacheDomains) {
+    writeFile(root_ / "cpu" / "online", "0-7");
+    writeFile(root_ / "node" / "node0" / "cpulist", "0-3");
+    writeFile(root_ / "node" / "node1" / "cpulist", "4-7");
+    writeFile(root_ / "node" / "possible", "0-1");
+    for (int cpu = 0; cpu < 8; ++cpu) {
+        int first = cpu / 2 * 2;
+        writeCpu(cpu, std::to_string(first) + "-" + std::to_string(first + 1));
+    }
+
+    CpuTopology topology = CpuTopology::detect(root_.string());
+    ASSERT_EQ(topology.getCpuCount(), 8u);
+    EXPECT_EQ(topology.getNodeCount(), 2u);
+    EXPECT_EQ(topology.getCacheDomainCount(), 4u);
+    EXPECT_EQ(topology.nodeOf(2), 0);
+    EXPECT_EQ(topology.nodeOf(5), 1);
+    EXPECT_EQ(topology.nodeOf(42), -1);
+    EXPECT_EQ(topology.getCpus()[3].cacheDomain, 2);
+}
+
+/**
+ * @brief 测试缺少sysfs信息时退化为单节点单缓存域
+ */
+TEST_F(CpuTopologyTest, FallbackWithoutSysfs) {
+    CpuTopology missing = CpuTopology::detect((root_ / "missing").string());
+    EXPECT_GE(missing.getCpuCount(), 1u);
+    EXPECT_EQ(missing.getNodeCount(), 1u);
+
+    writeFile(root_ / "cpu" / "online", "0-3");
+    CpuTopology noNodes = CpuTopology::detect(root_.string());
+    EXPECT_EQ(noNodes.getCpuCount(), 4u);
+    EXPECT_EQ(noNodes.getNodeCount(), 1u);
+    EXPECT_EQ(noNodes.nodeOf(3), 0);
+}
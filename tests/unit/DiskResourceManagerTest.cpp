@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
 #include "core/resource/DiskResourceManager.h"
+#include "core/resource/CgroupController.h"
 #include "core/tenant/TenantManager.h"
 
 using namespace yao;
+namespace fs = std::filesystem;
 
 /**
  * @brief DiskResourceManager 单元测试类
@@ -198,3 +203,50 @@ TEST_F(DiskResourceManagerTest, GradualApproachToQuota) {
     EXPECT_TRUE(diskManager.checkDiskQuota("disk_tenant1", 20.0));
     EXPECT_FALSE(diskManager.checkDiskQuota("disk_tenant1", 25.0));
 }
+
+/**
+ * @brief 测试块设备IO隔离：v2下有进程时才写入上限，io.stat经管理器暴露
+ */
+TEST(DiskIoCgroupTest, LimitsAndStats) {
+    fs::path root = fs::temp_directory_path() / ("disk_io_cgroup_test_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    auto controller = std::make_shared<CgroupController>((root / "yaobase").string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller->initialize());
+
+    auto& diskManager = DiskResourceManager::getInstance();
+    diskManager.initialize(100);
+    CgroupIoLimit limit;
+    limit.writeBps = 10LL << 20;
+    EXPECT_FALSE(diskManager.initializeCgroup(controller, "", limit));
+    ASSERT_TRUE(diskManager.initializeCgroup(controller, "8:0", limit));
+
+    // v2的io是域控制器：租户cgroup中没有进程时分配照常成功，但不写入无法生效的上限
+    auto tenant = std::make_shared<TenantContext>("disk_io_tenant", 2, 0, 10LL * 1024 * 1024 * 1024);
+    ASSERT_TRUE(diskManager.allocateDiskResource(tenant));
+    fs::path io = root / "yaobase-procs" / "disk_io_tenant";
+    EXPECT_FALSE(fs::exists(io / "io.max"));
+    EXPECT_FALSE(diskManager.setTenantIoLimit("disk_io_tenant", limit));
+    EXPECT_TRUE(diskManager.getTenantIoStats("disk_io_tenant").empty());
+
+    ASSERT_TRUE(controller->setMemoryLimit("disk_io_tenant", 0, 0));
+    ASSERT_TRUE(controller->attachProcess("disk_io_tenant", ::getpid()));
+    limit.readIops = 500;
+    ASSERT_TRUE(diskManager.setTenantIoLimit("disk_io_tenant", limit));
+    std::string line;
+    std::getline(std::ifstream(io / "io.max"), line);
+    EXPECT_EQ(line, "8:0 rbps=max wbps=10485760 riops=500 wiops=max");
+    EXPECT_FALSE(diskManager.setTenantIoLimit("unknown_tenant", limit));
+
+    std::ofstream(io / "io.stat") << "8:0 rbytes=4096 wbytes=8192 rios=1 wios=2 dbytes=0 dios=0\n";
+    auto stats = diskManager.getTenantIoStats("disk_io_tenant");
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].writeBytes, 8192u);
+    EXPECT_TRUE(diskManager.getTenantIoStats("unknown_tenant").empty());
+
+    diskManager.releaseDiskResource("disk_io_tenant");
+    std::getline(std::ifstream(io / "io.max"), line);
+    EXPECT_EQ(line, "8:0 rbps=max wbps=max riops=max wiops=max");
+    diskManager.initializeCgroup(nullptr, "", CgroupIoLimit());
+    controller->removeTenantCgroup("disk_io_tenant");
+    fs::remove_all(root);
+}
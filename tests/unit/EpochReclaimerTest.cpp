@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "core/resource/EpochReclaimer.h"
+
+using namespace yao;
+
+namespace {
+
+std::atomic<int> g_freed{0};
+
+struct Tracked {
+    ~Tracked() { g_freed.fetch_add(1); }
+};
+
+} // namespace
+
+/**
+ * @brief EpochReclaimer 单元测试类
+ */
+class EpochReclaimerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        EpochReclaimer::getInstance().synchronize();
+        g_freed = 0;
+    }
+};
+
+/**
+ * @brief 测试退休对象在宽限期后被释放
+ */
+TEST_F(EpochReclaimerTest, RetiredObjectsFreedAfterSynchronize) {
+    auto& reclaimer = EpochReclaimer::getInstance();
+    for (int i = 0; i < 10; ++i) {
+        EpochReclaimer::Guard guard;
+        reclaimer.retire(new Tracked());
+    }
+
+    reclaimer.synchronize();
+    EXPECT_EQ(g_freed.load(), 10);
+    EXPECT_EQ(reclaimer.getPendingCount(), 0u);
+}
+
+/**
+ * @brief 测试其他线程持有守卫时对象不会被释放
+ */
+TEST_F(EpochReclaimerTest, GuardBlocksReclamation) {
+    auto& reclaimer = EpochReclaimer::getInstance();
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]() {
+        EpochReclaimer::Guard guard;
+        entered = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!entered.load()) {
+        std::this_thread::yield();
+    }
+
+    uint64_t start = reclaimer.getEpoch();
+    reclaimer.retire(new Tracked());
+    for (int i = 0; i < 100; ++i) {
+        reclaimer.collect();
+    }
+    // 读线程停留在旧纪元，全局纪元最多前进一代，对象不能被释放
+    EXPECT_LE(reclaimer.getEpoch(), start + 1);
+    EXPECT_EQ(g_freed.load(), 0);
+
+    release = true;
+    reader.join();
+    reclaimer.synchronize();
+    EXPECT_EQ(g_freed.load(), 1);
+}
+
+/**
+ * @brief 测试嵌套守卫
+ */
+TEST_F(EpochReclaimerTest, NestedGuards) {
+    auto& reclaimer = EpochReclaimer::getInstance();
+    {
+        EpochReclaimer::Guard outer;
+        {
+            EpochReclaimer::Guard inner;
+            reclaimer.retire(new Tracked());
+        }
+        reclaimer.retire(new Tracked());
+    }
+    reclaimer.synchronize();
+    EXPECT_EQ(g_freed.load(), 2);
+}
+
+/**
+ * @brief 多线程并发退休压力测试，线程退出后遗留的对象也能被回收
+ */
+TEST_F(EpochReclaimerTest, ConcurrentRetireStress) {
+    auto& reclaimer = EpochReclaimer::getInstance();
+    const int threads = 8;
+    const int perThread = 10000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < perThread; ++i) {
+                EpochReclaimer::Guard guard;
+                reclaimer.retire(new Tracked());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    reclaimer.synchronize();
+    EXPECT_EQ(g_freed.load(), threads * perThread);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "core/resource/EventCount.h"
+
+using namespace yao;
+
+/**
+ * @brief 测试条件已满足时撤销等待不会阻塞
+ */
+TEST(EventCountTest, CancelWaitDoesNotBlock) {
+    EventCount ec;
+    EventCount::Key key = ec.prepareWait();
+    (void)key;
+    ec.cancelWait();
+    // 没有等待者时通知不应产生任何效果
+    ec.notify();
+    ec.notifyAll();
+}
+
+/**
+ * @brief 测试prepareWait之后到来的通知能让wait立即返回
+ */
+TEST(EventCountTest, NotifyAfterPrepareIsNotLost) {
+    EventCount ec;
+    EventCount::Key key = ec.prepareWait();
+    ec.notify();
+    ec.wait(key);  // 纪元已变化，不会阻塞
+    SUCCEED();
+}
+
+/**
+ * @brief 测试waitFor在没有通知时超时返回
+ */
+TEST(EventCountTest, WaitForTimesOut) {
+    EventCount ec;
+    auto start = std::chrono::steady_clock::now();
+    EventCount::Key key = ec.prepareWait();
+    EXPECT_FALSE(ec.waitFor(key, std::chrono::milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+/**
+ * @brief 测试生产者与多个休眠的消费者之间不丢失唤醒
+ */
+TEST(EventCountTest, NoLostWakeups) {
+    EventCount ec;
+    std::atomic<int> available{0};
+    std::atomic<int> consumed{0};
+    std::atomic<bool> done{false};
+    const int total = 20000;
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back([&]() {
+            while (true) {
+                int current = available.load();
+                if (current > 0) {
+                    if (available.compare_exchange_weak(current, current - 1)) {
+                        consumed.fetch_add(1);
+                    }
+                    continue;
+                }
+                if (done.load()) break;
+                EventCount::Key key = ec.prepareWait();
+                if (available.load() > 0 || done.load()) {
+                    ec.cancelWait();
+                    continue;
+                }
+                ec.wait(key);
+            }
+        });
+    }
+
+    for (int i = 0; i < total; ++i) {
+        available.fetch_add(1);
+        ec.notify();
+    }
+    while (consumed.load() < total) {
+        std::this_thread::yield();
+    }
+    done = true;
+    ec.notifyAll();
+    for (auto& t : consumers) {
+        t.join();
+    }
+    EXPECT_EQ(consumed.load(), total);
+}
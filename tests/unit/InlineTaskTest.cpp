@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/resource/InlineTask.h"
+#include "core/resource/TaskMemoryPool.h"
+
+using namespace yao;
+
+/**
+ * @brief 测试小捕获内联存放并正确执行
+ */
+TEST(InlineTaskTest, SmallCaptureStoredInline) {
+    int counter = 0;
+    InlineTask task([&counter]() { ++counter; });
+    EXPECT_TRUE(task.isInline());
+    EXPECT_TRUE(task.isValid());
+    task.execute();
+    task.execute();
+    EXPECT_EQ(counter, 2);
+}
+
+/**
+ * @brief 测试超出内联容量的捕获放入内存池，析构时释放捕获对象
+ */
+TEST(InlineTaskTest, LargeCaptureOverflowsToPool) {
+    auto shared = std::make_shared<int>(0);
+    std::array<char, 200> payload{};
+    payload[0] = 7;
+    {
+        InlineTask task([shared, payload]() { *shared += payload[0]; });
+        EXPECT_FALSE(task.isInline());
+        EXPECT_EQ(shared.use_count(), 2);
+        task.execute();
+    }
+    EXPECT_EQ(*shared, 7);
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+/**
+ * @brief 测试只可移动的捕获与优先级设置
+ */
+TEST(InlineTaskTest, MoveOnlyCaptureAndPriority) {
+    auto value = std::make_unique<int>(41);
+    int result = 0;
+    auto task = makeInlineTask([v = std::move(value), &result]() { result = *v + 1; }, TaskPriority::High);
+    EXPECT_EQ(task->getPriority(), TaskPriority::High);
+    task->execute();
+    EXPECT_EQ(result, 42);
+}
+
+/**
+ * @brief 测试内存池回收块并在本线程复用
+ */
+TEST(InlineTaskTest, PoolReusesBlocks) {
+    auto& pool = TaskMemoryPool::getInstance();
+    void* first = pool.allocate(100);
+    pool.deallocate(first, 100);
+    void* second = pool.allocate(120);  // 同属128字节级别
+    EXPECT_EQ(first, second);
+    pool.deallocate(second, 120);
+
+    void* large = pool.allocate(TaskMemoryPool::kMaxBlockSize + 1);
+    ASSERT_NE(large, nullptr);
+    pool.deallocate(large, TaskMemoryPool::kMaxBlockSize + 1);
+}
+
+/**
+ * @brief 测试在一个线程创建、另一个线程执行和释放
+ */
+TEST(InlineTaskTest, CrossThreadRelease) {
+    std::atomic<int> executed{0};
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 1000; ++i) {
+        tasks.push_back(makeInlineTask([&executed]() { executed.fetch_add(1); }));
+    }
+
+    std::thread consumer([&tasks]() {
+        for (auto& task : tasks) {
+            task->execute();
+            task.reset();
+        }
+    });
+    consumer.join();
+
+    EXPECT_EQ(executed.load(), 1000);
+    // 消费线程超出本地缓存上限的块已整批交还全局列表
+    EXPECT_GT(TaskMemoryPool::getInstance().getGlobalCachedBlocks(), 0u);
+}
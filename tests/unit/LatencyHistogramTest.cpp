@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "core/resource/LatencyHistogram.h"
+
+using namespace yao;
+
+/**
+ * @brief 测试桶编号随数值单调递增，且数值不超过所在桶的上界
+ */
+TEST(LatencyHistogramTest, BucketsAreMonotonic) {
+    size_t previous = 0;
+    for (uint64_t value = 0; value < (uint64_t(1) << 20); value += 7) {
+        size_t index = LatencyHistogram::indexOf(value);
+        EXPECT_GE(index, previous);
+        EXPECT_LT(index, LatencyHistogram::kBucketCount);
+        EXPECT_LE(value, LatencyHistogram::upperBoundOf(index));
+        previous = index;
+    }
+    EXPECT_EQ(LatencyHistogram::indexOf(uint64_t(1) << 62), LatencyHistogram::kBucketCount - 1);
+}
+
+/**
+ * @brief 测试桶上界与真实值的相对误差不超过1/kSubBuckets
+ */
+TEST(LatencyHistogramTest, RelativeErrorIsBounded) {
+    for (uint64_t value : {1ull, 31ull, 32ull, 33ull, 1000ull, 123456ull, 9876543ull, 1000000000ull, 3000000000000ull}) {
+        uint64_t bound = LatencyHistogram::upperBoundOf(LatencyHistogram::indexOf(value));
+        EXPECT_GE(bound, value);
+        EXPECT_LE(static_cast<double>(bound - value) / value, 1.0 / LatencyHistogram::kSubBuckets) << value;
+    }
+}
+
+/**
+ * @brief 测试分位数与摘要
+ */
+TEST(LatencyHistogramTest, PercentilesFollowDistribution) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.summarize().count, 0u);
+    EXPECT_EQ(histogram.getPercentile(99.0).count(), 0);
+
+    // 1..1000微秒均匀分布
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    LatencySummary summary = histogram.summarize();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_NEAR(summary.p50.count(), 500000.0, 500000.0 * 0.04);
+    EXPECT_NEAR(summary.p99.count(), 990000.0, 990000.0 * 0.04);
+    EXPECT_NEAR(summary.p999.count(), 999000.0, 999000.0 * 0.04);
+    EXPECT_GE(summary.max.count(), 1000000);
+    EXPECT_EQ(summary.p99, histogram.getPercentile(99.0));
+
+    histogram.record(std::chrono::nanoseconds(-5));  // 负值按0记录
+    EXPECT_EQ(histogram.getCount(), 1001u);
+    histogram.reset();
+    EXPECT_EQ(histogram.getCount(), 0u);
+}
+
+/**
+ * @brief 测试多线程并发记录不丢失样本
+ */
+TEST(LatencyHistogramTest, ConcurrentRecording) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t]() {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                histogram.record(i * (t + 1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.getCount(), 40000u);
+}
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
 #include "core/resource/MemoryResourceManager.h"
+#include "core/resource/MemoryQuotaChecker.h"
+#include "core/resource/CgroupController.h"
 #include "core/tenant/TenantManager.h"
 
 using namespace yao;
+namespace fs = std::filesystem;
 
 /**
  * @brief MemoryResourceManager 单元测试类
@@ -177,3 +184,63 @@ TEST_F(MemoryResourceManagerTest, NonExistentTenant) {
     double usage = memManager.getTenantMemoryUsage("nonexistent_tenant");
     EXPECT_EQ(usage, 0.0);
 }
+
+/**
+ * @brief 测试内存cgroup：按租户内存配额写入上限，memory.events的计数反馈给配额检查
+ */
+TEST(MemoryCgroupTest, LimitsAndEventsFeedback) {
+    fs::path root = fs::temp_directory_path() / ("memory_cgroup_test_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    auto controller = std::make_shared<CgroupController>((root / "yaobase").string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller->initialize());
+
+    auto& memManager = MemoryResourceManager::getInstance();
+    auto& checker = MemoryQuotaChecker::getInstance();
+    memManager.initialize(8192);
+    memManager.initializeCgroup(controller, 80);
+
+    auto tenant = std::make_shared<TenantContext>("mem_cgroup_tenant", 2, 1000LL * 1024 * 1024, 0);
+    ASSERT_TRUE(memManager.allocateMemoryResource(tenant));
+    fs::path memory = root / "yaobase-procs" / "mem_cgroup_tenant";
+    std::string line;
+    std::getline(std::ifstream(memory / "memory.max"), line);
+    EXPECT_EQ(line, std::to_string(1000LL * 1024 * 1024));
+    std::getline(std::ifstream(memory / "memory.high"), line);
+    EXPECT_EQ(line, std::to_string(800LL * 1024 * 1024));
+
+    // cgroup中没有进程时上限不生效，保留按请求记账的用量
+    std::ofstream(memory / "memory.current") << 100LL * 1024 * 1024 << "\n";
+    std::ofstream(memory / "memory.events") << "low 0\nhigh 0\nmax 0\noom 0\noom_kill 0\n";
+    memManager.updateMemoryUsage("mem_cgroup_tenant", 50.0);
+    MemoryCgroupStats empty = memManager.refreshCgroupStats("mem_cgroup_tenant");
+    EXPECT_FALSE(empty.hasMembers);
+    EXPECT_EQ(empty.usageBytes, 0u);
+    EXPECT_DOUBLE_EQ(memManager.getTenantMemoryUsage("mem_cgroup_tenant"), 0.05);
+
+    // 加入租户进程后实际用量取自memory.current
+    ASSERT_TRUE(controller->attachProcess("mem_cgroup_tenant", ::getpid()));
+    std::this_thread::sleep_for(MemoryResourceManager::kCgroupSampleInterval);
+    EXPECT_TRUE(checker.checkQuota(tenant, 10.0));
+    EXPECT_DOUBLE_EQ(memManager.getTenantMemoryUsage("mem_cgroup_tenant"), 0.1);
+    EXPECT_TRUE(memManager.refreshCgroupStats("mem_cgroup_tenant").hasMembers);
+
+    // 采样间隔内发生OOM：拒绝；之后没有新事件：恢复
+    std::ofstream(memory / "memory.events") << "low 0\nhigh 0\nmax 3\noom 1\noom_kill 1\n";
+    std::this_thread::sleep_for(MemoryResourceManager::kCgroupSampleInterval);
+    EXPECT_FALSE(checker.checkQuota(tenant, 10.0));
+    EXPECT_EQ(memManager.refreshCgroupStats("mem_cgroup_tenant").oomEvents, 2u);
+    std::this_thread::sleep_for(MemoryResourceManager::kCgroupSampleInterval);
+    EXPECT_TRUE(checker.checkQuota(tenant, 10.0));
+
+    // 触及memory.high视为达到硬限制
+    std::ofstream(memory / "memory.events") << "low 0\nhigh 4\nmax 3\noom 1\noom_kill 1\n";
+    std::this_thread::sleep_for(MemoryResourceManager::kCgroupSampleInterval);
+    EXPECT_FALSE(checker.checkQuota(tenant, 10.0));
+
+    memManager.releaseMemoryResource("mem_cgroup_tenant");
+    std::getline(std::ifstream(memory / "memory.max"), line);
+    EXPECT_EQ(line, "max");
+    memManager.initializeCgroup(nullptr);
+    controller->removeTenantCgroup("mem_cgroup_tenant");
+    fs::remove_all(root);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "core/resource/PressureMonitor.h"
+#include "core/resource/CgroupController.h"
+
+using namespace yao;
+namespace fs = std::filesystem;
+
+/**
+ * @brief PressureMonitor 单元测试类，在临时目录中伪造/proc/pressure
+ */
+class PressureMonitorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::temp_directory_path() / ("pressure_monitor_test_" + std::to_string(::getpid()));
+        fs::remove_all(root_);
+        fs::create_directories(root_ / "pressure");
+        for (const char* resource : {"cpu", "memory", "io"}) {
+            writePressure(root_ / "pressure" / resource, 0.0, 0);
+        }
+    }
+
+    void TearDown() override {
+        // 恢复为不可用状态，避免影响其他测试
+        PressureMonitor::getInstance().initialize((root_ / "missing").string());
+        fs::remove_all(root_);
+    }
+
+    void writePressure(const fs::path& path, double someAvg10, uint64_t someTotal) {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << "some avg10=" << someAvg10 << " avg60=0.00 avg300=0.00 total=" << someTotal << "\n"
+                            << "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n";
+    }
+
+    fs::path root_;
+};
+
+/**
+ * @brief 测试解析PSI文件的some/full行
+ */
+TEST_F(PressureMonitorTest, ParsePressureFile) {
+    std::string content = "some avg10=12.50 avg60=3.00 avg300=1.00 total=1061158563\n"
+                          "full avg10=0.75 avg60=0.00 avg300=0.00 total=4200\n";
+    PressureSample sample;
+    ASSERT_TRUE(PressureMonitor::parsePressure(content.data(), content.data() + content.size(), sample));
+    EXPECT_DOUBLE_EQ(sample.someAvg10, 12.5);
+    EXPECT_DOUBLE_EQ(sample.fullAvg10, 0.75);
+    EXPECT_EQ(sample.someTotalUs, 1061158563u);
+    EXPECT_EQ(sample.fullTotalUs, 4200u);
+
+    std::string broken = "garbage\n";
+    PressureSample empty;
+    EXPECT_FALSE(PressureMonitor::parsePressure(broken.data(), broken.data() + broken.size(), empty));
+}
+
+/**
+ * @brief 测试PSI不可用时不拒绝任何租户，也不启动采样线程
+ */
+TEST_F(PressureMonitorTest, UnavailableDegradesGracefully) {
+    auto& monitor = PressureMonitor::getInstance();
+    EXPECT_FALSE(monitor.initialize((root_ / "missing").string()));
+    EXPECT_FALSE(monitor.isAvailable());
+    EXPECT_FALSE(monitor.startMonitoring(10));
+    monitor.sample();
+    EXPECT_FALSE(monitor.shouldShed("tenant_a", 1.0));
+}
+
+/**
+ * @brief 测试主机停顿时只拒绝超过软限制的租户，停顿消失后恢复
+ */
+TEST_F(PressureMonitorTest, ShedsOverSoftLimitTenantsUnderStall) {
+    auto& monitor = PressureMonitor::getInstance();
+    ASSERT_TRUE(monitor.initialize((root_ / "pressure").string()));
+    monitor.configure(0.2, 0.7);
+
+    // 首次采样使用avg10
+    writePressure(root_ / "pressure" / "io", 50.0, 1000000);
+    monitor.sample();
+    EXPECT_DOUBLE_EQ(monitor.getSystemPressure().io, 0.5);
+    EXPECT_TRUE(monitor.shouldShed("tenant_a", 0.8));
+    EXPECT_FALSE(monitor.shouldShed("tenant_a", 0.5));
+
+    // 之后按两次采样之间累计停顿时间的增量计算
+    monitor.sample();
+    EXPECT_DOUBLE_EQ(monitor.getSystemPressure().io, 0.0);
+    EXPECT_FALSE(monitor.shouldShed("tenant_a", 0.8));
+}
+
+/**
+ * @brief 测试读取租户cgroup的PSI：只拒绝自身停顿的租户
+ */
+TEST_F(PressureMonitorTest, TenantCgroupPressure) {
+    auto controller = std::make_shared<CgroupController>((root_ / "cgroup" / "yaobase").string(), CgroupVersion::V2);
+    ASSERT_TRUE(controller->initialize());
+    ASSERT_TRUE(controller->createTenantCgroup("tenant_a"));
+    ASSERT_TRUE(controller->setMemoryLimit("tenant_a", 0, 0));
+    writePressure(root_ / "cgroup" / "yaobase" / "tenant_a" / "cpu.pressure", 10.0, 0);
+    writePressure(root_ / "cgroup" / "yaobase-procs" / "tenant_a" / "memory.pressure", 90.0, 0);
+
+    auto& monitor = PressureMonitor::getInstance();
+    ASSERT_TRUE(monitor.initialize((root_ / "pressure").string(), controller));
+    monitor.configure(0.2, 0.7);
+    monitor.registerTenant("tenant_a");
+    monitor.registerTenant("tenant_b");
+    monitor.sample();
+
+    PressureLevel level = monitor.getTenantPressure("tenant_a");
+    EXPECT_DOUBLE_EQ(level.cpu, 0.1);
+    EXPECT_DOUBLE_EQ(level.memory, 0.9);
+    EXPECT_DOUBLE_EQ(level.io, 0.0);
+    EXPECT_TRUE(monitor.shouldShed("tenant_a", 0.75));
+    EXPECT_FALSE(monitor.shouldShed("tenant_b", 0.75));
+
+    monitor.unregisterTenant("tenant_a");
+    monitor.unregisterTenant("tenant_b");
+    EXPECT_FALSE(monitor.shouldShed("tenant_a", 0.75));
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+#include "core/resource/PriorityTaskQueue.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief 测试用任务，记录自身优先级
+ */
+class LaneTask : public Task {
+public:
+    explicit LaneTask(TaskPriority priority) { setPriority(priority); }
+
+    void execute() override {}
+    bool isValid() const override { return true; }
+};
+
+std::unique_ptr<Task> makeTask(TaskPriority priority) {
+    return std::make_unique<LaneTask>(priority);
+}
+
+} // namespace
+
+/**
+ * @brief 测试任务按优先级进入对应通道
+ */
+TEST(PriorityTaskQueueTest, RouteByPriority) {
+    PriorityTaskQueue queue(TaskQueueEngine::RingBuffer, 64, LanePolicy::Strict);
+    EXPECT_TRUE(queue.enqueue(makeTask(TaskPriority::High)));
+    EXPECT_TRUE(queue.enqueue(makeTask(TaskPriority::Low)));
+    EXPECT_TRUE(queue.enqueue(makeTask(TaskPriority::Low)));
+    EXPECT_FALSE(queue.enqueue(nullptr));
+
+    EXPECT_EQ(queue.laneSize(TaskPriority::High), 1u);
+    EXPECT_EQ(queue.laneSize(TaskPriority::Normal), 0u);
+    EXPECT_EQ(queue.laneSize(TaskPriority::Low), 2u);
+    EXPECT_EQ(queue.size(), 3u);
+}
+
+/**
+ * @brief 测试严格策略总是先取高优先级任务
+ */
+TEST(PriorityTaskQueueTest, StrictPolicyDrainsHighFirst) {
+    PriorityTaskQueue queue(TaskQueueEngine::Linked, 64, LanePolicy::Strict);
+    for (int i = 0; i < 3; ++i) {
+        queue.enqueue(makeTask(TaskPriority::Low));
+        queue.enqueue(makeTask(TaskPriority::Normal));
+        queue.enqueue(makeTask(TaskPriority::High));
+    }
+
+    std::vector<TaskPriority> order;
+    while (auto task = queue.dequeue()) {
+        order.push_back(task->getPriority());
+    }
+    std::vector<TaskPriority> expected = {
+        TaskPriority::High, TaskPriority::High, TaskPriority::High,
+        TaskPriority::Normal, TaskPriority::Normal, TaskPriority::Normal,
+        TaskPriority::Low, TaskPriority::Low, TaskPriority::Low};
+    EXPECT_EQ(order, expected);
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * @brief 测试加权策略按权重比例出队且低优先级不饿死
+ */
+TEST(PriorityTaskQueueTest, WeightedPolicyFollowsWeights) {
+    PriorityTaskQueue queue(TaskQueueEngine::RingBuffer, 1024, LanePolicy::Weighted,
+                            PriorityTaskQueue::LaneWeights{4, 2, 1});
+    for (int i = 0; i < 200; ++i) {
+        queue.enqueue(makeTask(TaskPriority::High));
+        queue.enqueue(makeTask(TaskPriority::Normal));
+        queue.enqueue(makeTask(TaskPriority::Low));
+    }
+
+    // 三个通道都有积压时，每7次出队为4:2:1
+    std::array<int, kTaskPriorityCount> counts{};
+    for (int i = 0; i < 70; ++i) {
+        auto task = queue.dequeue();
+        ASSERT_TRUE(task);
+        ++counts[static_cast<size_t>(task->getPriority())];
+    }
+    EXPECT_EQ(counts[0], 40);
+    EXPECT_EQ(counts[1], 20);
+    EXPECT_EQ(counts[2], 10);
+}
+
+/**
+ * @brief 测试批量入队分流与批量出队跨通道补齐
+ */
+TEST(PriorityTaskQueueTest, BulkOperationsAcrossLanes) {
+    PriorityTaskQueue queue(TaskQueueEngine::RingBuffer, 4, LanePolicy::Strict);
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 6; ++i) {
+        tasks.push_back(makeTask(TaskPriority::Low));
+    }
+    tasks.push_back(makeTask(TaskPriority::High));
+
+    // Low通道容量为4，多出的2个任务留在tasks中
+    EXPECT_EQ(queue.enqueueBulk(tasks), 5u);
+    ASSERT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(tasks[0]->getPriority(), TaskPriority::Low);
+
+    std::vector<std::unique_ptr<Task>> out;
+    EXPECT_EQ(queue.dequeueBulk(out, 3), 3u);
+    EXPECT_EQ(out[0]->getPriority(), TaskPriority::High);
+    EXPECT_EQ(out[1]->getPriority(), TaskPriority::Low);
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+/**
+ * @brief 测试策略名称解析
+ */
+TEST(PriorityTaskQueueTest, ParsePolicyName) {
+    EXPECT_EQ(parseLanePolicy("strict"), LanePolicy::Strict);
+    EXPECT_EQ(parseLanePolicy("weighted"), LanePolicy::Weighted);
+    EXPECT_EQ(parseLanePolicy("unknown", LanePolicy::Strict), LanePolicy::Strict);
+}
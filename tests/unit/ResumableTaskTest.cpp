@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/resource/ResumableTask.h"
+#include "core/resource/TenantThreadGroup.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 测试用任务：挂起指定次数，把恢复句柄交给外部
+ */
+class SuspendingTask : public ResumableTask {
+public:
+    SuspendingTask(int suspensions, std::mutex& mutex, std::vector<Resumer>& pending)
+        : suspensions_(suspensions), mutex_(mutex), pending_(pending) {}
+
+    std::vector<std::thread::id> threads;
+    std::atomic<bool> abandoned{false};
+
+protected:
+    Step step() override {
+        threads.push_back(std::this_thread::get_id());
+        if (suspensions_-- == 0) {
+            return Step::Done;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(makeResumer());
+        return Step::Suspend;
+    }
+
+    void onAbandoned() override { abandoned = true; }
+
+private:
+    int suspensions_;
+    std::mutex& mutex_;
+    std::vector<Resumer>& pending_;
+};
+
+/**
+ * @brief 测试用任务：在step()返回前同步恢复
+ */
+class InlineResumeTask : public ResumableTask {
+public:
+    std::atomic<int> steps{0};
+    std::atomic<bool> duplicateAccepted{false};
+
+protected:
+    Step step() override {
+        if (steps.fetch_add(1) == 0) {
+            Resumer resumer = makeResumer();
+            resumer.resume();
+            duplicateAccepted = resumer.resume();
+            return Step::Suspend;
+        }
+        return Step::Done;
+    }
+};
+
+/**
+ * @brief 取出当前挂起的恢复句柄
+ */
+std::vector<ResumableTask::Resumer> takePending(std::mutex& mutex, std::vector<ResumableTask::Resumer>& pending) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<ResumableTask::Resumer> taken;
+    taken.swap(pending);
+    return taken;
+}
+
+} // namespace
+
+/**
+ * @brief 测试挂起的任务由外部线程恢复，各段都在租户线程组上执行
+ */
+TEST(ResumableTaskTest, SegmentsRunOnTenantGroup) {
+    TenantThreadGroup group("resumable_tenant", 1);
+    ASSERT_TRUE(group.start());
+
+    std::mutex mutex;
+    std::vector<ResumableTask::Resumer> pending;
+    auto task = std::make_shared<SuspendingTask>(3, mutex, pending);
+    ASSERT_TRUE(task->start([&group](std::unique_ptr<Task> segment) {
+        return group.submitTask(std::move(segment)).isAccepted();
+    }));
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(waitUntil([&]() { std::lock_guard<std::mutex> lock(mutex); return pending.size() == 1; }));
+        EXPECT_FALSE(task->isDone());
+        std::thread io([&]() {
+            for (auto& resumer : takePending(mutex, pending)) {
+                EXPECT_TRUE(resumer.resume());
+            }
+        });
+        io.join();
+    }
+
+    ASSERT_TRUE(waitUntil([&]() { return task->isDone(); }));
+    EXPECT_EQ(task->getSegmentCount(), 4u);
+    EXPECT_FALSE(task->abandoned.load());
+    ASSERT_EQ(task->threads.size(), 4u);
+    for (const auto& id : task->threads) {
+        EXPECT_NE(id, std::this_thread::get_id());
+    }
+    group.stop();
+}
+
+/**
+ * @brief 测试单个工作线程可以同时推进多个挂起中的任务
+ */
+TEST(ResumableTaskTest, ManyTasksInFlightOnOneWorker) {
+    TenantThreadGroup group("resumable_tenant", 1);
+    ASSERT_TRUE(group.start());
+
+    std::mutex mutex;
+    std::vector<ResumableTask::Resumer> pending;
+    std::vector<std::shared_ptr<SuspendingTask>> tasks;
+    for (int i = 0; i < 50; ++i) {
+        tasks.push_back(std::make_shared<SuspendingTask>(1, mutex, pending));
+        ASSERT_TRUE(tasks.back()->start([&group](std::unique_ptr<Task> segment) {
+            return group.submitTask(std::move(segment)).isAccepted();
+        }));
+    }
+
+    // 全部任务都在等待I/O，唯一的工作线程并未被占住
+    ASSERT_TRUE(waitUntil([&]() { std::lock_guard<std::mutex> lock(mutex); return pending.size() == 50; }));
+    for (auto& resumer : takePending(mutex, pending)) {
+        EXPECT_TRUE(resumer.resume());
+    }
+    for (auto& task : tasks) {
+        EXPECT_TRUE(waitUntil([&]() { return task->isDone(); }));
+        EXPECT_EQ(task->getSegmentCount(), 2u);
+    }
+    group.stop();
+}
+
+/**
+ * @brief 测试step()返回前同步恢复时直接继续执行，不重新提交
+ */
+TEST(ResumableTaskTest, ResumeBeforeSuspendContinuesInline) {
+    std::vector<std::unique_ptr<Task>> submitted;
+    auto task = std::make_shared<InlineResumeTask>();
+    ASSERT_TRUE(task->start([&submitted](std::unique_ptr<Task> segment) {
+        submitted.push_back(std::move(segment));
+        return true;
+    }));
+    ASSERT_EQ(submitted.size(), 1u);
+
+    submitted[0]->execute();
+    EXPECT_TRUE(task->isDone());
+    EXPECT_EQ(task->steps.load(), 2);
+    EXPECT_EQ(task->getSegmentCount(), 2u);
+    EXPECT_FALSE(task->duplicateAccepted.load());
+    EXPECT_EQ(submitted.size(), 1u);
+}
+
+/**
+ * @brief 测试挂起期间被取消的任务在恢复段出队时放弃
+ */
+TEST(ResumableTaskTest, CancelledWhileSuspendedIsAbandoned) {
+    TenantThreadGroup group("resumable_tenant", 1);
+    ASSERT_TRUE(group.start());
+
+    std::mutex mutex;
+    std::vector<ResumableTask::Resumer> pending;
+    auto task = std::make_shared<SuspendingTask>(1, mutex, pending);
+    CancellationToken token = CancellationToken::create();
+    task->setCancellationToken(token);
+    ASSERT_TRUE(task->start([&group](std::unique_ptr<Task> segment) {
+        return group.submitTask(std::move(segment)).isAccepted();
+    }));
+    ASSERT_TRUE(waitUntil([&]() { std::lock_guard<std::mutex> lock(mutex); return pending.size() == 1; }));
+
+    token.cancel();
+    for (auto& resumer : takePending(mutex, pending)) {
+        resumer.resume();
+    }
+    ASSERT_TRUE(waitUntil([&]() { return task->abandoned.load(); }));
+    EXPECT_TRUE(task->isDone());
+    EXPECT_EQ(task->getSegmentCount(), 1u);
+    EXPECT_TRUE(waitUntil([&]() { return group.getCancelledTasks() == 1; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试无法提交时放弃任务
+ */
+TEST(ResumableTaskTest, RejectedSubmitAbandons) {
+    std::mutex mutex;
+    std::vector<ResumableTask::Resumer> pending;
+    auto task = std::make_shared<SuspendingTask>(0, mutex, pending);
+    EXPECT_FALSE(task->start([](std::unique_ptr<Task>) { return false; }));
+    EXPECT_TRUE(task->isDone());
+    EXPECT_TRUE(task->abandoned.load());
+}
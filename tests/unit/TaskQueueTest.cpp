@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "core/resource/LockFreeQueue.h"
+#include "core/resource/RingBufferQueue.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+int taskId(const std::unique_ptr<Task>& task) {
+    return static_cast<CountingTask*>(task.get())->getId();
+}
+
+} // namespace
+
+/**
+ * @brief 两种队列引擎的公共行为测试
+ */
+class TaskQueueTest : public ::testing::TestWithParam<TaskQueueEngine> {
+protected:
+    std::unique_ptr<TaskQueue> makeQueue(size_t capacity = 1024) {
+        return createTaskQueue(GetParam(), capacity);
+    }
+};
+
+/**
+ * @brief 测试先进先出顺序
+ */
+TEST_P(TaskQueueTest, FifoOrder) {
+    auto queue = makeQueue();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue->enqueue(std::make_unique<CountingTask>(i, nullptr)));
+    }
+    EXPECT_EQ(queue->size(), 10u);
+
+    for (int i = 0; i < 10; ++i) {
+        auto task = queue->dequeue();
+        ASSERT_NE(task, nullptr);
+        EXPECT_EQ(taskId(task), i);
+    }
+    EXPECT_TRUE(queue->empty());
+    EXPECT_EQ(queue->dequeue(), nullptr);
+}
+
+/**
+ * @brief 测试空任务被拒绝
+ */
+TEST_P(TaskQueueTest, RejectNullTask) {
+    auto queue = makeQueue();
+    EXPECT_FALSE(queue->enqueue(nullptr));
+    EXPECT_TRUE(queue->empty());
+}
+
+/**
+ * @brief 测试多生产者单消费者场景下任务不丢失
+ */
+TEST_P(TaskQueueTest, MultiProducerNoLoss) {
+    auto queue = makeQueue(1 << 16);
+    const int producers = 4;
+    const int perProducer = 5000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < perProducer; ++i) {
+                while (!queue->enqueue(std::make_unique<CountingTask>(p * perProducer + i, nullptr))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(queue->size(), static_cast<size_t>(producers * perProducer));
+    int dequeued = 0;
+    while (queue->dequeue()) {
+        ++dequeued;
+    }
+    EXPECT_EQ(dequeued, producers * perProducer);
+}
+
+/**
+ * @brief 多生产者多消费者压力测试
+ * 多个消费者共享一个队列时，链表队列的旧节点必须经纪元回收才能安全释放
+ */
+TEST_P(TaskQueueTest, ConcurrentProducersConsumers) {
+    auto queue = makeQueue(256);
+    const int producers = 4;
+    const int consumers = 8;
+    const int perProducer = 20000;
+    std::atomic<int> executed{0};
+    std::atomic<int> producersDone{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < perProducer; ++i) {
+                auto task = std::make_unique<CountingTask>(i, &executed);
+                while (!queue->enqueue(std::move(task))) {
+                    task = std::make_unique<CountingTask>(i, &executed);
+                    std::this_thread::yield();
+                }
+            }
+            producersDone.fetch_add(1);
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            while (producersDone.load() < producers || !queue->empty()) {
+                auto task = queue->dequeue();
+                if (task) {
+                    task->execute();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(executed.load(), producers * perProducer);
+    EXPECT_TRUE(queue->empty());
+}
+
+/**
+ * @brief 测试批量入队出队保持顺序
+ */
+TEST_P(TaskQueueTest, BulkEnqueueDequeue) {
+    auto queue = makeQueue();
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 10; ++i) {
+        tasks.push_back(std::make_unique<CountingTask>(i, nullptr));
+    }
+    tasks.push_back(nullptr);
+
+    EXPECT_EQ(queue->enqueueBulk(tasks), 10u);
+    EXPECT_TRUE(tasks.empty());
+    EXPECT_EQ(queue->size(), 10u);
+
+    std::vector<std::unique_ptr<Task>> out;
+    EXPECT_EQ(queue->dequeueBulk(out, 4), 4u);
+    EXPECT_EQ(queue->dequeueBulk(out, 100), 6u);
+    EXPECT_EQ(queue->dequeueBulk(out, 4), 0u);
+    ASSERT_EQ(out.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(taskId(out[i]), i);
+    }
+    EXPECT_TRUE(queue->empty());
+}
+
+/**
+ * @brief 批量操作与单个操作混合的并发测试
+ */
+TEST_P(TaskQueueTest, ConcurrentBulkOperations) {
+    auto queue = makeQueue(1024);
+    const int producers = 4;
+    const int consumers = 4;
+    const int batches = 500;
+    const int batchSize = 16;
+    std::atomic<int> executed{0};
+    std::atomic<int> producersDone{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for (int b = 0; b < batches; ++b) {
+                std::vector<std::unique_ptr<Task>> tasks;
+                for (int i = 0; i < batchSize; ++i) {
+                    tasks.push_back(std::make_unique<CountingTask>(i, &executed));
+                }
+                while (!tasks.empty()) {
+                    if (queue->enqueueBulk(tasks) == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            producersDone.fetch_add(1);
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            std::vector<std::unique_ptr<Task>> out;
+            while (producersDone.load() < producers || !queue->empty()) {
+                out.clear();
+                if (c % 2 == 0) {
+                    queue->dequeueBulk(out, 8);
+                } else if (auto task = queue->dequeue()) {
+                    out.push_back(std::move(task));
+                }
+                if (out.empty()) {
+                    std::this_thread::yield();
+                }
+                for (auto& task : out) {
+                    task->execute();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(executed.load(), producers * batches * batchSize);
+    EXPECT_TRUE(queue->empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, TaskQueueTest,
+                         ::testing::Values(TaskQueueEngine::Linked, TaskQueueEngine::RingBuffer));
+
+/**
+ * @brief 测试环形队列容量取整与满队列拒绝
+ */
+TEST(RingBufferQueueTest, BoundedCapacity) {
+    RingBufferQueue queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.enqueue(std::make_unique<CountingTask>(i, nullptr)));
+    }
+    EXPECT_FALSE(queue.enqueue(std::make_unique<CountingTask>(8, nullptr)));
+    EXPECT_EQ(queue.size(), 8u);
+
+    // 出队后槽位可复用
+    ASSERT_NE(queue.dequeue(), nullptr);
+    EXPECT_TRUE(queue.enqueue(std::make_unique<CountingTask>(9, nullptr)));
+}
+
+/**
+ * @brief 测试环形队列空间不足时批量入队只接收部分任务
+ */
+TEST(RingBufferQueueTest, PartialBulkEnqueue) {
+    RingBufferQueue queue(8);
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 12; ++i) {
+        tasks.push_back(std::make_unique<CountingTask>(i, nullptr));
+    }
+
+    EXPECT_EQ(queue.enqueueBulk(tasks), 8u);
+    ASSERT_EQ(tasks.size(), 4u);
+    EXPECT_EQ(taskId(tasks.front()), 8);
+    EXPECT_EQ(queue.enqueueBulk(tasks), 0u);
+    EXPECT_EQ(tasks.size(), 4u);
+}
+
+/**
+ * @brief 测试队列引擎名称解析
+ */
+TEST(RingBufferQueueTest, ParseEngineName) {
+    EXPECT_EQ(parseTaskQueueEngine("ring"), TaskQueueEngine::RingBuffer);
+    EXPECT_EQ(parseTaskQueueEngine("linked"), TaskQueueEngine::Linked);
+    EXPECT_EQ(parseTaskQueueEngine("unknown", TaskQueueEngine::RingBuffer), TaskQueueEngine::RingBuffer);
+}
@@ -112,7 +112,7 @@ TEST_F(TenantManagerTest, UpdateTenantQuota) {
                         1024 * 1024 * 1024, 
                         10LL * 1024 * 1024 * 1024);
     
-    bool result = manager.updateTenantQuota("test_tenant1", 4, 
+    ResizeHandle result = manager.updateTenantQuota("test_tenant1", 4, 
                                            2LL * 1024 * 1024 * 1024, 
                                            20LL * 1024 * 1024 * 1024);
     EXPECT_TRUE(result);
@@ -130,7 +130,7 @@ TEST_F(TenantManagerTest, UpdateTenantQuota) {
 TEST_F(TenantManagerTest, UpdateNonExistentTenantQuota) {
     auto& manager = TenantManager::getInstance();
     
-    bool result = manager.updateTenantQuota("nonexistent_tenant", 4, 
+    ResizeHandle result = manager.updateTenantQuota("nonexistent_tenant", 4, 
                                            2LL * 1024 * 1024 * 1024, 
                                            20LL * 1024 * 1024 * 1024);
     EXPECT_FALSE(result);
@@ -0,0 +1,499 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/resource/TenantThreadGroup.h"
+#include "common/TestTasks.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace yao;
+using namespace yao::test;
+
+/**
+ * @brief TenantThreadGroup 单元测试类，分别在两种队列引擎上运行
+ */
+class TenantThreadGroupTest : public ::testing::TestWithParam<TaskQueueEngine> {
+protected:
+    ThreadGroupOptions makeOptions() const {
+        ThreadGroupOptions options;
+        options.queueEngine = GetParam();
+        options.queueCapacity = 4096;
+        return options;
+    }
+};
+
+/**
+ * @brief 测试单个提交的任务都被执行
+ */
+TEST_P(TenantThreadGroupTest, ExecuteSubmittedTasks) {
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+    }
+
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 200; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试批量提交的任务都被执行
+ */
+TEST_P(TenantThreadGroupTest, ExecuteBulkSubmittedTasks) {
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 500; ++i) {
+        tasks.push_back(std::make_unique<CountingTask>(executed));
+    }
+    EXPECT_EQ(group.submitTasks(tasks), 500u);
+    EXPECT_TRUE(tasks.empty());
+
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 500; }));
+    EXPECT_EQ(group.getQueueSize(), 0u);
+    group.stop();
+}
+
+/**
+ * @brief 测试调整线程数
+ */
+TEST_P(TenantThreadGroupTest, ResizeThreads) {
+    TenantThreadGroup group("group_test_tenant", 2, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+    EXPECT_EQ(group.getTotalThreads(), 2u);
+
+    EXPECT_TRUE(group.resize(4));
+    EXPECT_EQ(group.getTotalThreads(), 4u);
+
+    EXPECT_TRUE(group.resize(1));
+    EXPECT_EQ(group.getTotalThreads(), 1u);
+
+    std::atomic<int> executed{0};
+    EXPECT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试空闲休眠的工作线程在提交任务后被唤醒
+ */
+TEST_P(TenantThreadGroupTest, WakeParkedWorkers) {
+    ThreadGroupOptions options = makeOptions();
+    options.idleSpin = std::chrono::microseconds(0);
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    // 等待所有工作线程进入休眠
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(group.getBusyThreads(), 0u);
+
+    std::atomic<int> executed{0};
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+        EXPECT_TRUE(waitUntil([&]() { return executed.load() == round + 1; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    group.stop();
+}
+
+/**
+ * @brief 测试开启严格优先级通道后，高优先级任务越过低优先级积压先执行
+ */
+TEST_P(TenantThreadGroupTest, HighPriorityOvertakesBacklog) {
+    ThreadGroupOptions options = makeOptions();
+    options.priorityLanes = true;
+    options.lanePolicy = LanePolicy::Strict;
+    options.dequeueBatchSize = 1;
+    TenantThreadGroup group("group_test_tenant", 1, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    // 先用一个阻塞任务占住唯一的工作线程
+    std::atomic<bool> release{false};
+    std::atomic<bool> blocked{false};
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(id);
+    };
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        blocked = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    })));
+    ASSERT_TRUE(waitUntil([&]() { return blocked.load(); }));
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&, i]() { record(i); }), TaskPriority::Low));
+    }
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() { record(100); }), TaskPriority::High));
+    release = true;
+
+    ASSERT_TRUE(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        return order.size() == 6;
+    }));
+    EXPECT_EQ(order.front(), 100);
+    group.stop();
+}
+
+/**
+ * @brief 测试缩容不等待正在执行的任务，句柄在被移除的线程退出后完成
+ */
+TEST_P(TenantThreadGroupTest, ShrinkDoesNotBlockOnRunningTask) {
+    ThreadGroupOptions options = makeOptions();
+    options.dequeueBatchSize = 1;
+    TenantThreadGroup group("group_test_tenant", 2, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    // 占住两个线程，被移除的线程一定正在执行任务
+    std::atomic<bool> release{false};
+    std::atomic<int> blocked{0};
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+            blocked.fetch_add(1);
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        })));
+    }
+    ASSERT_TRUE(waitUntil([&]() { return blocked.load() == 2; }));
+
+    auto start = std::chrono::steady_clock::now();
+    ResizeHandle handle = group.resize(1);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(group.getTotalThreads(), 1u);
+    EXPECT_FALSE(handle.isDone());
+    EXPECT_FALSE(handle.waitFor(std::chrono::milliseconds(20)));
+
+    release = true;
+    EXPECT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+    EXPECT_TRUE(handle.isDone());
+
+    // 剩余线程继续工作
+    std::atomic<int> executed{0};
+    ASSERT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试反复缩容时线程组累计的CPU时间不回落
+ */
+TEST_P(TenantThreadGroupTest, CpuTimeMonotonicAcrossShrink) {
+#ifndef __linux__
+    GTEST_SKIP() << "线程CPU时钟仅在Linux上可用";
+#endif
+    ThreadGroupOptions options = makeOptions();
+    options.dequeueBatchSize = 1;
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    // 持续提交耗CPU的任务，被移除的线程退出前都已消耗CPU时间
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        while (!done.load()) {
+            group.submitTask(std::make_unique<FunctionTask>([]() {
+                auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+                while (std::chrono::steady_clock::now() < until) {
+                }
+            }));
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+
+    std::atomic<bool> decreased{false};
+    std::thread sampler([&]() {
+        uint64_t last = 0;
+        while (!done.load()) {
+            uint64_t now = group.getCpuTimeNs();
+            if (now < last) {
+                decreased = true;
+            }
+            last = now;
+            std::this_thread::yield();
+        }
+    });
+
+    for (int round = 0; round < 10; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ResizeHandle handle = group.resize(1);
+        EXPECT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        group.resize(4);
+    }
+    done = true;
+    producer.join();
+    sampler.join();
+    EXPECT_FALSE(decreased.load());
+
+    uint64_t beforeStop = group.getCpuTimeNs();
+    EXPECT_GT(beforeStop, 0u);
+    group.stop();
+    EXPECT_GE(group.getCpuTimeNs(), beforeStop);
+}
+
+/**
+ * @brief 测试排队期间过期或被取消的任务在出队时丢弃并分别计数
+ */
+TEST_P(TenantThreadGroupTest, DropExpiredAndCancelledTasks) {
+    ThreadGroupOptions options = makeOptions();
+    options.dequeueBatchSize = 1;
+    TenantThreadGroup group("group_test_tenant", 1, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    // 占住唯一的线程，让后续任务在队列中等待
+    std::atomic<bool> release{false};
+    std::atomic<bool> blocked{false};
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        blocked = true;
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    })));
+    ASSERT_TRUE(waitUntil([&]() { return blocked.load(); }));
+
+    std::atomic<int> executed{0};
+    auto expiring = std::make_unique<CountingTask>(executed);
+    expiring->setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+    ASSERT_TRUE(group.submitTask(std::move(expiring)));
+
+    CancellationToken token = CancellationToken::create();
+    auto cancelled = std::make_unique<CountingTask>(executed);
+    cancelled->setCancellationToken(token);
+    ASSERT_TRUE(group.submitTask(std::move(cancelled)));
+
+    auto live = std::make_unique<CountingTask>(executed);
+    live->setDeadline(std::chrono::steady_clock::now() + std::chrono::seconds(60));
+    ASSERT_TRUE(group.submitTask(std::move(live)));
+
+    token.cancel();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    release = true;
+
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+    EXPECT_TRUE(waitUntil([&]() { return group.getExpiredTasks() == 1 && group.getCancelledTasks() == 1; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试记录排队等待与执行时长直方图
+ */
+TEST_P(TenantThreadGroupTest, RecordQueueWaitAndRunLatency) {
+    ThreadGroupOptions options = makeOptions();
+    options.dequeueBatchSize = 1;
+    TenantThreadGroup group("group_test_tenant", 1, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            executed.fetch_add(1);
+        })));
+    }
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 5; }));
+    ASSERT_TRUE(waitUntil([&]() { return group.getRunLatency().count == 5; }));
+
+    LatencySummary run = group.getRunLatency();
+    EXPECT_GE(run.p50, std::chrono::milliseconds(2));
+    EXPECT_GE(run.max, run.p99);
+    // 唯一的线程串行执行，最后一个任务至少等待了前面四个
+    LatencySummary wait = group.getQueueWaitLatency();
+    EXPECT_EQ(wait.count, 5u);
+    EXPECT_GE(wait.max, std::chrono::milliseconds(8));
+    group.stop();
+}
+
+/**
+ * @brief 测试排队超过租户限额时立即拒绝并计数，积压排空后恢复
+ */
+TEST_P(TenantThreadGroupTest, RejectBeyondQueueLimit) {
+    ThreadGroupOptions options = makeOptions();
+    options.maxQueuedTasks = 4;
+    TenantThreadGroup group("group_test_tenant", 1, nullptr, options);
+
+    // 线程组未启动，任务全部留在队列中
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+    }
+    SubmitResult rejected = group.submitTask(std::make_unique<CountingTask>(executed));
+    EXPECT_TRUE(rejected.isBusy());
+    EXPECT_GT(rejected.retryAfter.count(), 0);
+    EXPECT_EQ(group.getRejectedTasks(), 1u);
+    EXPECT_GT(group.getQueuedBytes(), 0u);
+
+    ASSERT_TRUE(group.start());
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 4; }));
+    EXPECT_EQ(group.getQueuedBytes(), 0u);
+    EXPECT_TRUE(group.submitTask(std::make_unique<CountingTask>(executed)));
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 5; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试工作线程上派生的任务由同一线程接着执行
+ */
+TEST_P(TenantThreadGroupTest, SpawnedTaskRunsOnSpawningWorker) {
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    std::atomic<bool> done{false};
+    std::thread::id parentId, childId;
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        parentId = std::this_thread::get_id();
+        group.spawnTask(std::make_unique<FunctionTask>([&]() {
+            childId = std::this_thread::get_id();
+            done = true;
+        }));
+    })));
+
+    ASSERT_TRUE(waitUntil([&]() { return done.load(); }));
+    EXPECT_EQ(parentId, childId);
+    group.stop();
+}
+
+/**
+ * @brief 测试一个任务派生的大量子任务被同组空闲线程窃取执行
+ */
+TEST_P(TenantThreadGroupTest, IdleWorkersStealSpawnedTasks) {
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    std::mutex idsMutex;
+    std::vector<std::thread::id> ids;
+    auto child = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(idsMutex);
+            ids.push_back(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        executed.fetch_add(1);
+    };
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        for (int i = 0; i < 64; ++i) {
+            group.spawnTask(std::make_unique<FunctionTask>(child));
+        }
+    })));
+
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 64; }));
+    std::sort(ids.begin(), ids.end());
+    EXPECT_GT(std::unique(ids.begin(), ids.end()) - ids.begin(), 1);
+    group.stop();
+}
+
+/**
+ * @brief 测试非工作线程派生任务及缩容时本地任务不丢失
+ */
+TEST_P(TenantThreadGroupTest, SpawnFromOutsideAndShrinkKeepTasks) {
+    TenantThreadGroup group("group_test_tenant", 4, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    ASSERT_TRUE(group.spawnTask(std::make_unique<CountingTask>(executed)));
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+
+    std::atomic<bool> spawned{false};
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        for (int i = 0; i < 100; ++i) {
+            group.spawnTask(std::make_unique<CountingTask>(executed));
+        }
+        spawned = true;
+    })));
+    ASSERT_TRUE(waitUntil([&]() { return spawned.load(); }));
+    ASSERT_TRUE(group.resize(1));
+
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 101; }));
+    group.stop();
+}
+
+/**
+ * @brief 测试退出的线程在共享队列已满时就地执行残留的本地任务，不丢弃
+ */
+TEST_P(TenantThreadGroupTest, RetiringWorkerRunsLocalTasksWhenQueueFull) {
+    ThreadGroupOptions options = makeOptions();
+    options.queueCapacity = 8;
+    TenantThreadGroup group("group_test_tenant", 1, nullptr, options);
+    ASSERT_TRUE(group.start());
+
+    std::atomic<int> executed{0};
+    std::atomic<bool> spawned{false};
+    std::atomic<bool> proceed{false};
+    ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+        for (int i = 0; i < 16; ++i) {
+            group.spawnTask(std::make_unique<CountingTask>(executed));
+        }
+        spawned = true;
+        while (!proceed.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    })));
+    ASSERT_TRUE(waitUntil([&]() { return spawned.load(); }));
+
+    // 唯一的线程正在执行父任务，把共享队列填满（链表队列不限容量，填到上限即止）
+    int queued = 0;
+    while (queued < 64 && group.submitTask(std::make_unique<CountingTask>(executed))) {
+        ++queued;
+    }
+    ResizeHandle handle = group.resize(0);
+    proceed = true;
+    ASSERT_TRUE(handle.waitFor(std::chrono::seconds(5)));
+    if (GetParam() == TaskQueueEngine::RingBuffer) {
+        EXPECT_EQ(executed.load(), 16);
+    }
+
+    ASSERT_TRUE(group.resize(1));
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 16 + queued; }));
+    group.stop();
+}
+
+#ifdef __linux__
+/**
+ * @brief 测试设置CPU放置后已有线程和新增线程都绑定到指定CPU
+ */
+TEST_P(TenantThreadGroupTest, CpuPlacementPinsWorkers) {
+    TenantThreadGroup group("group_test_tenant", 2, nullptr, makeOptions());
+    ASSERT_TRUE(group.start());
+
+    CpuPlacement placement;
+    placement.cpus = {0};
+    placement.numaNodes = {0};
+    ASSERT_TRUE(group.setCpuPlacement(placement));
+    ASSERT_TRUE(group.resize(3));
+    EXPECT_EQ(group.getCpuPlacement().cpus, placement.cpus);
+
+    std::atomic<int> pinned{0}, executed{0};
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_TRUE(group.submitTask(std::make_unique<FunctionTask>([&]() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+            if (CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set)) {
+                pinned.fetch_add(1);
+            }
+            executed.fetch_add(1);
+        })));
+    }
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 30; }));
+    EXPECT_EQ(pinned.load(), 30);
+    group.stop();
+}
+#endif
+
+INSTANTIATE_TEST_SUITE_P(Engines, TenantThreadGroupTest,
+                         ::testing::Values(TaskQueueEngine::Linked, TaskQueueEngine::RingBuffer));
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "core/resource/ThreadAutoscaler.h"
+
+using namespace yao;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+ThreadAutoscaler::Sample makeSample(size_t queue, size_t busy, size_t total, size_t minThreads = 2, size_t maxThreads = 40) {
+    ThreadAutoscaler::Sample sample;
+    sample.tenantId = "scale_tenant";
+    sample.queueSize = queue;
+    sample.busyThreads = busy;
+    sample.totalThreads = total;
+    sample.minThreads = minThreads;
+    sample.maxThreads = maxThreads;
+    return sample;
+}
+
+AutoscalePolicy makePolicy() {
+    AutoscalePolicy policy;
+    policy.enabled = true;
+    policy.cooldown = std::chrono::milliseconds(1000);
+    return policy;
+}
+
+} // namespace
+
+/**
+ * @brief 测试连续过载后按步长扩容，且不超过积压与上限
+ */
+TEST(ThreadAutoscalerTest, GrowAfterSustainedPressure) {
+    AutoscalePolicy policy = makePolicy();
+    ThreadAutoscaler::TenantState state;
+    auto now = Clock::now();
+
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now), 8u);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now), 10u);
+    EXPECT_EQ(state.metrics.lastDecision, ThreadAutoscaler::Decision::Grow);
+
+    // 积压只有1个任务时只加1个线程；已到上限时不再扩容
+    ThreadAutoscaler::TenantState small;
+    ThreadAutoscaler::evaluate(policy, small, makeSample(1, 8, 8), now);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, small, makeSample(1, 8, 8), now), 9u);
+
+    ThreadAutoscaler::TenantState capped;
+    ThreadAutoscaler::evaluate(policy, capped, makeSample(100, 40, 40), now);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, capped, makeSample(100, 40, 40), now), 40u);
+}
+
+/**
+ * @brief 测试滞回：阈值之间的采样打断连续计数
+ */
+TEST(ThreadAutoscalerTest, HysteresisResetsStreak) {
+    AutoscalePolicy policy = makePolicy();
+    ThreadAutoscaler::TenantState state;
+    auto now = Clock::now();
+
+    ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now);
+    // 有积压但忙碌比例50%，介于两个阈值之间
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 4, 8), now), 8u);
+    EXPECT_EQ(state.growStreak, 0u);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now), 8u);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now), 10u);
+}
+
+/**
+ * @brief 测试持续空闲后缩容，不低于下限
+ */
+TEST(ThreadAutoscalerTest, ShrinkAfterSustainedIdle) {
+    AutoscalePolicy policy = makePolicy();
+    ThreadAutoscaler::TenantState state;
+    auto now = Clock::now();
+
+    for (size_t i = 1; i < policy.shrinkSamples; ++i) {
+        EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(0, 0, 8), now), 8u);
+    }
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(0, 0, 8), now), 6u);
+    EXPECT_EQ(state.metrics.lastDecision, ThreadAutoscaler::Decision::Shrink);
+
+    ThreadAutoscaler::TenantState floor;
+    for (size_t i = 0; i < policy.shrinkSamples; ++i) {
+        ThreadAutoscaler::evaluate(policy, floor, makeSample(0, 0, 3), now);
+    }
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, floor, makeSample(0, 0, 3), now), 2u);
+    ThreadAutoscaler::TenantState atMin;
+    for (size_t i = 0; i < policy.shrinkSamples * 2; ++i) {
+        EXPECT_EQ(ThreadAutoscaler::evaluate(policy, atMin, makeSample(0, 0, 2), now), 2u);
+    }
+}
+
+/**
+ * @brief 测试调整后在冷却时间内不再调整
+ */
+TEST(ThreadAutoscalerTest, CooldownRateLimitsChanges) {
+    AutoscalePolicy policy = makePolicy();
+    ThreadAutoscaler::TenantState state;
+    auto now = Clock::now();
+    state.lastChange = now;
+
+    ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now + std::chrono::milliseconds(500)), 8u);
+    EXPECT_EQ(ThreadAutoscaler::evaluate(policy, state, makeSample(100, 8, 8), now + std::chrono::milliseconds(1500)), 10u);
+}
+
+/**
+ * @brief 测试tick通过回调采样与调整并记录指标
+ */
+TEST(ThreadAutoscalerTest, TickAppliesDecisionsAndRecordsMetrics) {
+    AutoscalePolicy policy = makePolicy();
+    policy.growSamples = 1;
+    std::map<std::string, size_t> threads{{"busy", 4}, {"stuck", 4}};
+
+    ThreadAutoscaler autoscaler(
+        policy,
+        [&threads]() {
+            std::vector<ThreadAutoscaler::Sample> samples;
+            for (const auto& [tenantId, count] : threads) {
+                auto sample = makeSample(50, count, count, 1, 8);
+                sample.tenantId = tenantId;
+                samples.push_back(sample);
+            }
+            return samples;
+        },
+        [&threads](const std::string& tenantId, size_t count) {
+            if (tenantId == "stuck") return false;
+            threads[tenantId] = count;
+            return true;
+        });
+
+    autoscaler.tick();
+    EXPECT_EQ(threads["busy"], 5u);
+    EXPECT_EQ(threads["stuck"], 4u);
+
+    auto metrics = autoscaler.getMetrics();
+    EXPECT_EQ(metrics["busy"].scaleUps, 1u);
+    EXPECT_EQ(metrics["busy"].currentThreads, 5u);
+    EXPECT_EQ(metrics["busy"].maxThreads, 8u);
+    EXPECT_EQ(metrics["stuck"].rejected, 1u);
+
+    // 删除的租户不再出现在指标中
+    threads.erase("stuck");
+    autoscaler.tick();
+    EXPECT_EQ(autoscaler.getMetrics().count("stuck"), 0u);
+}
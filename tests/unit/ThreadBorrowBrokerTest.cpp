@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "core/resource/ThreadBorrowBroker.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+/**
+ * @brief 占用CPU一段时间的任务，记录同时执行的最大并发数
+ */
+class BusyTask : public Task {
+public:
+    BusyTask(std::atomic<int>& executed, std::atomic<int>& running, std::atomic<int>& maxRunning)
+        : executed_(executed), running_(running), maxRunning_(maxRunning) {}
+
+    void execute() override {
+        int now = running_.fetch_add(1) + 1;
+        int prev = maxRunning_.load();
+        while (now > prev && !maxRunning_.compare_exchange_weak(prev, now)) {
+        }
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        running_.fetch_sub(1);
+        executed_.fetch_add(1);
+    }
+    bool isValid() const override { return true; }
+
+private:
+    std::atomic<int>& executed_;
+    std::atomic<int>& running_;
+    std::atomic<int>& maxRunning_;
+};
+
+// 借用依赖空闲线程的轮询，在负载较高的机器上放宽等待时间
+constexpr std::chrono::seconds kBorrowTimeout(10);
+
+ThreadGroupOptions makeOptions(size_t burstPercent) {
+    ThreadGroupOptions options;
+    options.queueEngine = TaskQueueEngine::RingBuffer;
+    options.dequeueBatchSize = 1;
+    options.idleSpin = std::chrono::microseconds(0);
+    options.enableBorrowing = true;
+    options.borrowBurstPercent = burstPercent;
+    return options;
+}
+
+} // namespace
+
+/**
+ * @brief 测试空闲线程组借出线程，借用时间记入双方账户且不超过突发上限
+ */
+TEST(ThreadBorrowBrokerTest, IdleGroupLendsToSaturatedGroup) {
+    ThreadBorrowBroker broker;
+    TenantThreadGroup busy("busy_tenant", 1, nullptr, makeOptions(100));
+    TenantThreadGroup idle("idle_tenant", 4, nullptr, makeOptions(100));
+    broker.registerGroup(busy);
+    broker.registerGroup(idle);
+    ASSERT_TRUE(busy.start());
+    ASSERT_TRUE(idle.start());
+
+    std::atomic<int> executed{0}, running{0}, maxRunning{0};
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_TRUE(busy.submitTask(std::make_unique<BusyTask>(executed, running, maxRunning)));
+    }
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 40; }, kBorrowTimeout));
+
+    broker.unregisterGroup(busy);
+    broker.unregisterGroup(idle);
+    busy.stop();
+    idle.stop();
+
+    // 1个自有线程 + 最多借用1个线程（100%）
+    EXPECT_LE(maxRunning.load(), 2);
+    EXPECT_GT(busy.getBorrowedCpuSeconds(), 0.0);
+    EXPECT_DOUBLE_EQ(busy.getBorrowedCpuSeconds(), idle.getLentCpuSeconds());
+    EXPECT_DOUBLE_EQ(busy.getLentCpuSeconds(), 0.0);
+}
+
+/**
+ * @brief 测试借出的线程不计入出借组的忙碌线程数
+ */
+TEST(ThreadBorrowBrokerTest, LendingDoesNotCountAsBusy) {
+    ThreadBorrowBroker broker;
+    TenantThreadGroup busy("busy_tenant", 1, nullptr, makeOptions(100));
+    TenantThreadGroup idle("idle_tenant", 4, nullptr, makeOptions(100));
+    broker.registerGroup(busy);
+    broker.registerGroup(idle);
+    ASSERT_TRUE(busy.start());
+    ASSERT_TRUE(idle.start());
+
+    std::atomic<int> executed{0}, running{0}, maxRunning{0};
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_TRUE(busy.submitTask(std::make_unique<BusyTask>(executed, running, maxRunning)));
+    }
+    size_t maxLenderBusy = 0;
+    EXPECT_TRUE(waitUntil([&]() {
+        maxLenderBusy = std::max(maxLenderBusy, idle.getBusyThreads());
+        return executed.load() == 40;
+    }, kBorrowTimeout));
+
+    broker.unregisterGroup(busy);
+    broker.unregisterGroup(idle);
+    busy.stop();
+    idle.stop();
+
+    EXPECT_GT(idle.getLentCpuSeconds(), 0.0);
+    EXPECT_EQ(maxLenderBusy, 0u);
+}
+
+/**
+ * @brief 测试突发上限为0时不借用
+ */
+TEST(ThreadBorrowBrokerTest, ZeroBurstDisablesBorrowing) {
+    ThreadBorrowBroker broker;
+    TenantThreadGroup busy("busy_tenant", 1, nullptr, makeOptions(0));
+    TenantThreadGroup idle("idle_tenant", 2, nullptr, makeOptions(0));
+    broker.registerGroup(busy);
+    broker.registerGroup(idle);
+    ASSERT_TRUE(busy.start());
+    ASSERT_TRUE(idle.start());
+
+    std::atomic<int> executed{0}, running{0}, maxRunning{0};
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(busy.submitTask(std::make_unique<BusyTask>(executed, running, maxRunning)));
+    }
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 10; }, kBorrowTimeout));
+
+    broker.unregisterGroup(busy);
+    broker.unregisterGroup(idle);
+    busy.stop();
+    idle.stop();
+
+    EXPECT_EQ(maxRunning.load(), 1);
+    EXPECT_DOUBLE_EQ(busy.getBorrowedCpuSeconds(), 0.0);
+    EXPECT_DOUBLE_EQ(idle.getLentCpuSeconds(), 0.0);
+}
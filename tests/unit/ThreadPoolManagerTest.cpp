@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/resource/ThreadPoolManager.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+/**
+ * @brief ThreadPoolManager 单元测试类，每个用例独立初始化与关闭单例
+ */
+class ThreadPoolManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ThreadGroupOptions options;
+        options.queueEngine = TaskQueueEngine::RingBuffer;
+        ASSERT_TRUE(ThreadPoolManager::getInstance().initialize(16, false, options));
+    }
+
+    void TearDown() override {
+        ThreadPoolManager::getInstance().shutdown();
+    }
+};
+
+/**
+ * @brief 测试创建、提交、查询与删除
+ */
+TEST_F(ThreadPoolManagerTest, SubmitAndQuery) {
+    auto& manager = ThreadPoolManager::getInstance();
+    ASSERT_TRUE(manager.createTenantThreadGroup("pool_tenant", 4));
+    EXPECT_FALSE(manager.createTenantThreadGroup("pool_tenant", 4));
+
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(manager.submitTask("pool_tenant", std::make_unique<CountingTask>(executed)));
+    }
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 100; }));
+    EXPECT_FALSE(manager.submitTask("missing_tenant", std::make_unique<CountingTask>(executed)));
+
+    EXPECT_EQ(manager.getTenantThreadInfo("pool_tenant").totalThreads, 4u);
+    EXPECT_EQ(manager.getSystemThreadInfo().allocatedThreads, 4u);
+
+    EXPECT_TRUE(manager.resizeTenantThreads("pool_tenant", 6));
+    EXPECT_EQ(manager.getTenantThreadInfo("pool_tenant").totalThreads, 6u);
+    EXPECT_FALSE(manager.resizeTenantThreads("pool_tenant", 17));
+
+    EXPECT_TRUE(manager.removeTenantThreadGroup("pool_tenant"));
+    EXPECT_FALSE(manager.submitTask("pool_tenant", std::make_unique<CountingTask>(executed)));
+    EXPECT_EQ(manager.getSystemThreadInfo().allocatedThreads, 0u);
+}
+
+/**
+ * @brief 测试提交与查询线程在租户反复创建删除期间不会访问已释放的线程组
+ */
+TEST_F(ThreadPoolManagerTest, SubmitWhileGroupsChange) {
+    auto& manager = ThreadPoolManager::getInstance();
+    ASSERT_TRUE(manager.createTenantThreadGroup("stable_tenant", 2));
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> executed{0};
+    std::atomic<int> accepted{0};
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 4; ++t) {
+        submitters.emplace_back([&]() {
+            while (!stop.load()) {
+                if (manager.submitTask("stable_tenant", std::make_unique<CountingTask>(executed))) {
+                    accepted.fetch_add(1);
+                }
+                manager.submitTask("churn_tenant", std::make_unique<CountingTask>(executed));
+                manager.getTenantThreadInfo("churn_tenant");
+                manager.getSystemThreadInfo();
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        EXPECT_TRUE(manager.createTenantThreadGroup("churn_tenant", 2));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_TRUE(manager.removeTenantThreadGroup("churn_tenant"));
+    }
+
+    stop = true;
+    for (auto& t : submitters) {
+        t.join();
+    }
+    EXPECT_GT(accepted.load(), 0);
+}
+
+/**
+ * @brief 测试删除租户等待慢任务期间，其他租户的创建与调整不被阻塞
+ */
+TEST_F(ThreadPoolManagerTest, RemoveDoesNotBlockOtherTenants) {
+    auto& manager = ThreadPoolManager::getInstance();
+    ASSERT_TRUE(manager.createTenantThreadGroup("slow_tenant", 1));
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    ASSERT_TRUE(manager.submitTask("slow_tenant", std::make_unique<FunctionTask>([&]() {
+        started = true;
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    })));
+    ASSERT_TRUE(waitUntil([&]() { return started.load(); }));
+
+    std::atomic<bool> removed{false};
+    std::thread remover([&]() {
+        EXPECT_TRUE(manager.removeTenantThreadGroup("slow_tenant"));
+        removed = true;
+    });
+    ASSERT_TRUE(waitUntil([&]() { return !manager.submitTask("slow_tenant", std::make_unique<FunctionTask>([]() {})); }));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(manager.createTenantThreadGroup("other_tenant", 2));
+    EXPECT_TRUE(manager.resizeTenantThreads("other_tenant", 3));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+    EXPECT_FALSE(manager.createTenantThreadGroup("slow_tenant", 1));
+    EXPECT_FALSE(removed.load());
+
+    release = true;
+    remover.join();
+    EXPECT_TRUE(manager.createTenantThreadGroup("slow_tenant", 1));
+}
+
+/**
+ * @brief 测试开启亲和性后租户信息中给出放置结果，删除/调整租户后重新规划
+ */
+TEST_F(ThreadPoolManagerTest, AffinityPlacementExposed) {
+    auto& manager = ThreadPoolManager::getInstance();
+    manager.shutdown();
+    ThreadGroupOptions options;
+    options.threadAffinity = true;
+    ASSERT_TRUE(manager.initialize(16, false, options));
+
+    ASSERT_TRUE(manager.createTenantThreadGroup("pinned_a", 2));
+    ASSERT_TRUE(manager.createTenantThreadGroup("pinned_b", 4));
+    auto info = manager.getTenantThreadInfo("pinned_a");
+#ifdef __linux__
+    EXPECT_FALSE(info.placement.cpus.empty());
+    EXPECT_FALSE(info.placement.numaNodes.empty());
+#endif
+
+    ASSERT_TRUE(manager.resizeTenantThreads("pinned_a", 3));
+    ASSERT_TRUE(manager.removeTenantThreadGroup("pinned_b"));
+#ifdef __linux__
+    // 只剩一个租户，3个线程各占一个CPU（CPU不足时占满全部CPU）
+    size_t cpuCount = CpuTopology::detect().getCpuCount();
+    EXPECT_EQ(manager.getTenantThreadInfo("pinned_a").placement.cpus.size(), std::min<size_t>(3, cpuCount));
+#endif
+    EXPECT_TRUE(manager.getTenantThreadInfo("pinned_b").placement.cpus.empty());
+}
+
+/**
+ * @brief 测试自动伸缩：空闲租户缩到下限，有积压时在上限内扩容，上限按配额占用总线程数
+ */
+TEST_F(ThreadPoolManagerTest, AutoscaleWithinQuota) {
+    auto& manager = ThreadPoolManager::getInstance();
+    manager.shutdown();
+    ThreadGroupOptions options;
+    options.autoscale.enabled = true;
+    options.autoscale.minThreads = 1;
+    options.autoscale.interval = std::chrono::milliseconds(5);
+    options.autoscale.cooldown = std::chrono::milliseconds(0);
+    options.autoscale.shrinkSamples = 2;
+    options.autoscale.growSamples = 1;
+    options.autoscale.stepPercent = 50;
+    ASSERT_TRUE(manager.initialize(16, false, options));
+
+    ASSERT_TRUE(manager.createTenantThreadGroup("scaled", 8));
+    EXPECT_TRUE(waitUntil([&]() { return manager.getTenantThreadInfo("scaled").totalThreads == 1; }));
+    EXPECT_EQ(manager.getTenantThreadInfo("scaled").maxThreads, 8u);
+    // 缩容不释放配额
+    EXPECT_FALSE(manager.createTenantThreadGroup("other", 9));
+
+    std::atomic<bool> release{false};
+    std::atomic<int> finished{0};
+    for (int i = 0; i < 32; ++i) {
+        ASSERT_TRUE(manager.submitTask("scaled", std::make_unique<FunctionTask>([&]() {
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            finished.fetch_add(1);
+        })));
+    }
+    EXPECT_TRUE(waitUntil([&]() { return manager.getTenantThreadInfo("scaled").totalThreads == 8; }));
+    release = true;
+    EXPECT_TRUE(waitUntil([&]() { return finished.load() == 32; }));
+
+    auto metrics = manager.getAutoscaleMetrics();
+    ASSERT_EQ(metrics.count("scaled"), 1u);
+    EXPECT_GT(metrics["scaled"].scaleDowns, 0u);
+    EXPECT_GT(metrics["scaled"].scaleUps, 0u);
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "core/resource/WeightedFairScheduler.h"
+#include "common/TestTasks.h"
+
+using namespace yao;
+using namespace yao::test;
+
+namespace {
+
+ThreadGroupOptions makeOptions() {
+    ThreadGroupOptions options;
+    options.queueEngine = TaskQueueEngine::RingBuffer;
+    options.queueCapacity = 8192;
+    options.dequeueBatchSize = 1;
+    return options;
+}
+
+} // namespace
+
+/**
+ * @brief 测试多个租户的任务都被共享线程执行
+ */
+TEST(WeightedFairSchedulerTest, ExecuteTasksOfAllTenants) {
+    WeightedFairScheduler scheduler(4, makeOptions());
+    ASSERT_TRUE(scheduler.start());
+
+    std::atomic<int> executed{0};
+    for (int t = 0; t < 50; ++t) {
+        std::string tenantId = "tenant_" + std::to_string(t);
+        ASSERT_TRUE(scheduler.addTenant(tenantId, 1 + t % 5));
+        for (int i = 0; i < 20; ++i) {
+            EXPECT_TRUE(scheduler.submitTask(tenantId, std::make_unique<CountingTask>(executed)));
+        }
+    }
+
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 1000; }));
+    EXPECT_EQ(scheduler.getTenantStats("tenant_7").executedTasks, 20u);
+    scheduler.stop();
+}
+
+/**
+ * @brief 测试积压时各租户获得的执行次数与权重成正比
+ */
+TEST(WeightedFairSchedulerTest, ShareProportionalToWeight) {
+    WeightedFairScheduler scheduler(1, makeOptions());
+    ASSERT_TRUE(scheduler.addTenant("light", 1));
+    ASSERT_TRUE(scheduler.addTenant("heavy", 3));
+
+    std::atomic<int> light{0};
+    std::atomic<int> heavy{0};
+    // 每个任务占用少量CPU，保证停止时两个租户都仍有积压
+    const auto work = std::chrono::microseconds(20);
+    for (int i = 0; i < 2000; ++i) {
+        scheduler.submitTask("light", std::make_unique<CountingTask>(light, work));
+        scheduler.submitTask("heavy", std::make_unique<CountingTask>(heavy, work));
+    }
+
+    ASSERT_TRUE(scheduler.start());
+    EXPECT_TRUE(waitUntil([&]() { return light.load() + heavy.load() >= 1000; }));
+    scheduler.stop();
+
+    double ratio = static_cast<double>(heavy.load()) / std::max(light.load(), 1);
+    EXPECT_NEAR(ratio, 3.0, 0.3);
+}
+
+/**
+ * @brief 测试任务长短不同时各租户获得的CPU时间仍与权重成正比
+ */
+TEST(WeightedFairSchedulerTest, CpuShareIndependentOfTaskLength) {
+    WeightedFairScheduler scheduler(1, makeOptions());
+    ASSERT_TRUE(scheduler.addTenant("long_a", 1));
+    ASSERT_TRUE(scheduler.addTenant("short_b", 1));
+    ASSERT_TRUE(scheduler.addTenant("long_c", 1));
+    ASSERT_TRUE(scheduler.addTenant("short_d", 2));
+
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 400; ++i) {
+        scheduler.submitTask("long_a", std::make_unique<CountingTask>(executed, std::chrono::microseconds(2000)));
+        scheduler.submitTask("long_c", std::make_unique<CountingTask>(executed, std::chrono::microseconds(2000)));
+    }
+    for (int i = 0; i < 4000; ++i) {
+        scheduler.submitTask("short_b", std::make_unique<CountingTask>(executed, std::chrono::microseconds(100)));
+        scheduler.submitTask("short_d", std::make_unique<CountingTask>(executed, std::chrono::microseconds(100)));
+    }
+
+    ASSERT_TRUE(scheduler.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    scheduler.stop();
+
+    // 四个租户在停止时都仍有积压
+    for (const char* tenantId : {"long_a", "short_b", "long_c", "short_d"}) {
+        EXPECT_GT(scheduler.getTenantStats(tenantId).queueSize, 0u) << tenantId;
+    }
+    auto cpu = [&](const char* tenantId) {
+        return static_cast<double>(scheduler.getTenantStats(tenantId).cpuTimeNs);
+    };
+    // 权重相同的长任务租户与短任务租户CPU时间相当，权重2的租户约为两倍
+    EXPECT_NEAR(cpu("short_b") / cpu("long_a"), 1.0, 0.3);
+    EXPECT_NEAR(cpu("long_c") / cpu("long_a"), 1.0, 0.3);
+    EXPECT_NEAR(cpu("short_d") / cpu("long_a"), 2.0, 0.5);
+}
+
+/**
+ * @brief 测试只有一个租户有任务时可以使用全部工作线程
+ */
+TEST(WeightedFairSchedulerTest, WorkConserving) {
+    WeightedFairScheduler scheduler(4, makeOptions());
+    ASSERT_TRUE(scheduler.addTenant("busy", 1));
+    ASSERT_TRUE(scheduler.addTenant("idle", 100));
+    ASSERT_TRUE(scheduler.start());
+
+    std::atomic<int> executed{0};
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 400; ++i) {
+        tasks.push_back(std::make_unique<CountingTask>(executed, std::chrono::microseconds(100)));
+    }
+    EXPECT_EQ(scheduler.submitTasks("busy", tasks), 400u);
+
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 400; }));
+    EXPECT_EQ(scheduler.getTenantStats("busy").executedTasks, 400u);
+    scheduler.stop();
+}
+
+/**
+ * @brief 测试租户注册、调权与注销
+ */
+TEST(WeightedFairSchedulerTest, TenantLifecycle) {
+    WeightedFairScheduler scheduler(2, makeOptions());
+    EXPECT_TRUE(scheduler.addTenant("tenant", 2));
+    EXPECT_FALSE(scheduler.addTenant("tenant", 2));
+    EXPECT_EQ(scheduler.getTenantCount(), 1u);
+
+    EXPECT_TRUE(scheduler.setWeight("tenant", 8));
+    EXPECT_EQ(scheduler.getTenantStats("tenant").weight, 8u);
+
+    std::atomic<int> executed{0};
+    EXPECT_TRUE(scheduler.submitTask("tenant", std::make_unique<CountingTask>(executed)));
+    EXPECT_EQ(scheduler.getTenantStats("tenant").queueSize, 1u);
+
+    EXPECT_TRUE(scheduler.removeTenant("tenant"));
+    EXPECT_FALSE(scheduler.removeTenant("tenant"));
+    EXPECT_FALSE(scheduler.submitTask("tenant", std::make_unique<CountingTask>(executed)));
+    EXPECT_FALSE(scheduler.getTenantStats("tenant").exists);
+
+    // 注销后重新注册的租户可以正常执行
+    ASSERT_TRUE(scheduler.start());
+    EXPECT_TRUE(scheduler.addTenant("tenant", 1));
+    EXPECT_TRUE(scheduler.submitTask("tenant", std::make_unique<CountingTask>(executed)));
+    EXPECT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+    scheduler.stop();
+}
+
+/**
+ * @brief 测试过期或被取消的任务出队时丢弃并计入租户统计
+ */
+TEST(WeightedFairSchedulerTest, DropExpiredAndCancelledTasks) {
+    WeightedFairScheduler scheduler(1, makeOptions());
+    ASSERT_TRUE(scheduler.addTenant("tenant", 1));
+
+    std::atomic<int> executed{0};
+    auto expired = std::make_unique<CountingTask>(executed);
+    expired->setDeadline(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+    ASSERT_TRUE(scheduler.submitTask("tenant", std::move(expired)));
+
+    CancellationToken token = CancellationToken::create();
+    auto cancelled = std::make_unique<CountingTask>(executed);
+    cancelled->setCancellationToken(token);
+    ASSERT_TRUE(scheduler.submitTask("tenant", std::move(cancelled)));
+    token.cancel();
+
+    ASSERT_TRUE(scheduler.submitTask("tenant", std::make_unique<CountingTask>(executed)));
+
+    ASSERT_TRUE(scheduler.start());
+    ASSERT_TRUE(waitUntil([&]() { return executed.load() == 1; }));
+    EXPECT_TRUE(waitUntil([&]() { return scheduler.getTenantStats("tenant").queueSize == 0; }));
+    auto stats = scheduler.getTenantStats("tenant");
+    EXPECT_EQ(stats.executedTasks, 1u);
+    EXPECT_EQ(stats.expiredTasks, 1u);
+    EXPECT_EQ(stats.cancelledTasks, 1u);
+    scheduler.stop();
+}
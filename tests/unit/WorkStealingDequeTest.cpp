@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "core/resource/WorkStealingDeque.h"
+
+using namespace yao;
+
+namespace {
+
+/**
+ * @brief 带编号的测试任务
+ */
+class NumberedTask : public Task {
+public:
+    explicit NumberedTask(int id) : id_(id) {}
+
+    void execute() override {}
+    bool isValid() const override { return true; }
+    int getId() const { return id_; }
+
+private:
+    int id_;
+};
+
+int idOf(const std::unique_ptr<Task>& task) {
+    return static_cast<NumberedTask*>(task.get())->getId();
+}
+
+} // namespace
+
+/**
+ * @brief 测试所属线程后进先出，窃取者先进先出
+ */
+TEST(WorkStealingDequeTest, PopIsLifoStealIsFifo) {
+    WorkStealingDeque deque(16);
+    for (int i = 0; i < 4; ++i) {
+        std::unique_ptr<Task> task = std::make_unique<NumberedTask>(i);
+        ASSERT_TRUE(deque.push(task));
+    }
+    EXPECT_EQ(deque.size(), 4u);
+
+    EXPECT_EQ(idOf(deque.pop()), 3);
+    EXPECT_EQ(idOf(deque.steal()), 0);
+    EXPECT_EQ(idOf(deque.pop()), 2);
+    EXPECT_EQ(idOf(deque.steal()), 1);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+/**
+ * @brief 测试队列满时push失败且任务保留在调用方
+ */
+TEST(WorkStealingDequeTest, PushFailsWhenFull) {
+    WorkStealingDeque deque(4);
+    EXPECT_EQ(deque.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        std::unique_ptr<Task> task = std::make_unique<NumberedTask>(i);
+        ASSERT_TRUE(deque.push(task));
+    }
+
+    std::unique_ptr<Task> overflow = std::make_unique<NumberedTask>(99);
+    EXPECT_FALSE(deque.push(overflow));
+    ASSERT_NE(overflow, nullptr);
+    EXPECT_EQ(idOf(overflow), 99);
+
+    deque.steal();
+    EXPECT_TRUE(deque.push(overflow));
+}
+
+/**
+ * @brief 测试所属线程与多个窃取者并发时每个任务恰好被取走一次
+ */
+TEST(WorkStealingDequeTest, ConcurrentStealNoLossNoDuplicate) {
+    constexpr int kTasks = 20000;
+    WorkStealingDeque deque(64);
+    std::vector<std::atomic<int>> seen(kTasks);
+    std::atomic<bool> ownerDone{false};
+
+    auto take = [&](std::unique_ptr<Task> task) {
+        if (task) seen[idOf(task)].fetch_add(1);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            while (!ownerDone.load() || !deque.empty()) {
+                auto task = deque.steal();
+                if (task) {
+                    take(std::move(task));
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kTasks; ++i) {
+        std::unique_ptr<Task> task = std::make_unique<NumberedTask>(i);
+        while (!deque.push(task)) {
+            take(deque.pop());
+        }
+        if (i % 3 == 0) {
+            take(deque.pop());
+        }
+    }
+    while (!deque.empty()) {
+        take(deque.pop());
+    }
+    ownerDone = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "task " << i;
+    }
+}